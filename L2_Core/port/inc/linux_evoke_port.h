@@ -0,0 +1,96 @@
+/**
+ * @file linux_evoke_port.h
+ * @brief ek_evoke 的主机（Linux）移植：虚拟时钟 + 可注入的中断
+ * @author N1netyNine99
+ *
+ * 用于在主机上确定性地运行 evoke 调度器（单元测试、基准测试、CI）：
+ * - 实现 ek_evoke_sleep() / ek_evoke_get_tick()，睡眠即把虚拟时钟拨到定时器的比较值，不占用真实时间
+ * - linux_evoke_irq_inject() 在指定的虚拟时间“触发中断”：睡眠中到来的中断会提前唤醒主循环，
+ *   任务回调占用时间（linux_evoke_advance()）期间到来的中断在回调中途执行，与真实的抢占一致
+ * - 配合 ek_evoke_run_until() 驱动主循环，结果只取决于注入的中断序列
+ *
+ * @code
+ * linux_evoke_reset();
+ * linux_evoke_irq_inject(30, dma_done_isr, NULL); // 30 个 tick 后 DMA 完成
+ * ek_evoke_run_until(ek_evoke_get_tick() + 100);
+ * @endcode
+ *
+ * @note 单线程运行，中断函数在主机线程中同步调用，临界区钩子保持默认的空实现
+ */
+
+#ifndef LINUX_EVOKE_PORT_H
+#define LINUX_EVOKE_PORT_H
+
+#include "ek_conf.h"
+
+#if EK_USE_RTOS == 0 && EK_EVOKE_ENABLE == 1
+
+#    include "ek_evoke.h"
+
+#    ifdef __cplusplus
+extern "C"
+{
+#    endif
+
+/**
+ * @brief 最多同时等待触发的注入中断数量
+ */
+#    ifndef LINUX_EVOKE_MAX_IRQ
+#        define LINUX_EVOKE_MAX_IRQ (32)
+#    endif /* LINUX_EVOKE_MAX_IRQ */
+
+/**
+ * @brief 注入的中断服务函数类型
+ * @param arg 注入时传入的参数
+ */
+typedef void (*linux_evoke_isr_t)(void *);
+
+/**
+ * @brief 睡眠钩子，每次主循环进入睡眠时以睡眠时间调用，可用于检查或注入中断
+ */
+extern void (*linux_evoke_sleep_hook)(uint32_t xtick);
+
+/**
+ * @brief 重新初始化 evoke 并复位虚拟时钟
+ *
+ * @note 时钟复位到 EK_EVOKE_TICK_INIT，清除未触发的中断和睡眠钩子
+ */
+void linux_evoke_reset(void);
+
+/**
+ * @brief 推进虚拟时钟，模拟任务回调占用 CPU 的时间
+ * @param ticks 经过的时间（tick）
+ *
+ * @note 期间到期的注入中断按时间顺序执行，执行时时钟停在中断的触发时间
+ */
+void linux_evoke_advance(uint32_t ticks);
+
+/**
+ * @brief 注入一个中断
+ * @param delay 从现在起多少个 tick 后触发
+ * @param isr 中断服务函数，通常调用 ek_evoke_*_from_isr()
+ * @param arg 传给 isr 的参数
+ * @return true 成功；false 等待触发的中断已满
+ *
+ * @note 中断在下一次睡眠或 linux_evoke_advance() 经过触发时间时执行，delay 为 0 时在下一次睡眠时立即执行
+ * @note 同一时间的中断按注入顺序执行；中断服务函数中可以继续注入
+ */
+bool linux_evoke_irq_inject(uint32_t delay, linux_evoke_isr_t isr, void *arg);
+
+/**
+ * @brief 清除所有未触发的注入中断
+ */
+void linux_evoke_irq_clear(void);
+
+/**
+ * @brief 未触发的注入中断数量
+ */
+uint32_t linux_evoke_irq_pending(void);
+
+#    ifdef __cplusplus
+}
+#    endif
+
+#endif /* EK_USE_RTOS == 0 && EK_EVOKE_ENABLE == 1 */
+
+#endif /* LINUX_EVOKE_PORT_H */
@@ -0,0 +1,120 @@
+/**
+ * @file linux_evoke_port.c
+ * @brief ek_evoke 的主机（Linux）移植实现
+ * @author N1netyNine99
+ */
+
+#include "linux_evoke_port.h"
+
+#if EK_USE_RTOS == 0 && EK_EVOKE_ENABLE == 1
+
+#    include <string.h>
+#    include "ek_assert.h"
+
+typedef struct
+{
+    uint32_t at; /* 触发时间 */
+    linux_evoke_isr_t isr;
+    void *arg;
+} _irq_t;
+
+// 按触发时间排序，同一时间按注入顺序
+static _irq_t _irq_queue[LINUX_EVOKE_MAX_IRQ];
+static uint32_t _irq_len;
+
+static uint32_t _now;
+static uint32_t _reported; /* 上一次 ek_evoke_sleep() 返回时的时间，定时器按它设置绝对比较值 */
+
+void (*linux_evoke_sleep_hook)(uint32_t xtick);
+
+/* 依次执行触发时间不晚于 until 的中断，中断服务函数中注入的新中断也会参与 */
+static void _irq_run_until(uint32_t until)
+{
+    while (_irq_len != 0 && (int32_t)(_irq_queue[0].at - until) <= 0)
+    {
+        _irq_t irq = _irq_queue[0];
+        _irq_len--;
+        memmove(&_irq_queue[0], &_irq_queue[1], _irq_len * sizeof(_irq_t));
+
+        if ((int32_t)(irq.at - _now) > 0) _now = irq.at;
+        irq.isr(irq.arg);
+    }
+}
+
+uint32_t ek_evoke_sleep(uint32_t xtick, bool deep)
+{
+    __EK_UNUSED(deep);
+
+    if (linux_evoke_sleep_hook != NULL) linux_evoke_sleep_hook(xtick);
+
+    if (xtick != EK_EVOKE_TICK_FOREVER)
+    {
+        // 定时器比较值之前到来的中断先把 CPU 唤醒
+        uint32_t wake = _reported + xtick;
+        if (_irq_len != 0 && (int32_t)(_irq_queue[0].at - wake) < 0) _irq_run_until(_irq_queue[0].at);
+        else if ((int32_t)(wake - _now) > 0) _now = wake;
+    }
+    else if (_irq_len != 0)
+    {
+        _irq_run_until(_irq_queue[0].at);
+    }
+    // 没有定时器也没有中断时什么都不会发生，立即返回，时间不前进
+
+    uint32_t elapsed = _now - _reported;
+    _reported = _now;
+    return elapsed;
+}
+
+uint32_t ek_evoke_get_tick(void)
+{
+    return _now;
+}
+
+void linux_evoke_reset(void)
+{
+    ek_evoke_init();
+    _now = EK_EVOKE_TICK_INIT;
+    _reported = _now;
+    _irq_len = 0;
+    linux_evoke_sleep_hook = NULL;
+}
+
+void linux_evoke_advance(uint32_t ticks)
+{
+    uint32_t until = _now + ticks;
+    _irq_run_until(until);
+    _now = until;
+}
+
+bool linux_evoke_irq_inject(uint32_t delay, linux_evoke_isr_t isr, void *arg)
+{
+    ek_assert_param(isr != NULL);
+    ek_assert_param(delay <= EK_EVOKE_MAX_DELAY);
+
+    if (_irq_len >= LINUX_EVOKE_MAX_IRQ) return false;
+
+    uint32_t at = _now + delay;
+    uint32_t pos = _irq_len;
+    while (pos > 0 && (int32_t)(_irq_queue[pos - 1U].at - at) > 0)
+    {
+        _irq_queue[pos] = _irq_queue[pos - 1U];
+        pos--;
+    }
+    _irq_queue[pos].at = at;
+    _irq_queue[pos].isr = isr;
+    _irq_queue[pos].arg = arg;
+    _irq_len++;
+    return true;
+}
+
+void linux_evoke_irq_clear(void)
+{
+    _irq_len = 0;
+}
+
+uint32_t linux_evoke_irq_pending(void)
+{
+    return _irq_len;
+}
+
+#endif /* EK_USE_RTOS == 0 && EK_EVOKE_ENABLE == 1 */
@@ -939,6 +939,63 @@ size_t tlsf_block_size(void *ptr)
     return size;
 }
 
+size_t tlsf_largest_free(tlsf_t tlsf)
+{
+    const control_t *control = tlsf_cast(const control_t *, tlsf);
+    if (!control->fl_bitmap)
+    {
+        return 0;
+    }
+
+    /*
+    ** Lower bound of the highest non-empty size class. mapping_search rounds
+    ** requests up to the next class, so this is the largest request that is
+    ** guaranteed to succeed; actual blocks in the class may be up to one
+    ** second-level step larger.
+    */
+    const int fl = tlsf_fls(control->fl_bitmap);
+    const int sl = tlsf_fls(control->sl_bitmap[fl]);
+    if (fl == 0)
+    {
+        return tlsf_cast(size_t, sl) * (SMALL_BLOCK_SIZE / SL_INDEX_COUNT);
+    }
+    const int shift = fl + FL_INDEX_SHIFT - 1 - SL_INDEX_COUNT_LOG2;
+    return tlsf_cast(size_t, SL_INDEX_COUNT + sl) << shift;
+}
+
+int tlsf_free_histogram(tlsf_t tlsf, unsigned int *counts, int count)
+{
+    const control_t *control = tlsf_cast(const control_t *, tlsf);
+    const int classes = tlsf_min(count, FL_INDEX_COUNT);
+    int fl, sl;
+
+    /* Walks only the free lists, so the cost is the number of free blocks. */
+    for (fl = 0; fl < classes; ++fl)
+    {
+        counts[fl] = 0;
+        if (!(control->fl_bitmap & (1U << fl)))
+        {
+            continue;
+        }
+        for (sl = 0; sl < SL_INDEX_COUNT; ++sl)
+        {
+            const block_header_t *block = control->blocks[fl][sl];
+            while (block != &control->block_null)
+            {
+                counts[fl]++;
+                block = block->next_free;
+            }
+        }
+    }
+    return classes;
+}
+
+size_t tlsf_fl_class_size(int fl)
+{
+    /* Class 0 holds every block below SMALL_BLOCK_SIZE. */
+    return fl == 0 ? 0 : tlsf_cast(size_t, 1) << (fl + FL_INDEX_SHIFT - 1);
+}
+
 int tlsf_check_pool(pool_t pool)
 {
     /* Check that the blocks are physically correct. */
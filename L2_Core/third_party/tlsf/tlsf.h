@@ -69,6 +69,13 @@ void tlsf_free(tlsf_t tlsf, void *ptr);
 /* 返回内部块大小，而非原始请求大小 */
 size_t tlsf_block_size(void *ptr);
 
+/* 返回保证能分配成功的最大请求大小（最高非空空闲链表的分级下界，O(1)），没有空闲块时返回 0 */
+size_t tlsf_largest_free(tlsf_t tlsf);
+
+/* 按一级分级统计空闲块数量，返回填入的分级数；第 fl 级的块大小下界由 tlsf_fl_class_size() 给出 */
+int tlsf_free_histogram(tlsf_t tlsf, unsigned int *counts, int count);
+size_t tlsf_fl_class_size(int fl);
+
 /* 内部结构的开销/限制。 */
 size_t tlsf_size(void);
 size_t tlsf_align_size(void);
@@ -0,0 +1,167 @@
+/**
+ * @file ek_arena.h
+ * @brief 线性（bump）分配器
+ * @author N1netyNine99
+ *
+ * 适用于一批同时失效的短生命周期分配，例如解析一行 Shell 命令、格式化一条日志、构建一帧 UI：
+ * - 分配只移动一个偏移量，不查找空闲块，也没有块头开销
+ * - 不单独释放，用 ek_arena_reset() 一次性归还全部内存
+ * - 用 ek_arena_save()/ek_arena_rewind() 回退到保存点，实现嵌套的作用域
+ * - 存储区可以来自静态数组（EK_ARENA_DEFINE）、调用者缓冲区或一次 TLSF 分配
+ * - 通过 ek_arena_allocator() 作为 ek_str/ek_vec 的分配器使用
+ *
+ * @note 不是线程安全的，每个线程/任务应使用自己的 arena
+ */
+
+#ifndef EK_ARENA_H
+#define EK_ARENA_H
+
+#include "ek_conf.h"
+
+#if EK_ARENA_ENABLE == 1
+
+#    include "ek_def.h"
+#    include "ek_mem.h"
+
+/**
+ * @brief 分配的对齐字节数，满足 double/uint64_t 的访问要求
+ */
+#    define EK_ARENA_ALIGN (8U)
+
+/**
+ * @brief 保存点，记录当时的分配偏移
+ */
+typedef size_t ek_arena_mark_t;
+
+/**
+ * @brief 线性分配器结构
+ */
+typedef struct ek_arena_t ek_arena_t;
+
+struct ek_arena_t
+{
+    ek_allocator_t allocator; /**< 分配器接口，ctx 指向 arena 自身 */
+    uint8_t *base; /**< 存储区起始地址 */
+    size_t size; /**< 存储区大小（字节） */
+    size_t offset; /**< 当前分配偏移 */
+    size_t peak; /**< offset 的历史最大值（高水位） */
+};
+
+/**
+ * @brief 分配器接口的实现函数，一般通过 ek_arena_allocator() 间接使用
+ * @note 只有最后一次分配可以原地扩容、缩小或释放，其他块的释放被忽略，扩容时复制到新位置
+ */
+void *_ek_arena_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size);
+
+/**
+ * @brief 静态定义一个 arena，存储区位于 .bss，不占用堆
+ * @param name arena 对象名（ek_arena_t 类型，使用时取地址）
+ * @param n 存储区大小（字节）
+ *
+ * @note 编译期完成初始化，无需调用 ek_arena_init()
+ */
+#    define EK_ARENA_DEFINE(name, n)                                                                \
+        static uint64_t _ek_arena_storage_##name[((n) + sizeof(uint64_t) - 1U) / sizeof(uint64_t)]; \
+        static ek_arena_t name = {                                                                  \
+            .allocator = { _ek_arena_realloc, &name },                                              \
+            .base = (uint8_t *)_ek_arena_storage_##name,                                            \
+            .size = sizeof(_ek_arena_storage_##name),                                               \
+        }
+
+/**
+ * @brief 获取 arena 的分配器接口
+ * @param arena arena 指针
+ * @return 分配器指针，可传给 ek_str_create_with()、ek_vec_init_with() 等
+ */
+#    define ek_arena_allocator(arena) (&(arena)->allocator)
+
+#    ifdef __cplusplus
+extern "C"
+{
+#    endif /* __cplusplus */
+
+/**
+ * @brief 在调用者提供的存储区上初始化 arena
+ * @param arena arena 对象
+ * @param buf 存储区
+ * @param size 存储区大小（字节）
+ */
+void ek_arena_init(ek_arena_t *arena, void *buf, size_t size);
+
+/**
+ * @brief 从 TLSF 堆中切出一个 arena
+ * @param size 存储区大小（字节）
+ * @return 成功返回 arena 指针，失败返回 NULL
+ *
+ * @note arena 头和存储区只占用一次堆分配
+ */
+ek_arena_t *ek_arena_create(size_t size);
+
+/**
+ * @brief 销毁由 ek_arena_create() 创建的 arena
+ * @param arena arena 指针
+ */
+void ek_arena_destroy(ek_arena_t *arena);
+
+/**
+ * @brief 分配内存
+ * @param arena arena 指针
+ * @param size 要分配的字节数
+ * @return 成功返回按 EK_ARENA_ALIGN 对齐的地址，空间不足或 size 为 0 时返回 NULL
+ *
+ * @note 复杂度：O(1)
+ */
+void *ek_arena_alloc(ek_arena_t *arena, size_t size);
+
+/**
+ * @brief 记录当前的分配位置
+ * @param arena arena 指针
+ * @return 保存点
+ */
+ek_arena_mark_t ek_arena_save(const ek_arena_t *arena);
+
+/**
+ * @brief 回退到保存点，释放保存点之后的全部分配
+ * @param arena arena 指针
+ * @param mark 由 ek_arena_save() 得到的保存点
+ *
+ * @warning 回退后，保存点之后分配的内存全部失效
+ */
+void ek_arena_rewind(ek_arena_t *arena, ek_arena_mark_t mark);
+
+/**
+ * @brief 释放全部分配
+ * @param arena arena 指针
+ *
+ * @warning 重置后，之前分配的内存全部失效
+ */
+void ek_arena_reset(ek_arena_t *arena);
+
+/**
+ * @brief 获取已分配的字节数（含对齐填充）
+ * @param arena arena 指针
+ * @return 已分配的字节数
+ */
+size_t ek_arena_used(const ek_arena_t *arena);
+
+/**
+ * @brief 获取剩余的字节数
+ * @param arena arena 指针
+ * @return 剩余的字节数
+ */
+size_t ek_arena_unused(const ek_arena_t *arena);
+
+/**
+ * @brief 获取高水位（已分配字节数的历史最大值），用于确定存储区大小
+ * @param arena arena 指针
+ * @return 高水位字节数
+ */
+size_t ek_arena_peak(const ek_arena_t *arena);
+
+#    ifdef __cplusplus
+}
+#    endif /* __cplusplus */
+
+#endif /* EK_ARENA_ENABLE */
+
+#endif /* EK_ARENA_H */
@@ -0,0 +1,114 @@
+/**
+ * @file ek_co.h
+ * @brief 基于 ek_evoke 的无栈协程
+ * @author N1netyNine99
+ *
+ * 用 switch/case 记录恢复位置（protothread 风格），把多步协议写成顺序代码：
+ * - 协程就是普通的 evoke 任务回调，每个挂起点可以等待不同的事件
+ * - 恢复位置保存在任务结构体中，不需要为每个任务分配栈
+ * - 挂起时回调直接返回，主循环可以调度其他任务或进入睡眠
+ *
+ * @code
+ * static uint32_t retry; // 跨挂起点的变量不能是局部变量
+ *
+ * static void link_task(ek_evoke_event_t *evt, void *arg)
+ * {
+ *     EK_CO_BEGIN();
+ *     for (retry = 0; retry < 3; retry++)
+ *     {
+ *         send_frame();
+ *         EK_CO_AWAIT_ANY(ack_evt, 100);
+ *         if (!EK_CO_TIMED_OUT()) break;
+ *     }
+ *     EK_CO_AWAIT_DELAY(10);
+ *     EK_CO_END();
+ * }
+ *
+ * ek_evoke_task_t *tsk = ek_evoke_task_create("link", link_task, NULL);
+ * ek_evoke_task_await(tsk, NULL, 0); // 立即启动
+ * @endcode
+ *
+ * @warning 局部变量在挂起后不保留，需要保存的状态放在静态变量或任务参数指向的结构体中
+ * @warning 挂起宏内部使用 __LINE__，同一行不能写两个挂起宏，也不能在协程体内使用 switch 包住挂起宏
+ */
+
+#ifndef EK_CO_H
+#define EK_CO_H
+
+#include "ek_conf.h"
+
+#if EK_USE_RTOS == 0 && EK_EVOKE_ENABLE == 1
+
+#    include "ek_evoke.h"
+
+/**
+ * @brief 协程体开始，必须是回调中的第一条语句
+ */
+#    define EK_CO_BEGIN()                                    \
+        ek_evoke_task_t *_ek_co_self = ek_evoke_task_self(); \
+        switch (_ek_co_self->co_line)                        \
+        {                                                    \
+        case 0:
+
+/**
+ * @brief 协程体结束，任务停止，重新订阅或等待后从头开始
+ */
+#    define EK_CO_END()                  \
+        }                                \
+        ek_evoke_task_stop(_ek_co_self); \
+        return
+
+/**
+ * @brief 记录恢复位置、设置等待对象后返回，下次被调度时从这里继续
+ */
+#    define _EK_CO_AWAIT(evt, timeout)                          \
+        do                                                      \
+        {                                                       \
+            _ek_co_self->co_line = __LINE__;                    \
+            ek_evoke_task_await(_ek_co_self, (evt), (timeout)); \
+            return;                                             \
+        case __LINE__:;                                         \
+        } while (0)
+
+/**
+ * @brief 等待事件发布
+ * @param evt 事件句柄
+ */
+#    define EK_CO_AWAIT_EVENT(evt) _EK_CO_AWAIT((evt), 0)
+
+/**
+ * @brief 延时
+ * @param ticks 延时时间（tick），0 等同于 EK_CO_YIELD()
+ */
+#    define EK_CO_AWAIT_DELAY(ticks) _EK_CO_AWAIT(NULL, (ticks))
+
+/**
+ * @brief 等待事件发布或超时，之后用 EK_CO_TIMED_OUT() 区分
+ * @param evt 事件句柄
+ * @param timeout 超时时间（tick），0 表示不超时
+ */
+#    define EK_CO_AWAIT_ANY(evt, timeout) _EK_CO_AWAIT((evt), (timeout))
+
+/**
+ * @brief 让出一次，让其他就绪任务先执行
+ */
+#    define EK_CO_YIELD() _EK_CO_AWAIT(NULL, 0)
+
+/**
+ * @brief 上一次等待是否因超时结束
+ */
+#    define EK_CO_TIMED_OUT() (_ek_co_self->timed_out)
+
+/**
+ * @brief 提前结束协程
+ */
+#    define EK_CO_EXIT()                     \
+        do                                   \
+        {                                    \
+            ek_evoke_task_stop(_ek_co_self); \
+            return;                          \
+        } while (0)
+
+#endif /* EK_USE_RTOS == 0 && EK_EVOKE_ENABLE == 1 */
+
+#endif /* EK_CO_H */
@@ -7,6 +7,8 @@
  * - 弱符号、打包、对齐等属性宏
  * - 内联函数宏
  * - 汇编指令宏
+ * - 原子访问（获取/释放语义）宏
+ * - 返回地址宏（用于内存分配追踪）
  * - 平台相关的换行符定义
  *
  * 支持的编译器：GCC、ARM Compiler 6、ARM Compiler 5
@@ -46,6 +48,14 @@
 #    define __EK_STATIC_INLINE static inline
 #    define __EK_ALWAYS_INLINE __attribute__((always_inline)) static inline
 #    define __EK_ASM           __asm
+#    define __EK_RETURN_ADDR() __builtin_return_address(0)
+#    define __EK_NOINLINE      __attribute__((noinline))
+#    define __EK_NO_TAIL_CALL() __asm volatile("" ::: "memory")
+#    define __EK_CLZ(x)        ((uint32_t)__builtin_clz(x))
+#    define __EK_LOAD_ACQUIRE(ptr)       __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#    define __EK_STORE_RELEASE(ptr, val) __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#    define __EK_CAS(ptr, expected, desired) \
+        __atomic_compare_exchange_n((ptr), (expected), (desired), true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
 /* ========== ARM Compiler 6 宏定义 ========== */
 #elif defined(__ARMCC_VERSION) && (__ARMCC_VERSION >= 6010050)
 
@@ -61,6 +71,14 @@
 #    define __EK_STATIC_INLINE static inline
 #    define __EK_ALWAYS_INLINE __attribute__((always_inline)) static inline
 #    define __EK_ASM           __asm
+#    define __EK_RETURN_ADDR() __builtin_return_address(0)
+#    define __EK_NOINLINE      __attribute__((noinline))
+#    define __EK_NO_TAIL_CALL() __asm volatile("" ::: "memory")
+#    define __EK_CLZ(x)        ((uint32_t)__builtin_clz(x))
+#    define __EK_LOAD_ACQUIRE(ptr)       __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#    define __EK_STORE_RELEASE(ptr, val) __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#    define __EK_CAS(ptr, expected, desired) \
+        __atomic_compare_exchange_n((ptr), (expected), (desired), true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
 
 /* ========== ARM Compiler 5 宏定义 ========== */
 #elif defined(__CC_ARM)
@@ -77,6 +95,45 @@
 #    define __EK_STATIC_INLINE static __inline
 #    define __EK_ALWAYS_INLINE __forceinline
 #    define __EK_ASM           __asm
+#    define __EK_RETURN_ADDR() ((void *)__return_address())
+#    define __EK_NOINLINE      __attribute__((noinline))
+#    define __EK_NO_TAIL_CALL() ((void)0)
+#    define __EK_CLZ(x)        ((uint32_t)__clz(x))
+#    define __EK_LOAD_ACQUIRE(ptr)       __ek_load_acquire_u32((volatile uint32_t *)(ptr))
+#    define __EK_STORE_RELEASE(ptr, val) __ek_store_release_u32((volatile uint32_t *)(ptr), (val))
+#    define __EK_CAS(ptr, expected, desired) \
+        __ek_cas_u32((volatile uint32_t *)(ptr), (uint32_t *)(expected), (desired))
+
+/* AC5 没有 __atomic 内建函数，用 DMB 实现获取/释放语义（仅支持 32 位） */
+__EK_STATIC_INLINE uint32_t __ek_load_acquire_u32(volatile uint32_t *ptr)
+{
+    uint32_t val = *ptr;
+    __dmb(0xF);
+    return val;
+}
+
+__EK_STATIC_INLINE void __ek_store_release_u32(volatile uint32_t *ptr, uint32_t val)
+{
+    __dmb(0xF);
+    *ptr = val;
+}
+
+__EK_STATIC_INLINE bool __ek_cas_u32(volatile uint32_t *ptr, uint32_t *expected, uint32_t desired)
+{
+    uint32_t old;
+    do
+    {
+        old = __ldrex(ptr);
+        if (old != *expected)
+        {
+            __clrex();
+            *expected = old;
+            return false;
+        }
+    } while (__strex(desired, ptr));
+    __dmb(0xF);
+    return true;
+}
 /* ========== 不支持的编译器（空定义） ========== */
 #else
 #    define __EK_WEAK
@@ -91,12 +148,51 @@
 #    define __EK_STATIC_INLINE static inline
 #    define __EK_ALWAYS_INLINE static inline
 #    define __EK_ASM           asm
+#    define __EK_RETURN_ADDR() ((void *)0)
+#    define __EK_NOINLINE
+#    define __EK_NO_TAIL_CALL() ((void)0)
+#    define __EK_CLZ(x)        __ek_clz_u32(x)
+#    define __EK_LOAD_ACQUIRE(ptr)       (*(ptr))
+#    define __EK_STORE_RELEASE(ptr, val) (*(ptr) = (val))
+#    define __EK_CAS(ptr, expected, desired) \
+        ((*(ptr) == *(expected)) ? ((*(ptr) = (desired)), true) : ((*(expected) = *(ptr)), false))
+
+/* 没有前导零计数指令时的二分查找实现，x 不能为 0 */
+__EK_STATIC_INLINE uint32_t __ek_clz_u32(uint32_t x)
+{
+    uint32_t n = 0;
+    if (x <= 0x0000FFFFU) n += 16, x <<= 16;
+    if (x <= 0x00FFFFFFU) n += 8, x <<= 8;
+    if (x <= 0x0FFFFFFFU) n += 4, x <<= 4;
+    if (x <= 0x3FFFFFFFU) n += 2, x <<= 2;
+    if (x <= 0x7FFFFFFFU) n += 1;
+    return n;
+}
+#endif
+
+/* ========== 缓存行 ========== */
+/**
+ * @brief 缓存行填充
+ * @note 主机平台（x86/AArch64）上展开为一个缓存行大小的填充数组，
+ *       用于把生产者和消费者频繁写入的字段隔离到不同缓存行，避免伪共享；
+ *       MCU 上展开为空，不占用 RAM
+ */
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__) || defined(_M_X64) || defined(_M_IX86)
+#    define EK_CACHE_LINE_SIZE      (64)
+#    define EK_CACHE_LINE_PAD(name) uint8_t name[EK_CACHE_LINE_SIZE];
+#else
+#    define EK_CACHE_LINE_PAD(name)
 #endif
 
 /* ========== 功能宏 ========== */
 #define EK_FREQ_K(x)            ((x) * 1000UL)
 #define EK_FREQ_M(x)            ((x) * 1000UL * 1000UL)
 #define EK_ARRAY_LEN(x)         (sizeof(x) / (sizeof((x)[0])))
+#define EK_IS_POW2(x)           (((x) != 0) && (((x) & ((x) - 1)) == 0))
+/* 编译期向上取整到 2 的幂，结果是常量表达式，可用作静态数组长度 */
+#define _EK_SMEAR4(v)           ((v) | ((v) >> 1) | ((v) >> 2) | ((v) >> 3))
+#define _EK_SMEAR16(v)          (_EK_SMEAR4(v) | _EK_SMEAR4((v) >> 4) | _EK_SMEAR4((v) >> 8) | _EK_SMEAR4((v) >> 12))
+#define EK_POW2_ROUNDUP(x)      ((_EK_SMEAR16((uint32_t)(x) - 1U) | _EK_SMEAR16(((uint32_t)(x) - 1U) >> 16)) + 1U)
 #define EK_CLAMP(val, min, max) (((val) < (min)) ? (min) : (((val) > (max)) ? (max) : (val)))
 #define EK_GET_FILE_NAME(file_path)                            \
     (strrchr((file_path), '/') ? strrchr((file_path), '/') + 1 \
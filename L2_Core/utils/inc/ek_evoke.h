@@ -5,9 +5,19 @@
  *
  * 提供轻量级的事件驱动机制，用于非 RTOS 环境下的任务调度和事件处理
  * 支持任务等待事件、延迟发布、ISR 请求队列等功能
+ * 就绪任务按优先级调度（数值越大优先级越高），同一优先级内按截止时间、再按就绪顺序执行
+ * 任务可以同时等待多个事件中的任意一个，或者等待事件组中的位满足条件
  *
  * @note 仅在 EK_USE_RTOS == 0 时可用
  * @note 需要用户实现睡眠和定时器回调的弱函数
+ *
+ * 时间基准：
+ * - 调度器自己维护一个 32 位的 tick 计数，只由 ek_evoke_sleep() 返回的经过时间推进
+ * - 延迟请求的唤醒时间允许回绕，按与当前时间的有符号差值排序，延迟不能超过 EK_EVOKE_MAX_DELAY
+ * - 移植时推荐重写 ek_evoke_sleep()：用一个不停止的低功耗计数器（LPTIM/RTC）设置单次比较中断，
+ *   唤醒后报告计数器从上一次返回以来的增量，被其他中断提前唤醒也不会累积误差
+ * - 只实现 ek_evoke_set_timer() / ek_evoke_deep_sleep() / ek_evoke_light_sleep()
+ *   和 ek_evoke_delay_timer_callback() 的移植仍然可用，但提前唤醒时时间基准会落后
  */
 
 #ifndef EK_EVOKE_H
@@ -22,6 +32,7 @@
 
 /**
  * @brief ISR 请求队列最大容量
+ * @note 可在 ek_conf.h 或编译选项中按应用调整，下同
  */
 #    ifndef EK_EVOKE_MAX_ISR_REQ
 #        define EK_EVOKE_MAX_ISR_REQ (10)
@@ -34,6 +45,145 @@
 #        define EK_EVOKE_MAX_DEFER_REQ (10)
 #    endif /* EK_EVOKE_MAX_DEFER_REQ */
 
+/**
+ * @brief 延迟请求池耗尽时是否从堆中分配新的请求
+ * @note 静态池仍然优先使用，从堆中分配的请求用完后留在空闲链表中复用，ek_evoke_init() 时才归还到堆
+ */
+#    ifndef EK_EVOKE_DEFER_GROW
+#        define EK_EVOKE_DEFER_GROW (0)
+#    endif /* EK_EVOKE_DEFER_GROW */
+
+#    define EK_EVOKE_OVERFLOW_DROP      (0) /**< 队列满时丢弃新请求 */
+#    define EK_EVOKE_OVERFLOW_COALESCE  (1) /**< 队列满时与已排队的相同请求合并，找不到则丢弃 */
+#    define EK_EVOKE_OVERFLOW_OVERWRITE (2) /**< 队列满时覆盖最早提交的请求 */
+
+/**
+ * @brief ISR 请求队列和延迟请求池满时的处理策略
+ * @note 合并和覆盖只在队列满时发生，需要遍历队列，复杂度 O(n)
+ */
+#    ifndef EK_EVOKE_OVERFLOW_POLICY
+#        define EK_EVOKE_OVERFLOW_POLICY EK_EVOKE_OVERFLOW_DROP
+#    endif /* EK_EVOKE_OVERFLOW_POLICY */
+
+/**
+ * @brief 延迟请求是否用二叉最小堆保存
+ * @note 为 1 时插入/取消 O(log n)、取最早请求 O(1)；为 0 时使用按唤醒时间排序的链表，插入 O(n)
+ */
+#    ifndef EK_EVOKE_DEFER_USE_HEAP
+#        define EK_EVOKE_DEFER_USE_HEAP (0)
+#    endif /* EK_EVOKE_DEFER_USE_HEAP */
+
+/**
+ * @brief 任务和事件是否从静态内存块池分配
+ * @note 池耗尽时回退到 ek_malloc，销毁时按地址自动归还到对应的位置
+ */
+#    ifndef EK_EVOKE_USE_MEMPOOL
+#        define EK_EVOKE_USE_MEMPOOL (0)
+#    endif /* EK_EVOKE_USE_MEMPOOL */
+
+/**
+ * @brief 任务优先级数量（1 ~ 32），优先级范围 0 ~ EK_EVOKE_PRIO_LEVELS - 1
+ * @note 每个优先级一条就绪链表，用位图和前导零计数在 O(1) 内找到最高优先级
+ */
+#    ifndef EK_EVOKE_PRIO_LEVELS
+#        define EK_EVOKE_PRIO_LEVELS (8)
+#    endif /* EK_EVOKE_PRIO_LEVELS */
+
+#    if EK_EVOKE_PRIO_LEVELS < 1 || EK_EVOKE_PRIO_LEVELS > 32
+#        error "EK_EVOKE_PRIO_LEVELS must be in 1 ~ 32"
+#    endif /* EK_EVOKE_PRIO_LEVELS */
+
+/**
+ * @brief 调度器时间基准的初始值
+ * @note 设置为接近 UINT32_MAX 的值可以在测试中尽早覆盖 32 位回绕
+ */
+#    ifndef EK_EVOKE_TICK_INIT
+#        define EK_EVOKE_TICK_INIT (0U)
+#    endif /* EK_EVOKE_TICK_INIT */
+
+/**
+ * @brief ek_evoke_sleep() 的 xtick 取此值表示没有待到期的请求，只等待中断唤醒
+ */
+#    define EK_EVOKE_TICK_FOREVER (UINT32_MAX)
+
+/**
+ * @brief 延迟发布和等待超时允许的最大 tick 数
+ * @note 唤醒时间按有符号差值比较，延迟不能超过半个 32 位周期
+ */
+#    define EK_EVOKE_MAX_DELAY (0x7FFFFFFFUL)
+
+/**
+ * @brief 是否支持任务截止时间
+ * @note 同一优先级内有截止时间的任务按截止时间先后排在无截止时间的任务之前，
+ *       执行时已超过截止时间则计入 deadline_miss 并调用 ek_evoke_deadline_miss()
+ */
+#    ifndef EK_EVOKE_DEADLINE_ENABLE
+#        define EK_EVOKE_DEADLINE_ENABLE (0)
+#    endif /* EK_EVOKE_DEADLINE_ENABLE */
+
+/**
+ * @brief 是否统计任务和主循环的运行时间
+ * @note 时间来自 ek_evoke_stats_clock()，默认与 ek_evoke_get_tick() 相同，
+ *       需要更细的粒度时可以重写为周期计数器（如 DWT->CYCCNT）
+ * @note 弱函数 ek_evoke_get_tick() 返回的调度器时间只在睡眠返回时推进，回调执行期间不变，
+ *       两者都不重写时运行时间恒为 0，睡眠占比也没有意义
+ */
+#    ifndef EK_EVOKE_STATS_ENABLE
+#        define EK_EVOKE_STATS_ENABLE (0)
+#    endif /* EK_EVOKE_STATS_ENABLE */
+
+/**
+ * @brief 唤醒延迟直方图的分档数量（至少 2）
+ * @note 第 0 档为延迟 0，第 n 档为 [2^(n-1), 2^n)，最后一档包含更大的延迟
+ */
+#    ifndef EK_EVOKE_STATS_HIST_BINS
+#        define EK_EVOKE_STATS_HIST_BINS (8)
+#    endif /* EK_EVOKE_STATS_HIST_BINS */
+
+#    if EK_EVOKE_STATS_HIST_BINS < 2 || EK_EVOKE_STATS_HIST_BINS > 33
+#        error "EK_EVOKE_STATS_HIST_BINS must be in 2 ~ 33"
+#    endif /* EK_EVOKE_STATS_HIST_BINS */
+
+/**
+ * @brief 一个任务最多同时等待的事件数量（ek_evoke_task_await_any()）
+ * @note 每个任务为每个可等待的事件保留一个等待节点，发布时只摘下被唤醒任务的节点，与等待者数量无关
+ */
+#    ifndef EK_EVOKE_WAIT_ANY_MAX
+#        define EK_EVOKE_WAIT_ANY_MAX (4)
+#    endif /* EK_EVOKE_WAIT_ANY_MAX */
+
+#    if EK_EVOKE_WAIT_ANY_MAX < 1 || EK_EVOKE_WAIT_ANY_MAX > 255
+#        error "EK_EVOKE_WAIT_ANY_MAX must be in 1 ~ 255"
+#    endif /* EK_EVOKE_WAIT_ANY_MAX */
+
+/**
+ * @brief 是否支持事件组
+ * @note 事件组保存 32 个事件位，任务可以等待其中任意一位或全部位被置位
+ */
+#    ifndef EK_EVOKE_GROUP_ENABLE
+#        define EK_EVOKE_GROUP_ENABLE (0)
+#    endif /* EK_EVOKE_GROUP_ENABLE */
+
+#    if EK_EVOKE_USE_MEMPOOL == 1
+#        if EK_MEMPOOL_ENABLE != 1
+#            error "EK_EVOKE_USE_MEMPOOL requires EK_MEMPOOL_ENABLE"
+#        endif /* EK_MEMPOOL_ENABLE */
+
+/**
+ * @brief 任务内存块池容量
+ */
+#        ifndef EK_EVOKE_TASK_POOL_SIZE
+#            define EK_EVOKE_TASK_POOL_SIZE (8)
+#        endif /* EK_EVOKE_TASK_POOL_SIZE */
+
+/**
+ * @brief 事件内存块池容量
+ */
+#        ifndef EK_EVOKE_EVENT_POOL_SIZE
+#            define EK_EVOKE_EVENT_POOL_SIZE (8)
+#        endif /* EK_EVOKE_EVENT_POOL_SIZE */
+#    endif /* EK_EVOKE_USE_MEMPOOL */
+
 /**
  * @brief 任务结构体（前置声明）
  */
@@ -44,6 +194,11 @@ typedef struct ek_evoke_task_t ek_evoke_task_t;
  */
 typedef struct ek_evoke_event_t ek_evoke_event_t;
 
+/**
+ * @brief 事件组结构体（前置声明）
+ */
+typedef struct ek_evoke_group_t ek_evoke_group_t;
+
 /**
  * @brief 任务句柄类型
  */
@@ -54,6 +209,30 @@ typedef ek_evoke_task_t *ek_evoke_task_handle_t;
  */
 typedef ek_evoke_event_t *ek_evoke_event_handle_t;
 
+/**
+ * @brief 事件组句柄类型
+ */
+typedef ek_evoke_group_t *ek_evoke_group_handle_t;
+
+/**
+ * @brief 延迟请求句柄
+ * @note 单次请求到期、请求被取消或覆盖、所属事件被销毁后句柄失效，失效的句柄仍可以安全地传给
+ *       ek_evoke_defer_cancel() 等接口，它们返回 false
+ */
+typedef struct
+{
+    void *req; /**< 内部请求，NULL 表示空句柄 */
+    uint32_t gen; /**< 发出句柄时请求的代数，请求每次归还后代数改变 */
+} ek_evoke_defer_t;
+
+/**
+ * @brief 空句柄，用于初始化保存句柄的变量
+ */
+#    define EK_EVOKE_DEFER_NONE ((ek_evoke_defer_t){ NULL, 0 })
+
+#    define EK_EVOKE_GROUP_WAIT_ALL (0x01) /**< 等待 mask 中的全部位，默认只要任意一位 */
+#    define EK_EVOKE_GROUP_CLEAR    (0x02) /**< 条件满足后清除 mask 中的位 */
+
 /**
  * @brief 任务回调函数类型
  * @param evt 触发的事件
@@ -61,13 +240,19 @@ typedef ek_evoke_event_t *ek_evoke_event_handle_t;
  */
 typedef void (*ek_evoke_cb_t)(ek_evoke_event_t *, void *);
 
+/**
+ * @brief 从中断提交、在主循环中执行的函数类型
+ * @param arg 提交时传入的参数
+ */
+typedef void (*ek_evoke_call_cb_t)(void *);
+
 /**
  * @brief 任务状态枚举
  */
 typedef enum
 {
     EK_EVOKE_STATE_IDLE = 0, /**< 空闲状态 */
-    EK_EVOKE_STATE_DELAY, /**< 延迟状态 */
+    EK_EVOKE_STATE_DELAY, /**< 延迟状态（只等待超时） */
     EK_EVOKE_STATE_WAITTING, /**< 等待状态 */
     EK_EVOKE_STATE_READY, /**< 就绪状态 */
     EK_EVOKE_STATE_RUNNING, /**< 运行状态 */
@@ -75,17 +260,94 @@ typedef enum
     EK_EVOKE_STATE_MAX, /**< 状态最大值 */
 } ek_evoke_state_t;
 
+/**
+ * @brief 请求队列统计信息
+ */
+typedef struct
+{
+    uint32_t capacity; /**< 静态容量 */
+    uint32_t used; /**< 当前排队的请求数 */
+    uint32_t peak; /**< used 的历史最大值（高水位） */
+    uint32_t dropped; /**< 因队列满被丢弃的请求数 */
+    uint32_t coalesced; /**< 与已排队请求合并的请求数 */
+    uint32_t overwritten; /**< 被新请求覆盖的旧请求数 */
+} ek_evoke_queue_stats_t;
+
+#    if EK_EVOKE_STATS_ENABLE == 1
+/**
+ * @brief 任务运行统计，时间单位为 ek_evoke_stats_clock() 的计数
+ */
+typedef struct
+{
+    uint32_t run_count; /**< 回调执行次数 */
+    uint64_t run_total; /**< 回调累计执行时间 */
+    uint32_t run_max; /**< 单次回调最长执行时间 */
+    uint64_t latency_total; /**< 从就绪到开始执行的累计延迟 */
+    uint32_t latency_max; /**< 最大唤醒延迟 */
+    uint32_t latency_hist[EK_EVOKE_STATS_HIST_BINS]; /**< 唤醒延迟直方图，按 2 的幂分档 */
+} ek_evoke_task_stats_t;
+
+/**
+ * @brief 主循环统计，时间单位为 ek_evoke_stats_clock() 的计数
+ */
+typedef struct
+{
+    uint64_t elapsed; /**< 从初始化或上次清零到现在的时间 */
+    uint64_t busy; /**< 不在睡眠中的时间（elapsed - light_sleep - deep_sleep） */
+    uint64_t light_sleep; /**< 浅睡眠累计时间 */
+    uint64_t deep_sleep; /**< 深度睡眠累计时间 */
+    uint32_t light_count; /**< 浅睡眠次数 */
+    uint32_t deep_count; /**< 深度睡眠次数 */
+    uint32_t isr_depth; /**< ISR 请求队列当前深度 */
+    uint32_t isr_peak; /**< ISR 请求队列高水位 */
+    uint32_t defer_len; /**< 当前排队的延迟请求数（含任务等待超时） */
+    uint32_t defer_peak; /**< 延迟请求高水位 */
+} ek_evoke_loop_stats_t;
+#    endif /* EK_EVOKE_STATS_ENABLE */
+
+/**
+ * @brief 等待节点，挂在事件（或事件组）的等待链表上
+ */
+typedef struct
+{
+    ek_list_node_t node; /**< 等待链表节点 */
+    ek_evoke_task_t *tsk; /**< 所属任务 */
+    ek_evoke_event_t *evt; /**< 等待的事件 */
+} ek_evoke_waiter_t;
+
 /**
  * @brief 任务结构体
  */
 struct ek_evoke_task_t
 {
     ek_evoke_state_t state; /**< 任务状态 */
-    ek_list_node_t node; /**< 链表节点 */
+    ek_list_node_t node; /**< 就绪链表节点 */
     const char *name; /**< 任务名称 */
-    ek_evoke_event_t *wait_event; /**< 等待的事件 */
+    ek_evoke_event_t *wait_event; /**< 等待的事件；同时等待多个事件时为唤醒任务的事件，超时为 NULL */
+    ek_evoke_waiter_t waiters[EK_EVOKE_WAIT_ANY_MAX]; /**< 每个等待的事件一个等待节点 */
+    uint8_t wait_count; /**< 等待的事件数量，0 表示没有等待事件 */
     void *arg; /**< 用户参数 */
     ek_evoke_cb_t cb; /**< 回调函数 */
+    void *timer; /**< 等待超时使用的延迟请求，NULL 表示没有超时 */
+    bool timed_out; /**< 上一次等待是否因超时结束 */
+    uint32_t co_line; /**< 协程恢复位置，0 表示从头开始（见 ek_co.h） */
+    uint8_t prio; /**< 优先级，数值越大优先级越高 */
+#    if EK_EVOKE_GROUP_ENABLE == 1
+    ek_evoke_group_t *wait_group; /**< 等待的事件组，使用 waiters[0] 挂在事件组上 */
+    uint32_t group_mask; /**< 等待的事件位 */
+    uint8_t group_flags; /**< EK_EVOKE_GROUP_WAIT_ALL / EK_EVOKE_GROUP_CLEAR */
+    uint32_t group_bits; /**< 条件满足时事件组的值（清除之前），超时时为当时的值 */
+#    endif /* EK_EVOKE_GROUP_ENABLE */
+#    if EK_EVOKE_DEADLINE_ENABLE == 1
+    uint32_t deadline; /**< 相对截止时间（tick），0 表示没有截止时间 */
+    uint32_t due; /**< 本次就绪的绝对截止时间 */
+    uint32_t deadline_miss; /**< 超过截止时间才开始执行的次数 */
+#    endif /* EK_EVOKE_DEADLINE_ENABLE */
+#    if EK_EVOKE_STATS_ENABLE == 1
+    ek_list_node_t stats_node; /**< 所有任务链表节点，用于遍历统计 */
+    uint32_t ready_stamp; /**< 本次就绪的时间 */
+    ek_evoke_task_stats_t stats; /**< 运行统计 */
+#    endif /* EK_EVOKE_STATS_ENABLE */
 };
 
 /**
@@ -99,6 +361,18 @@ struct ek_evoke_event_t
     void *data; /**< 事件携带的数据 */
 };
 
+#    if EK_EVOKE_GROUP_ENABLE == 1
+/**
+ * @brief 事件组结构体
+ */
+struct ek_evoke_group_t
+{
+    ek_list_node_t wait_list; /**< 等待该事件组的任务链表 */
+    const char *name; /**< 事件组名称 */
+    uint32_t bits; /**< 事件位 */
+};
+#    endif /* EK_EVOKE_GROUP_ENABLE */
+
 /* ========== 初始化 ========== */
 
 /**
@@ -122,9 +396,78 @@ ek_evoke_task_handle_t ek_evoke_task_create(const char *name, ek_evoke_cb_t cb,
 /**
  * @brief 销毁任务
  * @param tsk 任务句柄
+ *
+ * @note 可以在任务自己的回调中销毁自己（如 ek_evoke_task_destroy(ek_evoke_task_self())），
+ *       任务立即停止，内存在回调返回后释放，之后不能再使用该句柄
  */
 void ek_evoke_task_destroy(ek_evoke_task_handle_t tsk);
 
+/**
+ * @brief 指定任务下一次等待的事件和超时
+ * @param tsk 任务句柄
+ * @param evt 等待的事件，NULL 表示只等待超时（延时）
+ * @param timeout 超时时间（tick），0 表示不超时；evt 为 NULL 时 0 表示让出一次
+ * @return true 任务立即就绪（事件已有计数或延时为 0）
+ * @return false 任务进入等待状态
+ *
+ * @note 可以在任务自己的回调中调用，让每次等待的事件都不同；回调返回后不再恢复等待原来的事件
+ * @note 事件先到达时超时自动取消，超时先到达时任务从事件的等待链表中移除，timed_out 置为 true
+ * @note 超时请求与延迟发布共用 EK_EVOKE_MAX_DEFER_REQ 请求池
+ */
+bool ek_evoke_task_await(ek_evoke_task_handle_t tsk, ek_evoke_event_handle_t evt, uint32_t timeout);
+
+/**
+ * @brief 指定任务下一次同时等待多个事件，任意一个发布即就绪
+ * @param tsk 任务句柄
+ * @param evts 事件数组，内容会被复制，调用后可以释放
+ * @param amount 事件数量（1 ~ EK_EVOKE_WAIT_ANY_MAX）
+ * @param timeout 超时时间（tick），0 表示不超时
+ * @return true 任务立即就绪（某个事件已有计数，按数组顺序检查）
+ * @return false 任务进入等待状态
+ *
+ * @note 回调参数 evt 为唤醒任务的事件，超时时为 NULL；其他事件的计数不受影响
+ * @note 回调返回后继续等待同一组事件
+ */
+bool ek_evoke_task_await_any(ek_evoke_task_handle_t tsk,
+                             ek_evoke_event_handle_t const evts[],
+                             uint32_t amount,
+                             uint32_t timeout);
+
+/**
+ * @brief 停止任务，不再等待任何事件
+ * @param tsk 任务句柄
+ *
+ * @note 协程恢复位置同时清零，重新订阅后从头开始
+ */
+void ek_evoke_task_stop(ek_evoke_task_handle_t tsk);
+
+/**
+ * @brief 获取正在执行回调的任务
+ * @return 任务句柄，不在任务回调中时返回 NULL
+ */
+ek_evoke_task_handle_t ek_evoke_task_self(void);
+
+/**
+ * @brief 设置任务优先级
+ * @param tsk 任务句柄
+ * @param prio 优先级（0 ~ EK_EVOKE_PRIO_LEVELS - 1），数值越大优先级越高
+ *
+ * @note 新建任务的优先级为 0；任务已就绪时立即移到新优先级的就绪链表
+ */
+void ek_evoke_task_set_priority(ek_evoke_task_handle_t tsk, uint8_t prio);
+
+#    if EK_EVOKE_DEADLINE_ENABLE == 1
+/**
+ * @brief 设置任务截止时间
+ * @param tsk 任务句柄
+ * @param deadline 从就绪到开始执行允许的最长时间（tick），0 表示没有截止时间
+ *
+ * @note 只影响同一优先级内的顺序，不会让低优先级任务越过高优先级任务
+ * @note 对下一次就绪生效
+ */
+void ek_evoke_task_set_deadline(ek_evoke_task_handle_t tsk, uint32_t deadline);
+#    endif /* EK_EVOKE_DEADLINE_ENABLE */
+
 /**
  * @brief 创建事件
  * @param name 事件名称
@@ -138,9 +481,80 @@ ek_evoke_event_handle_t ek_evoke_event_create(const char *name, uint32_t init);
  * @param evt 事件句柄
  *
  * @warning 销毁事件时会将所有等待该事件的任务状态设为 IDLE
+ * @note 该事件尚未到期的延迟发布请求会被一并取消
  */
 void ek_evoke_event_destroy(ek_evoke_event_handle_t evt);
 
+#    if EK_EVOKE_GROUP_ENABLE == 1
+/**
+ * @brief 创建事件组
+ * @param name 事件组名称
+ * @return 事件组句柄，所有位初始为 0
+ */
+ek_evoke_group_handle_t ek_evoke_group_create(const char *name);
+
+/**
+ * @brief 销毁事件组
+ * @param grp 事件组句柄
+ *
+ * @warning 等待该事件组的任务状态设为 IDLE
+ */
+void ek_evoke_group_destroy(ek_evoke_group_handle_t grp);
+
+/**
+ * @brief 置位事件组中的位，唤醒条件满足的任务
+ * @param grp 事件组句柄
+ * @param bits 要置位的位
+ * @return 唤醒任务并清除位之后事件组的值
+ */
+uint32_t ek_evoke_group_set(ek_evoke_group_handle_t grp, uint32_t bits);
+
+/**
+ * @brief 清除事件组中的位
+ * @param grp 事件组句柄
+ * @param bits 要清除的位
+ * @return 清除之前事件组的值
+ */
+uint32_t ek_evoke_group_clear(ek_evoke_group_handle_t grp, uint32_t bits);
+
+/**
+ * @brief 读取事件组的值
+ * @param grp 事件组句柄
+ * @return 事件组的值
+ */
+uint32_t ek_evoke_group_get(ek_evoke_group_handle_t grp);
+
+/**
+ * @brief 指定任务下一次等待事件组中的位
+ * @param tsk 任务句柄
+ * @param grp 事件组句柄
+ * @param mask 等待的位，不能为 0
+ * @param flags EK_EVOKE_GROUP_WAIT_ALL / EK_EVOKE_GROUP_CLEAR 的组合
+ * @param timeout 超时时间（tick），0 表示不超时
+ * @return true 条件已经满足，任务立即就绪
+ * @return false 任务进入等待状态
+ *
+ * @note 回调参数 evt 为 NULL，满足条件时事件组的值保存在 tsk->group_bits
+ * @note 回调返回后继续以相同条件等待该事件组；不带 EK_EVOKE_GROUP_CLEAR 时条件仍然满足，
+ *       任务会立即再次执行，需要在回调中清除事件位或重新指定等待对象
+ */
+bool ek_evoke_group_wait(ek_evoke_task_handle_t tsk,
+                         ek_evoke_group_handle_t grp,
+                         uint32_t mask,
+                         uint8_t flags,
+                         uint32_t timeout);
+
+/**
+ * @brief ISR 中置位事件组中的位
+ * @param grp 事件组句柄
+ * @param bits 要置位的位
+ *
+ * @note 请求会被放入 ISR 请求队列，在主循环中处理
+ * @note 队列满时按 EK_EVOKE_OVERFLOW_POLICY 处理，结果计入 ek_evoke_isr_stats()
+ */
+void ek_evoke_group_set_from_isr(ek_evoke_group_handle_t grp, uint32_t bits);
+#    endif /* EK_EVOKE_GROUP_ENABLE */
+
 /* ========== 事件订阅/分发 ========== */
 
 /**
@@ -149,9 +563,23 @@ void ek_evoke_event_destroy(ek_evoke_event_handle_t evt);
  * @param evt 事件句柄
  * @return true 任务立即就绪（事件已有计数）
  * @return false 任务进入等待状态
+ *
+ * @note 等价于 ek_evoke_task_await(tsk, evt, 0)
  */
 bool ek_evoke_event_subscribe(ek_evoke_task_handle_t tsk, ek_evoke_event_handle_t evt);
 
+/**
+ * @brief 任务订阅多个事件，任意一个发布即执行回调
+ * @param tsk 任务句柄
+ * @param evts 事件数组
+ * @param amount 事件数量（1 ~ EK_EVOKE_WAIT_ANY_MAX）
+ * @return true 任务立即就绪（某个事件已有计数）
+ * @return false 任务进入等待状态
+ *
+ * @note 等价于 ek_evoke_task_await_any(tsk, evts, amount, 0)
+ */
+bool ek_evoke_event_subscribe_any(ek_evoke_task_handle_t tsk, ek_evoke_event_handle_t const evts[], uint32_t amount);
+
 /**
  * @brief 广播事件（唤醒所有等待任务）
  * @param evt 事件句柄
@@ -176,8 +604,55 @@ void ek_evoke_event_publish(ek_evoke_event_handle_t evt, void *payload);
  * @param payload 事件携带的数据
  * @param delay 延迟时间（tick）
  * @param broadcast true 广播模式，false 发布模式
+ *
+ * @return 请求句柄，可用于取消或重新计时；delay 为 0 时立即发布并返回空句柄，请求被丢弃时也返回空句柄
+ *
+ * @note 请求池满时按 EK_EVOKE_OVERFLOW_POLICY 处理，结果计入 ek_evoke_defer_stats()
+ * @note 合并到已有请求时返回已有请求的句柄
+ */
+ek_evoke_defer_t ek_evoke_event_defer(ek_evoke_event_handle_t evt, void *payload, uint32_t delay, bool broadcast);
+
+/**
+ * @brief 周期发布事件
+ * @param evt 事件句柄
+ * @param payload 事件携带的数据
+ * @param period 周期（tick），第一次在一个周期后发布
+ * @param broadcast true 广播模式，false 发布模式
+ * @return 请求句柄，请求被丢弃时返回空句柄
+ *
+ * @note 每次到期后同一个请求按周期累加唤醒时间重新排队，不重新分配，也不随处理延迟漂移
+ * @note 主循环被阻塞超过一个周期时，错过的周期合并为一次发布
+ * @note 周期请求一直占用请求池，直到 ek_evoke_defer_cancel() 或事件被销毁；不参与合并和覆盖
+ */
+ek_evoke_defer_t ek_evoke_event_defer_periodic(ek_evoke_event_handle_t evt, void *payload, uint32_t period,
+                                               bool broadcast);
+
+/**
+ * @brief 取消延迟请求
+ * @param handle 请求句柄
+ * @return true 请求尚未到期并已取消；false 句柄已失效
+ *
+ * @note 使用二叉堆时 O(log n)，使用链表时 O(1)
+ */
+bool ek_evoke_defer_cancel(ek_evoke_defer_t handle);
+
+/**
+ * @brief 重新计时：请求改为从现在起 delay 个 tick 后到期
+ * @param handle 请求句柄
+ * @param delay 延迟时间（tick），0 表示在主循环下一次检查延迟请求时到期
+ * @return true 成功；false 句柄已失效，需要重新调用 ek_evoke_event_defer()
+ *
+ * @note 用于看门狗一类的超时：每收到一次数据就推迟一次，请求不经过请求池
+ * @note 周期请求重新计时后，之后的发布仍按原周期进行
  */
-void ek_evoke_event_defer(ek_evoke_event_handle_t evt, void *payload, uint32_t delay, bool broadcast);
+bool ek_evoke_defer_restart(ek_evoke_defer_t handle, uint32_t delay);
+
+/**
+ * @brief 请求是否仍在排队
+ * @param handle 请求句柄
+ * @return true 尚未到期；false 句柄已失效
+ */
+bool ek_evoke_defer_pending(ek_evoke_defer_t handle);
 
 /**
  * @brief ISR 中广播事件
@@ -185,6 +660,7 @@ void ek_evoke_event_defer(ek_evoke_event_handle_t evt, void *payload, uint32_t d
  * @param payload 事件携带的数据
  *
  * @note 请求会被放入 ISR 请求队列，在主循环中处理
+ * @note 队列满时按 EK_EVOKE_OVERFLOW_POLICY 处理，结果计入 ek_evoke_isr_stats()
  */
 void ek_evoke_event_broadcast_from_isr(ek_evoke_event_handle_t evt, void *payload);
 
@@ -194,6 +670,7 @@ void ek_evoke_event_broadcast_from_isr(ek_evoke_event_handle_t evt, void *payloa
  * @param payload 事件携带的数据
  *
  * @note 请求会被放入 ISR 请求队列，在主循环中处理
+ * @note 队列满时按 EK_EVOKE_OVERFLOW_POLICY 处理，结果计入 ek_evoke_isr_stats()
  */
 void ek_evoke_event_publish_from_isr(ek_evoke_event_handle_t evt, void *payload);
 
@@ -205,9 +682,67 @@ void ek_evoke_event_publish_from_isr(ek_evoke_event_handle_t evt, void *payload)
  * @param broadcast true 广播模式，false 发布模式
  *
  * @note 请求会被放入 ISR 请求队列，在主循环中处理
+ * @note 队列满时按 EK_EVOKE_OVERFLOW_POLICY 处理，结果计入 ek_evoke_isr_stats()
  */
 void ek_evoke_event_defer_from_isr(ek_evoke_event_handle_t evt, void *payload, uint32_t delay, bool broadcast);
 
+/**
+ * @brief ISR 中提交函数调用，由主循环执行 fn(arg)
+ * @param fn 要执行的函数
+ * @param arg 传给 fn 的参数
+ *
+ * @note 不需要为每个中断源预先创建事件和任务，中断里只做最少的工作，其余推迟到主循环
+ * @note 与其他 ISR 请求共用队列并按提交顺序执行；主循环每执行完一个任务回调、每次醒来都会清空队列，
+ *       因此最坏等待时间为一次任务回调的执行时间
+ * @note 队列满时按 EK_EVOKE_OVERFLOW_POLICY 处理，合并只发生在 fn 和 arg 都相同时，结果计入 ek_evoke_isr_stats()
+ */
+void ek_evoke_call_from_isr(ek_evoke_call_cb_t fn, void *arg);
+
+/* ========== 统计 ========== */
+
+/**
+ * @brief 获取延迟请求池的统计信息
+ * @param stats 输出的统计信息
+ *
+ * @note 开启 EK_EVOKE_DEFER_GROW 时 used 可以超过 capacity
+ */
+void ek_evoke_defer_stats(ek_evoke_queue_stats_t *stats);
+
+/**
+ * @brief 获取 ISR 请求队列的统计信息
+ * @param stats 输出的统计信息
+ */
+void ek_evoke_isr_stats(ek_evoke_queue_stats_t *stats);
+
+#    if EK_EVOKE_STATS_ENABLE == 1
+/**
+ * @brief 获取任务运行统计
+ * @param tsk 任务句柄
+ * @param stats 输出的统计信息
+ */
+void ek_evoke_task_stats(ek_evoke_task_handle_t tsk, ek_evoke_task_stats_t *stats);
+
+/**
+ * @brief 获取主循环统计
+ * @param stats 输出的统计信息
+ */
+void ek_evoke_loop_stats(ek_evoke_loop_stats_t *stats);
+
+/**
+ * @brief 清零所有任务和主循环的运行统计，从现在开始重新计时
+ *
+ * @note 队列的高水位和丢弃计数不受影响
+ */
+void ek_evoke_stats_reset(void);
+
+/**
+ * @brief 打印主循环统计和每个任务的运行统计
+ *
+ * @note 开启 Shell 时导出为 evoke 命令：evoke top 打印，evoke reset 清零
+ */
+void ek_evoke_top(void);
+#    endif /* EK_EVOKE_STATS_ENABLE */
+
 /* ========== 睡眠锁 ========== */
 
 /**
@@ -233,12 +768,30 @@ void ek_evoke_sleep_unlock(void);
  */
 void ek_evoke_event_loop(void);
 
+/**
+ * @brief 执行一轮主循环
+ * @return true 执行了一个任务回调；false 没有就绪任务，本轮睡眠到最早的延迟请求（或被中断唤醒）并发布了到期请求
+ *
+ * @note 与 ek_evoke_event_loop() 的一次循环完全相同，供主机测试或需要在主循环之间插入其他工作的场合使用
+ * @note 没有任何待处理请求时会调用 ek_evoke_sleep(EK_EVOKE_TICK_FOREVER, ...)，由移植决定是否返回
+ */
+bool ek_evoke_run_once(void);
+
+/**
+ * @brief 运行主循环直到调度器时间到达 tick
+ * @param tick 目标时间（调度器时间，睡眠钩子如实报告经过时间时与 ek_evoke_get_tick() 一致）
+ *
+ * @note 睡眠时间被截断到目标时间，不会越过 tick；到达后处理完到期请求、ISR 请求和就绪任务再返回
+ * @note tick 与当前时间的有符号差值不大于 0 时只处理已经就绪的工作
+ */
+void ek_evoke_run_until(uint32_t tick);
+
 /* ========== 回调函数 ========== */
 
 /**
  * @brief 延迟定时器回调函数
  *
- * @note 在定时器中断中调用，用于唤醒延迟事件
+ * @note 在 ek_evoke_set_timer() 设置的定时器中断中调用，只在使用默认的 ek_evoke_sleep() 时需要
  */
 void ek_evoke_delay_timer_callback(void);
 
@@ -262,10 +815,53 @@ void ek_evoke_exit_critical(void);
  * @brief 设置定时器（弱函数）
  * @param xtick 定时器触发时间（tick）
  *
- * @note 用户需要实现此函数，用于延迟事件的定时唤醒
+ * @note 使用默认的 ek_evoke_sleep() 时需要实现，用于延迟事件的定时唤醒，到期时调用 ek_evoke_delay_timer_callback()
  */
 void ek_evoke_set_timer(uint32_t xtick);
 
+/**
+ * @brief 获取当前时间（弱函数）
+ * @return 当前 tick
+ *
+ * @note 用于截止时间判断，默认返回调度器的时间基准（最近一次睡眠返回时的时间），精度较低，建议用户实现
+ */
+uint32_t ek_evoke_get_tick(void);
+
+/**
+ * @brief 睡眠直到下一个延迟请求到期或被中断唤醒（弱函数）
+ * @param xtick 从上一次返回时算起，到下一个延迟请求到期的 tick 数；EK_EVOKE_TICK_FOREVER 表示没有待到期的请求
+ * @param deep true 允许深度睡眠，false 有睡眠锁，只能浅睡眠
+ * @return 从上一次返回到这一次返回之间经过的 tick 数（包括两次睡眠之间任务运行的时间）
+ *
+ * @note 定时器应按上一次返回时的计数值加 xtick 设置绝对比较值，这样任务运行的时间不会推迟到期时间
+ * @note 可以提前返回（被其他中断唤醒），调度器会按剩余时间再次调用
+ * @note 默认实现调用 ek_evoke_set_timer() 和浅/深睡眠钩子，定时器到期（ek_evoke_delay_timer_callback()）
+ *       时返回设定的时间，否则返回 0
+ */
+uint32_t ek_evoke_sleep(uint32_t xtick, bool deep);
+
+#    if EK_EVOKE_STATS_ENABLE == 1
+/**
+ * @brief 获取运行统计使用的时间（弱函数）
+ * @return 单调递增的计数，允许回绕
+ *
+ * @note 默认返回 ek_evoke_get_tick()，可以重写为周期计数器以统计短回调
+ * @note 时钟必须自由运行；ek_evoke_get_tick() 也使用默认实现时，这里必须重写
+ */
+uint32_t ek_evoke_stats_clock(void);
+#    endif /* EK_EVOKE_STATS_ENABLE */
+
+#    if EK_EVOKE_DEADLINE_ENABLE == 1
+/**
+ * @brief 任务错过截止时间（弱函数）
+ * @param tsk 任务句柄
+ * @param late 开始执行时超过截止时间的 tick 数
+ *
+ * @note 在任务回调执行前调用，默认什么都不做
+ */
+void ek_evoke_deadline_miss(ek_evoke_task_handle_t tsk, uint32_t late);
+#    endif /* EK_EVOKE_DEADLINE_ENABLE */
+
 /**
  * @brief 浅睡眠（弱函数）
  *
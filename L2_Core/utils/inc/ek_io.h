@@ -6,6 +6,8 @@
  * 提供基于 lwprintf 的轻量级标准输入输出功能
  *
  * @note 使用前需实现 _ek_io_fputc() 函数，用于底层字符输出
+ * @note EK_IO_BUFFER_SIZE > 0 时 ek_printf 的输出先进入缓冲区，遇到换行、缓冲区满或调用 ek_io_flush() 时
+ *       通过 _ek_io_write() 整块输出，每行只调用一次驱动
  */
 
 #ifndef EK_IO_H
@@ -18,6 +20,55 @@ extern "C"
 {
 #endif
 
+#include <stdint.h>
+
+/**
+ * @brief 输出缓冲区大小（字节）
+ * @note 0 = 不缓冲，每个字符直接调用 _ek_io_fputc()；
+ *       > 0 = 使用两块该大小的缓冲区轮流收集输出，静态占用 2 * EK_IO_BUFFER_SIZE 字节
+ */
+#ifndef EK_IO_BUFFER_SIZE
+#    define EK_IO_BUFFER_SIZE (0)
+#endif /* EK_IO_BUFFER_SIZE */
+
+/**
+ * @brief 定义块输出函数
+ * @note 默认实现逐字节调用 _ek_io_fputc()；实现为 DMA 发送时，buf 在下一次调用 _ek_io_write() 之前保持有效，
+ *       启动新的传输前需要等待上一次传输完成
+ * @example
+ * EK_IO_WRITE()
+ * {
+ *     HAL_UART_Transmit_DMA(&huart1, (uint8_t *)buf, len);
+ * }
+ */
+#define EK_IO_WRITE() void _ek_io_write(const uint8_t *buf, uint32_t len)
+
+/**
+ * @brief 输出一块数据（弱函数）
+ * @param buf 数据
+ * @param len 长度（字节）
+ */
+void _ek_io_write(const uint8_t *buf, uint32_t len);
+
+/**
+ * @brief 把缓冲区中尚未输出的内容交给 _ek_io_write()
+ * @note EK_IO_BUFFER_SIZE == 0 时为空操作
+ */
+void ek_io_flush(void);
+
+/**
+ * @brief 进入输出缓冲区临界区（弱函数，默认空实现）
+ * @note 仅 EK_IO_BUFFER_SIZE > 0 时使用；多个上下文（任务、中断）都会调用 ek_printf 或 ek_io_flush() 时，
+ *       需要提供关中断或加锁的强定义，否则只能在单一上下文中输出
+ * @note 临界区只保护缓冲区的写入和切换，_ek_io_write() 在临界区外调用，驱动需要自行处理并发的发送请求
+ */
+void ek_io_enter_critical(void);
+
+/**
+ * @brief 退出输出缓冲区临界区（弱函数，默认空实现）
+ */
+void ek_io_exit_critical(void);
+
 #if EK_IO_NO_LWPRTF == 0
 
 #    include "../../third_party/lwprintf/inc/lwprintf.h"
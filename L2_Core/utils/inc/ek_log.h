@@ -10,6 +10,10 @@
  * - 格式化输出
  *
  * @note 使用前需实现 _ek_log_get_tick() 函数，用于获取系统时间戳
+ * @note EK_LOG_ASYNC_ENABLE == 1 时文本日志格式化后写入环形缓冲区立即返回，由 _ek_log_async_write()（如 DMA）在后台发送
+ * @note EK_LOG_DEFER_ENABLE == 1 时切换为延迟二进制日志：设备只记录格式串 ID、时间戳和原始参数，
+ *       ek_log_defer_flush() 把记录编码成帧输出，由主机上的 Script/ek_log_decode.py 结合 ELF 还原成文本
+ * @note EK_LOG_PERSIST_ENABLE == 1 时每条日志同时复制进复位后保留的 RAM 区域，热复位后仍可读出崩溃前的日志
  */
 
 #ifndef EK_LOG_H
@@ -46,6 +50,137 @@
 #        define EK_LOG_BUFFER_SIZE (256)
 #    endif /* EK_LOG_BUFFER_SIZE     */
 
+/**
+ * @brief 是否使用延迟二进制日志
+ * @note 1 = EK_LOG_xxx 不在设备上格式化，只把格式串 ID、时间戳和参数写入无锁队列
+ * @note 可以只在某个源文件包含 ek_log.h 之前定义为 1，让该文件（如中断里打日志的驱动）单独使用延迟模式
+ * @note 延迟模式下格式串必须是字符串字面量，参数最多 8 个
+ */
+#    ifndef EK_LOG_DEFER_ENABLE
+#        define EK_LOG_DEFER_ENABLE (0)
+#    endif /* EK_LOG_DEFER_ENABLE */
+
+/**
+ * @brief 单条延迟日志的参数区大小（32 位字）
+ * @note 32 位整数占 1 个字，64 位整数和浮点数占 2 个字，字符串按 1 字节长度 + 内容占用，放不下的部分被截断
+ */
+#    ifndef EK_LOG_DEFER_WORDS
+#        define EK_LOG_DEFER_WORDS (8)
+#    endif /* EK_LOG_DEFER_WORDS */
+
+/**
+ * @brief 延迟日志队列深度（条），必须是 2 的幂
+ */
+#    ifndef EK_LOG_DEFER_DEPTH
+#        define EK_LOG_DEFER_DEPTH (32)
+#    endif /* EK_LOG_DEFER_DEPTH */
+
+/**
+ * @brief 是否异步输出文本日志
+ * @note 1 = 日志格式化到栈上的缓冲区后写入环形缓冲区，调用者不等待串口；
+ *       _ek_log_async_write() 每次取走一段连续数据发送，发送完成后调用 ek_log_async_done()
+ * @note 异步模式下每次调用在栈上占用 EK_LOG_BUFFER_SIZE 字节，不再有丢弃并发日志的锁
+ */
+#    ifndef EK_LOG_ASYNC_ENABLE
+#        define EK_LOG_ASYNC_ENABLE (0)
+#    endif /* EK_LOG_ASYNC_ENABLE */
+
+/**
+ * @brief 异步日志环形缓冲区大小（字节），EK_RINGBUF_SPSC_POW2 == 1 时向上取 2 的幂
+ */
+#    ifndef EK_LOG_ASYNC_SIZE
+#        define EK_LOG_ASYNC_SIZE (1024)
+#    endif /* EK_LOG_ASYNC_SIZE */
+
+#    define EK_LOG_OVERFLOW_DROP     (0) /**< 放不下的日志整条丢弃 */
+#    define EK_LOG_OVERFLOW_TRUNCATE (1) /**< 放不下的日志只保留能放下的开头部分，仍以换行结尾 */
+
+/**
+ * @brief 异步日志缓冲区满时的处理策略
+ * @note 两种策略都会计入 ek_log_dropped()
+ */
+#    ifndef EK_LOG_OVERFLOW_POLICY
+#        define EK_LOG_OVERFLOW_POLICY EK_LOG_OVERFLOW_DROP
+#    endif /* EK_LOG_OVERFLOW_POLICY */
+
+/**
+ * @brief 是否把日志同时写入复位后保留的 RAM 区域（持久化崩溃日志）
+ * @note 1 = 每条日志在记录时原样复制进环形区域：文本模式复制格式化好的一行，延迟模式复制编码好的二进制帧，
+ *       不额外格式化；热复位后用 ek_log_persist_dump() 或 shell 命令 crashlog 读出
+ * @note 区域不被启动代码清零，上电或头部校验失败时由 ek_log_persist_init() 清空
+ */
+#    ifndef EK_LOG_PERSIST_ENABLE
+#        define EK_LOG_PERSIST_ENABLE (0)
+#    endif /* EK_LOG_PERSIST_ENABLE */
+
+/**
+ * @brief 持久化日志数据区大小（字节），写满后覆盖最旧的内容
+ */
+#    ifndef EK_LOG_PERSIST_SIZE
+#        define EK_LOG_PERSIST_SIZE (1024)
+#    endif /* EK_LOG_PERSIST_SIZE */
+
+/**
+ * @brief 持久化日志区域所在的段
+ * @note 默认的 .noinit 由 cmake/ld/ek_generic.ld.in 放在 .bss 之后，也可以改成备份 SRAM 等复位不清零的段
+ */
+#    ifndef EK_LOG_PERSIST_SECTION
+#        define EK_LOG_PERSIST_SECTION ".noinit"
+#    endif /* EK_LOG_PERSIST_SECTION */
+
+#    define EK_LOG_LEVEL_DEBUG (1) /**< 与 ek_log_type_t 的取值相同，供预处理器比较 */
+#    define EK_LOG_LEVEL_INFO  (2)
+#    define EK_LOG_LEVEL_WARN  (3)
+#    define EK_LOG_LEVEL_ERROR (4)
+#    define EK_LOG_LEVEL_OFF   (5)
+
+/**
+ * @brief 编译期日志级别，低于该级别的 EK_LOG_xxx 整条删除，参数和时间戳都不求值
+ * @note 可以在源文件包含 ek_log.h 之前单独定义；EK_LOG 普通输出不受影响
+ */
+#    ifndef EK_LOG_LEVEL
+#        if EK_LOG_DEBUG_ENABLE == 1
+#            define EK_LOG_LEVEL EK_LOG_LEVEL_DEBUG
+#        else
+#            define EK_LOG_LEVEL EK_LOG_LEVEL_INFO
+#        endif
+#    endif /* EK_LOG_LEVEL */
+
+/**
+ * @brief 是否支持按标签在运行时调整日志级别
+ * @note 1 = 每个 EK_LOG_FILE_TAG 在 ek_log_tag 段定义一个标签对象，初始级别为该文件的 EK_LOG_LEVEL，
+ *       日志宏先比较标签级别，未通过时不求值参数
+ * @note 默认关闭。打开前需在链接脚本 (.ld) 的 .data 段内添加 ek_log_tag 段及其起止符号，
+ *       否则它成为孤立段，启动代码不会为它复制初始值：
+ * @code
+ * .data :
+ * {
+ *     ...
+ *     . = ALIGN(4);
+ *     __start_ek_log_tag = .;
+ *     KEEP(*(ek_log_tag))
+ *     __stop_ek_log_tag = .;
+ *     . = ALIGN(4);
+ * } > RAM AT > FLASH
+ * @endcode
+ * @note cmake/ld/ek_generic.ld.in 已包含上述内容；armlink 不生成 __start/__stop 符号，Keil 工程保持关闭
+ */
+#    ifndef EK_LOG_TAG_LEVEL_ENABLE
+#        define EK_LOG_TAG_LEVEL_ENABLE (0)
+#    endif /* EK_LOG_TAG_LEVEL_ENABLE */
+
+#    if EK_LOG_ASYNC_ENABLE == 1 && EK_RINGBUF_SPSC_ENABLE != 1
+#        error "EK_LOG_ASYNC_ENABLE requires EK_RINGBUF_SPSC_ENABLE"
+#    endif
+
+#    if EK_LOG_DEFER_WORDS > 60
+#        error "EK_LOG_DEFER_WORDS must not exceed 60, one frame length byte covers the record"
+#    endif
+
+#    if EK_LOG_DEFER_ENABLE == 1 && EK_RINGBUF_MPMC_ENABLE != 1
+#        error "EK_LOG_DEFER_ENABLE requires EK_RINGBUF_MPMC_ENABLE"
+#    endif
+
 /**
  * @brief 定义文件标签
  * @param tag 标签字符串
@@ -53,7 +188,18 @@
  * @example
  * EK_LOG_FILE_TAG("main.c");
  */
-#    define EK_LOG_FILE_TAG(tag) static const char *_EK_LOG_TAG_ = (tag);
+#    define EK_LOG_FILE_TAG(tag) \
+        _EK_LOG_TAG_DEFINE(tag)  \
+        static const char *_EK_LOG_TAG_ __attribute__((unused)) = (tag);
+
+#    if EK_LOG_TAG_LEVEL_ENABLE == 1
+#        define _EK_LOG_TAG_DEFINE(tag) \
+            static ek_log_tag_t _ek_log_tag_ __EK_USED __EK_SECTION("ek_log_tag") = { (tag), EK_LOG_LEVEL };
+#        define _EK_LOG_ON(type) ((uint8_t)(type) >= _ek_log_tag_.level)
+#    else
+#        define _EK_LOG_TAG_DEFINE(tag)
+#        define _EK_LOG_ON(type) (true)
+#    endif /* EK_LOG_TAG_LEVEL_ENABLE == 1 */
 
 /**
  * @brief 定义获取时间戳函数
@@ -80,6 +226,59 @@ typedef enum
     EK_LOG_TYPE_MAX = 5, /**< 最大级别数 */
 } ek_log_type_t;
 
+/**
+ * @brief 文件标签，由 EK_LOG_FILE_TAG 定义
+ */
+typedef struct
+{
+    const char *name; /**< 标签字符串 */
+    volatile uint8_t level; /**< 运行时级别，低于它的日志不输出，EK_LOG_TYPE_MAX 表示全部关闭 */
+} ek_log_tag_t;
+
+/**
+ * @brief 延迟日志参数类型，帧中每个参数占 2 位
+ */
+typedef enum
+{
+    EK_LOG_ARG_U32 = 0, /**< 32 位整数（含 char、short、int 和 32 位指针） */
+    EK_LOG_ARG_U64, /**< 64 位整数（含 long long、64 位平台上的 long 和指针） */
+    EK_LOG_ARG_F64, /**< 浮点数，float 按 double 保存 */
+    EK_LOG_ARG_STR, /**< 字符串，内容被复制进记录 */
+} ek_log_arg_type_t;
+
+/**
+ * @brief 延迟日志的一个参数（内部使用）
+ */
+typedef struct
+{
+    uint8_t type; /**< ek_log_arg_type_t */
+    union
+    {
+        uint32_t u32;
+        uint64_t u64;
+        double f64;
+        const char *str;
+    };
+} ek_log_arg_t;
+
+#    define EK_LOG_PERSIST_MAGIC (0x474C4B45U) /**< 小端存储为 "EKLG" */
+#    define EK_LOG_PERSIST_FULL  (0x80000000U) /**< head 的最高位：数据区已经写满一圈 */
+
+/**
+ * @brief 持久化日志区域
+ * @note magic、size、resets 由 crc 校验，只在打开和清空时更新；写日志时只复制数据并更新 head / head_inv
+ */
+typedef struct
+{
+    uint32_t magic; /**< EK_LOG_PERSIST_MAGIC */
+    uint32_t size; /**< 数据区大小，与 EK_LOG_PERSIST_SIZE 不同时视为无效 */
+    uint32_t resets; /**< 内容经历的复位次数 */
+    uint32_t crc; /**< 以上三个字段的 CRC32 */
+    volatile uint32_t head; /**< 低 31 位为下一次写入的位置，EK_LOG_PERSIST_FULL 表示已写满一圈 */
+    volatile uint32_t head_inv; /**< head 取反，用于识别被复位打断的更新 */
+    uint8_t data[EK_LOG_PERSIST_SIZE]; /**< 环形数据区 */
+} ek_log_persist_t;
+
 #    ifdef __cplusplus
 extern "C"
 {
@@ -103,40 +302,342 @@ void _ek_log_printf(const char *tag, uint32_t line, ek_log_type_t type, uint32_t
 uint32_t _ek_log_get_tick(void);
 
 /**
- * @brief DEBUG 级别日志
- * @param ... 格式化字符串和参数
- * @note 仅在 EK_LOG_DEBUG_ENABLE == 1 时有效
+ * @brief 被丢弃的日志条数
+ * @param type 日志级别
+ * @return 该级别因并发输出（同步模式）或缓冲区满（异步模式）而丢弃或截断的日志条数
  */
-#    if (EK_LOG_DEBUG_ENABLE == 1)
-#        define EK_LOG_DEBUG(...) \
-            _ek_log_printf(_EK_LOG_TAG_, __LINE__, EK_LOG_TYPE_DEBUG, _ek_log_get_tick(), __VA_ARGS__)
-#    else
-#        define EK_LOG_DEBUG(...)
-#    endif
+uint32_t ek_log_dropped(ek_log_type_t type);
+
+#    if EK_LOG_TAG_LEVEL_ENABLE == 1
+/**
+ * @brief 设置标签的运行时级别
+ * @param tag 标签字符串，NULL 或 "*" 表示所有标签
+ * @param level 最低输出级别，EK_LOG_TYPE_MAX 表示关闭
+ * @return 匹配的标签数量，多个文件可以使用同一个标签
+ *
+ * @note 只能放宽到编译期的 EK_LOG_LEVEL，被编译期删除的日志不会恢复
+ */
+uint32_t ek_log_set_level(const char *tag, ek_log_type_t level);
+
+/**
+ * @brief 获取标签的运行时级别
+ * @param tag 标签字符串
+ * @return 第一个匹配标签的级别；标签不存在时返回 EK_LOG_TYPE_NONE
+ */
+ek_log_type_t ek_log_get_level(const char *tag);
+
+/**
+ * @brief 打印所有标签及其级别
+ */
+void ek_log_level_dump(void);
+#    endif /* EK_LOG_TAG_LEVEL_ENABLE == 1 */
+
+/**
+ * @brief 进入临界区（弱函数，默认空实现）
+ * @note 异步模式下多个上下文（主循环、中断、线程）同时打日志时需要提供关中断或加锁的强定义
+ */
+void ek_log_enter_critical(void);
+
+/**
+ * @brief 退出临界区（弱函数，默认空实现）
+ */
+void ek_log_exit_critical(void);
+
+#    if EK_LOG_ASYNC_ENABLE == 1
+/**
+ * @brief 发送一段异步日志数据（弱函数）
+ * @param data 环形缓冲区中的连续数据，发送完成前保持有效
+ * @param len 数据长度（字节）
+ * @return true 已开始发送，完成后必须调用 ek_log_async_done()；false 外设忙，稍后由 ek_log_async_poll() 重试
+ *
+ * @note 默认实现通过 _ek_io_write() 同步发送，并在返回前调用 ek_log_async_done()
+ * @example
+ * EK_LOG_ASYNC_WRITE()
+ * {
+ *     return ek_hal_uart_write_dma(uart1, (uint8_t *)data, len);
+ * }
+ * // 串口 DMA 发送完成中断中：ek_log_async_done();
+ */
+bool _ek_log_async_write(const uint8_t *data, uint32_t len);
+
+/**
+ * @brief 定义异步日志发送函数
+ */
+#        define EK_LOG_ASYNC_WRITE() bool _ek_log_async_write(const uint8_t *data, uint32_t len)
+
+/**
+ * @brief 上一段异步日志发送完成，释放空间并立即开始发送下一段
+ * @note 通常在 DMA 发送完成中断中调用
+ */
+void ek_log_async_done(void);
+
+/**
+ * @brief 空闲时开始发送缓冲区中的数据
+ * @note 日志写入后会自动尝试发送，只有 _ek_log_async_write() 返回 false 后才需要周期性调用
+ */
+void ek_log_async_poll(void);
+
+/**
+ * @brief 等待发送的字节数（含正在发送的一段）
+ */
+uint32_t ek_log_async_pending(void);
+#    endif /* EK_LOG_ASYNC_ENABLE == 1 */
+
+#    if EK_LOG_PERSIST_ENABLE == 1
+/**
+ * @brief 打开持久化日志区域
+ * @return true 头部校验通过，保留了复位前的日志；false 上电或区域损坏，已清空
+ * @note 在系统启动早期调用一次，调用之前的日志不写入区域
+ */
+bool ek_log_persist_init(void);
+
+/**
+ * @brief 清空持久化日志，之后的日志从头记录
+ */
+void ek_log_persist_clear(void);
+
+/**
+ * @brief 区域中保存的字节数
+ */
+uint32_t ek_log_persist_used(void);
+
+/**
+ * @brief 区域内容经历的复位次数，清空时归零
+ */
+uint32_t ek_log_persist_resets(void);
+
+/**
+ * @brief 按从旧到新的顺序复制持久化日志
+ * @param offset 从最旧的字节算起的偏移
+ * @param buf 目标缓冲区
+ * @param len 最多复制的字节数
+ * @return 实际复制的字节数
+ */
+uint32_t ek_log_persist_read(uint32_t offset, uint8_t *buf, uint32_t len);
+
+/**
+ * @brief 通过 _ek_io_write() 从旧到新输出持久化日志
+ * @note 直接输出区域中的数据，输出期间新写入的日志可能覆盖还没发出的最旧内容；
+ *       延迟模式下输出的是二进制帧，采集后用 Script/ek_log_decode.py 还原
+ */
+void ek_log_persist_dump(void);
+#    endif /* EK_LOG_PERSIST_ENABLE == 1 */
+
+/**
+ * @brief 初始化延迟日志队列
+ * @note 使用延迟模式时在系统启动早期调用一次；队列只在链接到延迟日志时占用内存
+ * @note 初始化之前记录的日志被丢弃并计入 ek_log_defer_dropped()
+ */
+void ek_log_defer_init(void);
+
+/**
+ * @brief 把队列中的延迟日志编码成帧，通过 _ek_log_defer_write() 输出
+ * @return 输出的记录条数
+ *
+ * @note 帧格式（小端）：0xA5, len, id(4), tick(4), types(2), amount(1), data(len - 11)
+ * @note 只能在一个上下文中调用，通常放在主循环空闲时
+ */
+uint32_t ek_log_defer_flush(void);
+
+/**
+ * @brief 队列满或未初始化而丢弃的延迟日志条数
+ */
+uint32_t ek_log_defer_dropped(void);
+
+/**
+ * @brief 输出一段编码好的延迟日志帧（弱定义，默认调用 _ek_io_write()）
+ * @param data 帧数据
+ * @param len 帧长度（字节）
+ * @note 可以重新实现为 DMA 发送、写入文件系统等
+ */
+void _ek_log_defer_write(const uint8_t *data, uint32_t len);
+
+/**
+ * @brief 定义延迟日志帧输出函数
+ * @example
+ * EK_LOG_DEFER_WRITE()
+ * {
+ *     HAL_UART_Transmit(&huart1, data, len, 100);
+ * }
+ */
+#    define EK_LOG_DEFER_WRITE() void _ek_log_defer_write(const uint8_t *data, uint32_t len)
+
+/**
+ * @brief 写入一条延迟日志（内部使用）
+ * @param fmt ek_log_fmt 段中的格式描述串
+ * @param tick 时间戳
+ * @param args 参数数组
+ * @param amount 参数个数
+ */
+void _ek_log_defer(const char *fmt, uint32_t tick, const ek_log_arg_t *args, uint32_t amount);
+
+#    if EK_LOG_DEFER_ENABLE == 1
+
+__EK_STATIC_INLINE ek_log_arg_t _ek_log_arg_u32(uint32_t v)
+{
+    ek_log_arg_t arg = { .type = EK_LOG_ARG_U32, .u32 = v };
+    return arg;
+}
+
+__EK_STATIC_INLINE ek_log_arg_t _ek_log_arg_u64(uint64_t v)
+{
+    ek_log_arg_t arg = { .type = EK_LOG_ARG_U64, .u64 = v };
+    return arg;
+}
+
+__EK_STATIC_INLINE ek_log_arg_t _ek_log_arg_f64(double v)
+{
+    ek_log_arg_t arg = { .type = EK_LOG_ARG_F64, .f64 = v };
+    return arg;
+}
+
+__EK_STATIC_INLINE ek_log_arg_t _ek_log_arg_str(const char *v)
+{
+    ek_log_arg_t arg = { .type = EK_LOG_ARG_STR, .str = v };
+    return arg;
+}
+
+__EK_STATIC_INLINE ek_log_arg_t _ek_log_arg_ptr(const void *v)
+{
+    ek_log_arg_t arg;
+    if (sizeof(void *) > sizeof(uint32_t)) arg = _ek_log_arg_u64((uint64_t)(uintptr_t)v);
+    else arg = _ek_log_arg_u32((uint32_t)(uintptr_t)v);
+    return arg;
+}
+
+/*
+ * 按参数的静态类型选择保存方式：不超过 int 的整数（含枚举）保存为 32 位，long / long long 保存为 64 位，
+ * 其余类型都按指针保存地址，宽度与平台指针相同，%p 的参数不需要先转换成 void *；
+ * 结构体等不能转换成指针的参数在编译时报错，而不是被截断
+ */
+#        define _EK_LOG_ARG(x)                       \
+            _Generic((x),                            \
+                _Bool: _ek_log_arg_u32,              \
+                char: _ek_log_arg_u32,               \
+                signed char: _ek_log_arg_u32,        \
+                unsigned char: _ek_log_arg_u32,      \
+                short: _ek_log_arg_u32,              \
+                unsigned short: _ek_log_arg_u32,     \
+                int: _ek_log_arg_u32,                \
+                unsigned int: _ek_log_arg_u32,       \
+                float: _ek_log_arg_f64,              \
+                double: _ek_log_arg_f64,             \
+                long double: _ek_log_arg_f64,        \
+                char *: _ek_log_arg_str,             \
+                const char *: _ek_log_arg_str,       \
+                long: _ek_log_arg_u64,               \
+                unsigned long: _ek_log_arg_u64,      \
+                long long: _ek_log_arg_u64,          \
+                unsigned long long: _ek_log_arg_u64, \
+                default: _ek_log_arg_ptr)(x)
+
+#        define _EK_LOG_STR_HELPER(x) #x
+#        define _EK_LOG_STR(x)        _EK_LOG_STR_HELPER(x)
+#        define _EK_LOG_CAT_HELPER(a, b) a##b
+#        define _EK_LOG_CAT(a, b)        _EK_LOG_CAT_HELPER(a, b)
+
+#        define _EK_LOG_FMT(...)       _EK_LOG_FMT_HELPER(__VA_ARGS__, ~)
+#        define _EK_LOG_FMT_HELPER(fmt, ...) fmt
+
+/* 格式串之后的参数个数，0 ~ 8 */
+#        define _EK_LOG_NARGS(...) _EK_LOG_NARGS_HELPER(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0, ~)
+#        define _EK_LOG_NARGS_HELPER(f, a1, a2, a3, a4, a5, a6, a7, a8, n, ...) n
+
+#        define _EK_LOG_PACK_0(f)
+#        define _EK_LOG_PACK_1(f, a)      , _EK_LOG_ARG(a)
+#        define _EK_LOG_PACK_2(f, a, ...) , _EK_LOG_ARG(a) _EK_LOG_PACK_1(f, __VA_ARGS__)
+#        define _EK_LOG_PACK_3(f, a, ...) , _EK_LOG_ARG(a) _EK_LOG_PACK_2(f, __VA_ARGS__)
+#        define _EK_LOG_PACK_4(f, a, ...) , _EK_LOG_ARG(a) _EK_LOG_PACK_3(f, __VA_ARGS__)
+#        define _EK_LOG_PACK_5(f, a, ...) , _EK_LOG_ARG(a) _EK_LOG_PACK_4(f, __VA_ARGS__)
+#        define _EK_LOG_PACK_6(f, a, ...) , _EK_LOG_ARG(a) _EK_LOG_PACK_5(f, __VA_ARGS__)
+#        define _EK_LOG_PACK_7(f, a, ...) , _EK_LOG_ARG(a) _EK_LOG_PACK_6(f, __VA_ARGS__)
+#        define _EK_LOG_PACK_8(f, a, ...) , _EK_LOG_ARG(a) _EK_LOG_PACK_7(f, __VA_ARGS__)
+#        define _EK_LOG_PACK(...)         _EK_LOG_CAT(_EK_LOG_PACK_, _EK_LOG_NARGS(__VA_ARGS__))(__VA_ARGS__)
+
+/**
+ * @brief 记录一条延迟日志（内部使用）
+ * @param letter 级别字母：N D I W E
+ * @note 格式描述串 "级别\x1f行号\x1f文件\x1f格式串" 放在 ek_log_fmt 段，记录中只保存它相对段首的偏移
+ */
+#        define _EK_LOG_RECORD(letter, ...)                                                                 \
+            do                                                                                              \
+            {                                                                                               \
+                static const char _ek_log_fmt_[] __EK_USED __EK_SECTION("ek_log_fmt") =                     \
+                    letter "\x1f" _EK_LOG_STR(__LINE__) "\x1f" __FILE__ "\x1f" _EK_LOG_FMT(__VA_ARGS__);    \
+                const ek_log_arg_t _ek_log_args_[] = { { 0 } _EK_LOG_PACK(__VA_ARGS__) };                   \
+                _ek_log_defer(_ek_log_fmt_,                                                                 \
+                              _ek_log_get_tick(),                                                           \
+                              &_ek_log_args_[1],                                                            \
+                              sizeof(_ek_log_args_) / sizeof(_ek_log_args_[0]) - 1U);                       \
+            } while (0)
+
+#        define _EK_LOG_OUT(type, letter, ...)                             \
+            do                                                             \
+            {                                                              \
+                if (_EK_LOG_ON(type)) _EK_LOG_RECORD(letter, __VA_ARGS__); \
+            } while (0)
+
+#        define EK_LOG(...) _EK_LOG_RECORD("N", __VA_ARGS__)
+
+#    else /* EK_LOG_DEFER_ENABLE == 1 */
+
+/* 先比较标签的运行时级别，再求值参数和时间戳 */
+#        define _EK_LOG_OUT(type, letter, ...)                                                     \
+            do                                                                                     \
+            {                                                                                      \
+                if (_EK_LOG_ON(type))                                                              \
+                    _ek_log_printf(_EK_LOG_TAG_, __LINE__, type, _ek_log_get_tick(), __VA_ARGS__); \
+            } while (0)
 
 /**
  * @brief 普通日志（无级别标识）
  * @param ... 格式化字符串和参数
+ * @note 不受 EK_LOG_LEVEL 和标签级别限制
  */
-#    define EK_LOG(...) _ek_log_printf(_EK_LOG_TAG_, __LINE__, EK_LOG_TYPE_NONE, _ek_log_get_tick(), __VA_ARGS__)
+#        define EK_LOG(...) _ek_log_printf(_EK_LOG_TAG_, __LINE__, EK_LOG_TYPE_NONE, _ek_log_get_tick(), __VA_ARGS__)
+
+#    endif /* EK_LOG_DEFER_ENABLE == 1 */
+
+/**
+ * @brief DEBUG 级别日志
+ * @param ... 格式化字符串和参数
+ * @note 仅在 EK_LOG_DEBUG_ENABLE == 1 且 EK_LOG_LEVEL <= EK_LOG_LEVEL_DEBUG 时有效
+ */
+#    if (EK_LOG_DEBUG_ENABLE == 1) && (EK_LOG_LEVEL <= EK_LOG_LEVEL_DEBUG)
+#        define EK_LOG_DEBUG(...) _EK_LOG_OUT(EK_LOG_TYPE_DEBUG, "D", __VA_ARGS__)
+#    else
+#        define EK_LOG_DEBUG(...) ((void)0)
+#    endif
 
 /**
  * @brief INFO 级别日志
  * @param ... 格式化字符串和参数
  */
-#    define EK_LOG_INFO(...) _ek_log_printf(_EK_LOG_TAG_, __LINE__, EK_LOG_TYPE_INFO, _ek_log_get_tick(), __VA_ARGS__)
+#    if EK_LOG_LEVEL <= EK_LOG_LEVEL_INFO
+#        define EK_LOG_INFO(...) _EK_LOG_OUT(EK_LOG_TYPE_INFO, "I", __VA_ARGS__)
+#    else
+#        define EK_LOG_INFO(...) ((void)0)
+#    endif
 
 /**
  * @brief WARN 级别日志
  * @param ... 格式化字符串和参数
  */
-#    define EK_LOG_WARN(...) _ek_log_printf(_EK_LOG_TAG_, __LINE__, EK_LOG_TYPE_WARN, _ek_log_get_tick(), __VA_ARGS__)
+#    if EK_LOG_LEVEL <= EK_LOG_LEVEL_WARN
+#        define EK_LOG_WARN(...) _EK_LOG_OUT(EK_LOG_TYPE_WARN, "W", __VA_ARGS__)
+#    else
+#        define EK_LOG_WARN(...) ((void)0)
+#    endif
 
 /**
  * @brief ERROR 级别日志
  * @param ... 格式化字符串和参数
  */
-#    define EK_LOG_ERROR(...) _ek_log_printf(_EK_LOG_TAG_, __LINE__, EK_LOG_TYPE_ERROR, _ek_log_get_tick(), __VA_ARGS__)
+#    if EK_LOG_LEVEL <= EK_LOG_LEVEL_ERROR
+#        define EK_LOG_ERROR(...) _EK_LOG_OUT(EK_LOG_TYPE_ERROR, "E", __VA_ARGS__)
+#    else
+#        define EK_LOG_ERROR(...) ((void)0)
+#    endif
 
 #    ifdef __cplusplus
 }
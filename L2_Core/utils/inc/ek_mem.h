@@ -20,6 +20,42 @@
 #    define EK_HEAP_SIZE (10 * 1024)
 #endif
 
+#ifndef EK_HEAP_REGION_ENABLE
+#    define EK_HEAP_REGION_ENABLE 0 /* 默认只使用单一的默认堆 */
+#endif
+
+#ifndef EK_HEAP_REGION_STUB
+#    define EK_HEAP_REGION_STUB 0 /* 1 = 主机测试时用普通数组代替链接脚本给出的区域 */
+#endif
+
+#ifndef EK_HEAP_THREAD_SAFE
+#    define EK_HEAP_THREAD_SAFE EK_USE_RTOS /* 1 = 分配/释放在 ek_mem_enter_critical()/ek_mem_exit_critical() 内完成 */
+#endif
+
+#ifndef EK_HEAP_CACHE_ENABLE
+#    define EK_HEAP_CACHE_ENABLE EK_USE_RTOS /* 1 = 使能每任务小块缓存，命中时不进入临界区 */
+#endif
+
+#ifndef EK_HEAP_CACHE_MIN_SIZE
+#    define EK_HEAP_CACHE_MIN_SIZE 16 /* 缓存最小分级的块大小（字节），第 i 级为 EK_HEAP_CACHE_MIN_SIZE << i */
+#endif
+
+#ifndef EK_HEAP_CACHE_CLASSES
+#    define EK_HEAP_CACHE_CLASSES 4 /* 缓存的分级数，默认 16/32/64/128 字节 */
+#endif
+
+#ifndef EK_HEAP_CACHE_DEPTH
+#    define EK_HEAP_CACHE_DEPTH 4 /* 每个分级最多缓存的块数 */
+#endif
+
+#ifndef EK_HEAP_TRACE
+#    define EK_HEAP_TRACE 0 /* 1 = 记录每个存活分配的调用点、大小和时间戳 */
+#endif
+
+#ifndef EK_HEAP_TRACE_DEPTH
+#    define EK_HEAP_TRACE_DEPTH 128 /* 追踪表容量（可同时记录的存活分配数），必须是 2 的幂 */
+#endif
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -31,9 +67,39 @@ extern "C"
  *         需要用户自行实现这三个函数的强定义版本
  * @warning 这些函数采用弱定义方式，用户可以覆盖默认实现
  */
-void *_ek_malloc(size_t size);
+__EK_NOINLINE void *_ek_malloc(size_t size);
 void _ek_free(void *ptr);
-void *_ek_realloc(void *ptr, size_t size);
+__EK_NOINLINE void *_ek_realloc(void *ptr, size_t size);
+
+#if EK_HEAP_TRACE == 1
+/*
+ * 追踪模式下 _ek_malloc/_ek_realloc 用返回地址作为调用点，它们本身不能被内联，
+ * 调用者中的调用也不能被优化成尾调用（否则记录到的是上一层的地址）。
+ * 这里的包装函数内联到调用者中，调用之后的屏障保证返回地址落在调用者的函数体内
+ */
+__EK_ALWAYS_INLINE void *_ek_malloc_traced(size_t size)
+{
+    void *ptr = _ek_malloc(size);
+    __EK_NO_TAIL_CALL();
+    return ptr;
+}
+
+__EK_ALWAYS_INLINE void *_ek_realloc_traced(void *ptr, size_t size)
+{
+    void *new_ptr = _ek_realloc(ptr, size);
+    __EK_NO_TAIL_CALL();
+    return new_ptr;
+}
+#endif /* EK_HEAP_TRACE */
+
+/**
+ * @brief  内存管理临界区（弱定义）
+ * @note   默认为空实现；在中断或多任务中分配/释放内存块池，或使能 EK_HEAP_THREAD_SAFE 时，
+ *         用户需要提供关中断或加锁的强定义版本（需要支持嵌套）
+ * @note   EK_USE_RTOS 为 1 时由 L3_Middlewares/FreeRTOS/mem/heap_ek.c 提供
+ */
+void ek_mem_enter_critical(void);
+void ek_mem_exit_critical(void);
 
 /**
  * @brief  从默认内存堆分配内存
@@ -41,7 +107,11 @@ void *_ek_realloc(void *ptr, size_t size);
  * @retval 分配的内存指针，失败返回 NULL
  */
 #ifndef ek_malloc
-#    define ek_malloc(size) _ek_malloc((size))
+#    if EK_HEAP_TRACE == 1
+#        define ek_malloc(size) _ek_malloc_traced((size))
+#    else
+#        define ek_malloc(size) _ek_malloc((size))
+#    endif
 #endif
 
 /**
@@ -51,7 +121,11 @@ void *_ek_realloc(void *ptr, size_t size);
  * @retval 重新分配后的内存指针，失败返回 NULL
  */
 #ifndef ek_realloc
-#    define ek_realloc(ptr, size) _ek_realloc((ptr), (size))
+#    if EK_HEAP_TRACE == 1
+#        define ek_realloc(ptr, size) _ek_realloc_traced((ptr), (size))
+#    else
+#        define ek_realloc(ptr, size) _ek_realloc((ptr), (size))
+#    endif
 #endif
 
 /**
@@ -68,6 +142,55 @@ void *_ek_realloc(void *ptr, size_t size);
         } while (0)
 #endif
 
+/**
+ * @brief  分配器接口
+ * @note   ek_str/ek_vec 等容器通过它选择内存来源（默认堆、ek_arena 等），
+ *         传 NULL 表示使用默认堆（ek_malloc/ek_realloc/ek_free）
+ */
+typedef struct ek_allocator_t ek_allocator_t;
+
+struct ek_allocator_t
+{
+    /**
+     * @brief  分配、调整或释放一块内存
+     * @param  ctx: 分配器上下文
+     * @param  ptr: 原内存指针，NULL 表示新分配
+     * @param  old_size: 原内存大小（字节），ptr 为 NULL 时为 0
+     * @param  new_size: 新的内存大小（字节），0 表示释放
+     * @retval 新的内存指针，释放或失败时返回 NULL
+     */
+    void *(*realloc)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+    void *ctx; /**< 分配器上下文 */
+};
+
+/**
+ * @brief  通过分配器调整内存大小
+ * @param  alloc: 分配器，NULL 表示默认堆
+ * @param  ptr: 原内存指针，NULL 表示新分配
+ * @param  old_size: 原内存大小（字节）
+ * @param  new_size: 新的内存大小（字节）
+ * @retval 新的内存指针，失败返回 NULL
+ * @note   总是内联，EK_HEAP_TRACE 记录到的调用点是使用它的函数（ek_str 函数或展开 ek_vec 宏的位置）
+ */
+__EK_ALWAYS_INLINE void *ek_allocator_realloc(const ek_allocator_t *alloc, void *ptr, size_t old_size, size_t new_size)
+{
+    if (alloc == NULL) return ek_realloc(ptr, new_size);
+    return alloc->realloc(alloc->ctx, ptr, old_size, new_size);
+}
+
+/**
+ * @brief  通过分配器释放内存
+ * @param  alloc: 分配器，NULL 表示默认堆
+ * @param  ptr: 内存指针
+ * @param  size: 内存大小（字节）
+ */
+__EK_STATIC_INLINE void ek_allocator_free(const ek_allocator_t *alloc, void *ptr, size_t size)
+{
+    if (ptr == NULL) return;
+    if (alloc == NULL) _ek_free(ptr);
+    else alloc->realloc(alloc->ctx, ptr, size, 0);
+}
+
 #if EK_HEAP_NO_TLSF == 0
 
 #    include "../../third_party/tlsf/tlsf.h"
@@ -120,18 +243,246 @@ extern tlsf_t ek_default_tlsf;
 #        define ek_heap_remove_pool(pool) tlsf_remove_pool(ek_default_tlsf, (pool))
 #    endif
 
+/**
+ * @brief  堆统计信息
+ * @note   除 largest_free 外都是在 _ek_malloc/_ek_free/_ek_realloc 中维护的运行计数
+ */
+typedef struct
+{
+    size_t total; /**< 可分配的总字节数 */
+    size_t used; /**< 已分配的字节数（按 TLSF 内部块大小计） */
+    size_t peak; /**< used 的历史最大值 */
+    size_t largest_free; /**< 保证能成功分配的最大请求（字节） */
+    uint32_t alloc_count; /**< 成功分配次数（累计） */
+    uint32_t free_count; /**< 释放次数（累计） */
+    uint32_t failed_count; /**< 分配失败次数（累计） */
+} ek_heap_stats_t;
+
+/**
+ * @brief  获取默认堆的统计信息
+ * @param  stats: 输出的统计信息
+ * @note   复杂度 O(1)，不遍历内存块，可以周期性调用
+ * @note   largest_free 取自 TLSF 位图中最高的非空分级的下界，实际最大空闲块
+ *         可能比它大不到一个二级分档（1/8），但超过它的请求不保证成功
+ */
+void ek_heap_stats(ek_heap_stats_t *stats);
+
 /**
  * @brief  获取当前空闲内存大小
  * @retval 空闲字节数
+ * @note   复杂度 O(1)；空闲块自身的块头没有扣除，因此比逐块统计的结果略大
  */
 size_t ek_heap_unused(void);
 
 /**
  * @brief  获取当前已使用的内存大小
  * @retval 使用的字节数
+ * @note   复杂度 O(1)
  */
 size_t ek_heap_used(void);
 
+/**
+ * @brief  统计默认堆各个 TLSF 一级分级中的空闲块数量（碎片直方图）
+ * @param  counts: 输出数组，counts[i] 为第 i 级的空闲块数量
+ * @param  classes: 数组长度
+ * @retval 实际填入的分级数
+ * @note   第 i 级的块大小范围是 [ek_heap_frag_class_size(i), ek_heap_frag_class_size(i + 1))；
+ *         只遍历空闲链表，复杂度与空闲块数量成正比
+ */
+uint32_t ek_heap_frag_histogram(uint32_t counts[], uint32_t classes);
+
+/**
+ * @brief  获取 TLSF 一级分级的块大小下界
+ * @param  cls: 分级序号
+ * @retval 该分级的最小块大小（字节）
+ */
+size_t ek_heap_frag_class_size(uint32_t cls);
+
+/**
+ * @brief  打印默认堆的统计信息、碎片直方图和（EK_HEAP_TRACE 时）按调用点分组的存活分配
+ * @note   使能 Shell 时导出为 heap 命令；调用点地址可用 addr2line -e <elf> 解析
+ */
+void ek_heap_dump(void);
+
+#    if EK_HEAP_TRACE == 1
+
+/**
+ * @brief  单个存活分配的追踪记录
+ */
+typedef struct
+{
+    void *ptr; /**< 分配得到的地址，NULL 表示空槽 */
+    void *caller; /**< 调用 ek_malloc/ek_realloc 的返回地址 */
+    uint32_t size; /**< 请求的字节数 */
+    uint32_t tick; /**< 分配时的时间戳 */
+} ek_heap_trace_rec_t;
+
+/**
+ * @brief  按调用点汇总的存活分配
+ */
+typedef struct
+{
+    void *caller; /**< 调用点的返回地址 */
+    uint32_t count; /**< 该调用点存活的分配数 */
+    size_t bytes; /**< 该调用点存活的请求字节数之和 */
+    uint32_t oldest_tick; /**< 最早一次仍存活的分配的时间戳 */
+} ek_heap_trace_site_t;
+
+/**
+ * @brief  获取分配追踪的时间戳（弱定义）
+ * @retval 当前时间戳
+ * @note   默认使用日志模块的 _ek_log_get_tick()，未使能日志时返回 0
+ */
+uint32_t ek_heap_trace_get_tick(void);
+
+/**
+ * @brief  按调用点汇总当前存活的分配，按字节数从大到小排序
+ * @param  sites: 输出数组
+ * @param  max: 数组长度，调用点多于此数时只保留先遇到的 max 个
+ * @retval 填入的调用点数量
+ * @note   追踪表是以地址为键的开放寻址哈希表，分配/释放时的记录和删除平均为 O(1)，
+ *         表大小为 EK_HEAP_TRACE_DEPTH * sizeof(ek_heap_trace_rec_t)
+ */
+uint32_t ek_heap_trace_report(ek_heap_trace_site_t *sites, uint32_t max);
+
+/**
+ * @brief  获取当前追踪的存活分配数量
+ * @retval 存活分配数量
+ */
+uint32_t ek_heap_trace_live(void);
+
+/**
+ * @brief  获取因追踪表已满而没有记录的分配次数（累计）
+ * @retval 丢失的记录数，非 0 时应增大 EK_HEAP_TRACE_DEPTH
+ */
+uint32_t ek_heap_trace_lost(void);
+
+#    endif /* EK_HEAP_TRACE */
+
+#    if EK_HEAP_CACHE_ENABLE == 1
+
+/**
+ * @brief  每任务小块缓存
+ * @note   每个任务各自持有一个，只能被所属任务访问；中断中没有缓存，直接走带锁的路径
+ * @note   缓存中的块对 TLSF 来说仍是已分配状态，在统计中计为已用
+ */
+typedef struct
+{
+    void *head[EK_HEAP_CACHE_CLASSES]; /**< 各分级的空闲块链表，链接指针存放在块内 */
+    uint8_t count[EK_HEAP_CACHE_CLASSES]; /**< 各分级缓存的块数 */
+    uint32_t hits; /**< 命中次数 */
+    uint32_t misses; /**< 未命中次数 */
+} ek_heap_cache_t;
+
+/**
+ * @brief  获取当前任务的缓存（弱定义）
+ * @retval 当前任务的缓存，没有缓存或在中断中时返回 NULL
+ * @note   默认返回 NULL（不使用缓存）；FreeRTOS 下由 heap_ek.c 通过线程本地存储指针实现
+ */
+ek_heap_cache_t *ek_mem_task_cache(void);
+
+/**
+ * @brief  把缓存中的块全部归还给堆
+ * @param  cache: 缓存
+ * @note   任务删除前或需要整理碎片时调用
+ */
+void ek_heap_cache_flush(ek_heap_cache_t *cache);
+
+#    endif /* EK_HEAP_CACHE_ENABLE */
+
+#    if EK_HEAP_REGION_ENABLE == 1
+
+/**
+ * @brief  单个命名堆最多包含的内存池数量
+ */
+#        define EK_HEAP_REGION_MAX_POOLS (2)
+
+/**
+ * @brief  命名堆（按内存区域划分）
+ * @note   区域范围来自链接脚本导出的符号：
+ *         - ek_heap_fast: CCM-RAM 中 .ccmram 段之后的剩余空间（_ek_heap_fast_start/_end），零等待，DMA 不可访问
+ *         - ek_heap_dma:  默认堆 ek_default_heap（主 SRAM），DMA 可访问
+ *         - ek_heap_bulk: SDRAM1/SDRAM2 中数据段之后的剩余空间（_ek_heap_bulk_start/_end、_ek_heap_bulk2_start/_end）
+ * @note   链接脚本中不存在的区域（或尚未调用 ek_heap_regions_init()）会回退到默认堆，
+ *         因此在没有 CCM/SDRAM 的芯片上也可以直接使用
+ */
+typedef struct ek_heap_t ek_heap_t;
+
+struct ek_heap_t
+{
+    const char *name; /**< 堆名称 */
+    tlsf_t tlsf; /**< TLSF 实例，NULL 表示该区域不可用 */
+    uint32_t pool_amount; /**< 已加入的内存池数量 */
+    struct
+    {
+        pool_t pool; /**< TLSF 内存池句柄 */
+        uint8_t *start; /**< 区域起始地址 */
+        uint8_t *end; /**< 区域结束地址（不含） */
+    } pools[EK_HEAP_REGION_MAX_POOLS];
+    ek_heap_stats_t stats; /**< 运行计数（ek_heap_dma 使用默认堆的计数） */
+};
+
+extern ek_heap_t ek_heap_fast;
+extern ek_heap_t ek_heap_dma;
+extern ek_heap_t ek_heap_bulk;
+
+/**
+ * @brief  按链接脚本符号初始化各个命名堆
+ * @note   需要在 ek_heap_init() 之后调用；使用 SDRAM 时必须先完成 SDRAM 控制器的初始化
+ */
+void ek_heap_regions_init(void);
+
+/**
+ * @brief  从指定的命名堆分配内存
+ * @param  heap: 命名堆（&ek_heap_fast / &ek_heap_dma / &ek_heap_bulk）
+ * @param  size: 要分配的内存大小（字节）
+ * @retval 分配的内存指针，失败返回 NULL
+ * @note   释放时直接使用 ek_free()，会按地址归还到所属的堆
+ */
+__EK_NOINLINE void *ek_malloc_in(ek_heap_t *heap, size_t size);
+
+#    if EK_HEAP_TRACE == 1
+/* 与 ek_malloc 相同，避免尾调用使记录到的调用点错位 */
+__EK_ALWAYS_INLINE void *_ek_malloc_in_traced(ek_heap_t *heap, size_t size)
+{
+    void *ptr = (ek_malloc_in)(heap, size);
+    __EK_NO_TAIL_CALL();
+    return ptr;
+}
+#        define ek_malloc_in(heap, size) _ek_malloc_in_traced((heap), (size))
+#    endif /* EK_HEAP_TRACE */
+
+/**
+ * @brief  判断地址属于哪个命名堆
+ * @param  ptr: 要检查的地址
+ * @retval 所属的命名堆，不属于任何命名区域时返回 &ek_heap_dma
+ */
+ek_heap_t *ek_heap_of(const void *ptr);
+
+/**
+ * @brief  获取命名堆的统计信息
+ * @param  heap: 命名堆
+ * @param  stats: 输出的统计信息
+ * @note   复杂度 O(1)，区域不可用时各项为 0
+ */
+void ek_heap_stats_in(ek_heap_t *heap, ek_heap_stats_t *stats);
+
+/**
+ * @brief  获取命名堆的空闲内存大小
+ * @param  heap: 命名堆
+ * @retval 空闲字节数，区域不可用时返回 0
+ */
+size_t ek_heap_unused_in(ek_heap_t *heap);
+
+/**
+ * @brief  获取命名堆已使用的内存大小
+ * @param  heap: 命名堆
+ * @retval 使用的字节数，区域不可用时返回 0
+ */
+size_t ek_heap_used_in(ek_heap_t *heap);
+
+#    endif /* EK_HEAP_REGION_ENABLE */
+
 #else
 
 /* ========================================================================
@@ -0,0 +1,163 @@
+/**
+ * @file ek_mempool.h
+ * @brief 固定大小内存块池
+ * @author N1netyNine99
+ *
+ * 为任务、事件、字符串头等频繁创建的定长对象提供 O(1) 的分配和释放：
+ * - 存储区可以来自静态数组（EK_MEMPOOL_DEFINE）、调用者缓冲区或 TLSF 堆
+ * - 没有 TLSF 块头开销，也不需要搜索空闲块
+ * - 分配/释放在 ek_mem_enter_critical()/ek_mem_exit_critical() 内完成；这对钩子默认是空的弱函数，
+ *   只有提供了关中断的强定义（或 EK_USE_RTOS 下的 heap_ek.c）后才能在中断和多任务中使用
+ * - 记录当前使用量和高水位，便于确定池的大小
+ *
+ * @note 块首次分配时才从存储区切出（惰性初始化），因此定义和初始化池都不需要遍历存储区
+ */
+
+#ifndef EK_MEMPOOL_H
+#define EK_MEMPOOL_H
+
+#include "ek_conf.h"
+
+#if EK_MEMPOOL_ENABLE == 1
+
+#    include "ek_def.h"
+
+/**
+ * @brief 内存块的对齐字节数，块大小会向上取整到此值的整数倍
+ */
+#    define EK_MEMPOOL_ALIGN (sizeof(void *))
+
+/**
+ * @brief 计算对齐后的单个块大小
+ * @param size 对象大小（字节）
+ */
+#    define EK_MEMPOOL_BLOCK_SIZE(size) \
+        ((((size) < sizeof(void *) ? sizeof(void *) : (size)) + EK_MEMPOOL_ALIGN - 1U) & ~(EK_MEMPOOL_ALIGN - 1U))
+
+/**
+ * @brief 内存块池结构
+ */
+typedef struct ek_mempool_t ek_mempool_t;
+
+struct ek_mempool_t
+{
+    uint8_t *storage; /**< 块存储区 */
+    size_t block_size; /**< 单个块大小（字节，已对齐） */
+    uint32_t block_amount; /**< 块总数 */
+    uint32_t carved; /**< 已从存储区切出过的块数 */
+    void *free_list; /**< 已归还的空闲块链表，链接指针存放在块内 */
+    uint32_t used; /**< 当前已分配的块数 */
+    uint32_t peak; /**< 已分配块数的历史最大值（高水位） */
+};
+
+/**
+ * @brief 静态定义一个内存块池，存储区位于 .bss，不占用堆
+ * @param name 内存块池对象名（ek_mempool_t 类型，使用时取地址）
+ * @param type 块中存放的对象类型
+ * @param n 块数量
+ *
+ * @note 编译期完成初始化，无需调用 ek_mempool_init()
+ */
+#    define EK_MEMPOOL_DEFINE(name, type, n)                \
+        static union                                        \
+        {                                                   \
+            type item;                                      \
+            void *link;                                     \
+        } _ek_mp_storage_##name[(n)];                       \
+        static ek_mempool_t name = {                        \
+            .storage = (uint8_t *)_ek_mp_storage_##name,    \
+            .block_size = sizeof(_ek_mp_storage_##name[0]), \
+            .block_amount = (n),                            \
+        }
+
+#    ifdef __cplusplus
+extern "C"
+{
+#    endif /* __cplusplus */
+
+/**
+ * @brief 在调用者提供的存储区上初始化内存块池
+ * @param mp 内存块池对象
+ * @param storage 存储区，按 EK_MEMPOOL_ALIGN 对齐
+ * @param block_size 单个块大小（字节），不足一个指针或未对齐时自动向上取整
+ * @param block_amount 块数量
+ *
+ * @note 存储区至少需要 EK_MEMPOOL_BLOCK_SIZE(block_size) * block_amount 字节
+ */
+void ek_mempool_init(ek_mempool_t *mp, void *storage, size_t block_size, uint32_t block_amount);
+
+/**
+ * @brief 从 TLSF 堆中切出一个内存块池
+ * @param block_size 单个块大小（字节）
+ * @param block_amount 块数量
+ * @return 成功返回内存块池指针，失败返回 NULL
+ *
+ * @note 池头和全部块只占用一次堆分配
+ */
+ek_mempool_t *ek_mempool_create(size_t block_size, uint32_t block_amount);
+
+/**
+ * @brief 销毁由 ek_mempool_create() 创建的内存块池
+ * @param mp 内存块池指针
+ *
+ * @warning 销毁后池中分配出去的块全部失效
+ */
+void ek_mempool_destroy(ek_mempool_t *mp);
+
+/**
+ * @brief 分配一个块
+ * @param mp 内存块池指针
+ * @return 成功返回块地址，池已耗尽返回 NULL
+ *
+ * @note 复杂度：O(1)；在中断中调用需要 ek_mem_enter_critical() 的强定义
+ */
+void *ek_mempool_alloc(ek_mempool_t *mp);
+
+/**
+ * @brief 归还一个块
+ * @param mp 内存块池指针
+ * @param ptr 由同一个池分配的块地址
+ *
+ * @note 复杂度：O(1)；与 ek_mempool_alloc() 相同，中断安全取决于临界区钩子
+ */
+void ek_mempool_free(ek_mempool_t *mp, void *ptr);
+
+/**
+ * @brief 判断地址是否属于该内存块池
+ * @param mp 内存块池指针
+ * @param ptr 要检查的地址
+ * @return true 属于该池
+ * @return false 不属于该池
+ *
+ * @note 可用于池耗尽后回退到 ek_malloc 的场景，释放时据此选择归还方式
+ */
+bool ek_mempool_contains(const ek_mempool_t *mp, const void *ptr);
+
+/**
+ * @brief 获取当前已分配的块数
+ * @param mp 内存块池指针
+ * @return 已分配的块数
+ */
+uint32_t ek_mempool_used(const ek_mempool_t *mp);
+
+/**
+ * @brief 获取剩余可分配的块数
+ * @param mp 内存块池指针
+ * @return 剩余块数
+ */
+uint32_t ek_mempool_unused(const ek_mempool_t *mp);
+
+/**
+ * @brief 获取高水位（已分配块数的历史最大值）
+ * @param mp 内存块池指针
+ * @return 高水位块数
+ */
+uint32_t ek_mempool_peak(const ek_mempool_t *mp);
+
+#    ifdef __cplusplus
+}
+#    endif /* __cplusplus */
+
+#endif /* EK_MEMPOOL_ENABLE */
+
+#endif /* EK_MEMPOOL_H */
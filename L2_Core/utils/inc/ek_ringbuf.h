@@ -11,15 +11,25 @@
 
 #include "ek_conf.h"
 
-#if (EK_RINGBUF_ENABLE == 1) || (EK_RINGBUF_SPSC_ENABLE == 1)
+#if (EK_RINGBUF_ENABLE == 1) || (EK_RINGBUF_SPSC_ENABLE == 1) || (EK_RINGBUF_MPMC_ENABLE == 1)
 
 #    include "ek_def.h"
 
+/**
+ * @brief SPSC 环形缓冲区是否使用 2 的幂容量
+ * @note 1 = 容量向上取整为 2 的幂，索引自由增长并用掩码取槽位，全部槽位可用
+ * @note 0 = 索引在 [0, cap) 内回绕，保留一个空槽，实际最大可存元素数为 cap - 1
+ */
+#    ifndef EK_RINGBUF_SPSC_POW2
+#        define EK_RINGBUF_SPSC_POW2 (0)
+#    endif /* EK_RINGBUF_SPSC_POW2 */
+
 /**
  * @brief 环形缓冲区结构
  */
 typedef struct ek_ringbuf_t ek_ringbuf_t;
 typedef struct ek_ringbuf_spsc_t ek_ringbuf_spsc_t;
+typedef struct ek_ringbuf_mpmc_t ek_ringbuf_mpmc_t;
 
 #    if EK_RINGBUF_ENABLE == 1
 struct ek_ringbuf_t
@@ -40,13 +50,51 @@ struct ek_ringbuf_t
 struct ek_ringbuf_spsc_t
 {
     uint8_t *buffer; /**< 缓冲区指针 */
-    uint32_t write_idx; /**< 写入位置索引 */
-    uint32_t read_idx; /**< 读取位置索引 */
-    size_t cap; /**< 底层槽位数量，实际最大可存元素数为 cap - 1 */
+    size_t cap; /**< 底层槽位数量 */
     size_t item_size; /**< 单个元素大小（字节） */
+#        if EK_RINGBUF_SPSC_POW2 == 1
+    uint32_t mask; /**< 槽位掩码（cap - 1） */
+#        endif /* EK_RINGBUF_SPSC_POW2 */
+    EK_CACHE_LINE_PAD(_pad0)
+    uint32_t write_idx; /**< 写入位置索引（仅生产者修改） */
+    EK_CACHE_LINE_PAD(_pad1)
+    uint32_t read_idx; /**< 读取位置索引（仅消费者修改） */
+    EK_CACHE_LINE_PAD(_pad2)
 };
+
+/**
+ * @brief SPSC 环形缓冲区中的一段连续区间
+ * @note 由 acquire 系列函数返回，回绕时最多拆成两段
+ */
+typedef struct
+{
+    void *buf; /**< 区间起始地址 */
+    uint32_t amount; /**< 区间内的元素个数 */
+} ek_ringbuf_span_t;
 #    endif /* EK_RINGBUF_SPSC_ENABLE */
 
+#    if EK_RINGBUF_MPMC_ENABLE == 1
+/**
+ * @brief 无锁多生产者多消费者环形缓冲区
+ *
+ * 每个槽位带一个序号（Vyukov 有界队列），生产者和消费者各自用 CAS 抢占位置，
+ * 任意数量的中断和任务都可以同时读写，只有缓冲区真的满了才会写入失败
+ */
+struct ek_ringbuf_mpmc_t
+{
+    uint8_t *buffer; /**< 槽位数组，每个槽位为 32 位序号 + 元素 */
+    size_t cap; /**< 槽位数量（2 的幂） */
+    size_t item_size; /**< 单个元素大小（字节） */
+    size_t slot_size; /**< 单个槽位大小（字节） */
+    uint32_t mask; /**< 槽位掩码（cap - 1） */
+    EK_CACHE_LINE_PAD(_pad0)
+    uint32_t enqueue_pos; /**< 下一个写入位置 */
+    EK_CACHE_LINE_PAD(_pad1)
+    uint32_t dequeue_pos; /**< 下一个读取位置 */
+    EK_CACHE_LINE_PAD(_pad2)
+};
+#    endif /* EK_RINGBUF_MPMC_ENABLE */
+
 #    ifdef __cplusplus
 extern "C"
 {
@@ -69,6 +117,34 @@ bool ek_ringbuf_full(const ek_ringbuf_t *rb);
  */
 bool ek_ringbuf_empty(const ek_ringbuf_t *rb);
 
+/**
+ * @brief 静态定义环形缓冲区，头部和存储区都放在 .bss/.data 中，不占用堆
+ * @param name 缓冲区对象名（ek_ringbuf_t 类型，使用时取地址）
+ * @param type 元素类型
+ * @param n 缓冲区容量（元素个数）
+ *
+ * @note 编译期完成初始化，无需再调用 ek_ringbuf_init()，也不能调用 ek_ringbuf_destroy()
+ * @note 需要放到 CCM-RAM 等指定区域时，自行定义存储区并调用 ek_ringbuf_init()
+ */
+#        define EK_RINGBUF_STATIC_DEFINE(name, type, n)     \
+            static type _ek_rb_storage_##name[(n)];         \
+            static ek_ringbuf_t name = {                    \
+                .buffer = (uint8_t *)_ek_rb_storage_##name, \
+                .cap = (n),                                 \
+                .item_size = sizeof(type),                  \
+            }
+
+/**
+ * @brief 在调用者提供的存储区上初始化环形缓冲区
+ * @param rb 环形缓冲区对象
+ * @param storage 存储区，至少 item_size * item_amount 字节
+ * @param item_size 单个元素大小（字节）
+ * @param item_amount 缓冲区容量（元素个数）
+ *
+ * @note 不分配任何内存，对象不再使用时直接丢弃即可，不能调用 ek_ringbuf_destroy()
+ */
+void ek_ringbuf_init(ek_ringbuf_t *rb, void *storage, size_t item_size, uint32_t item_amount);
+
 /**
  * @brief 创建环形缓冲区
  * @param item_size 单个元素大小（字节）
@@ -142,11 +218,54 @@ bool ek_ringbuf_full_spsc(const ek_ringbuf_spsc_t *rb);
  */
 bool ek_ringbuf_empty_spsc(const ek_ringbuf_spsc_t *rb);
 
+/**
+ * @brief SPSC 环形缓冲区申请 n 个槽位时实际使用的槽位数（编译期常量）
+ */
+#        if EK_RINGBUF_SPSC_POW2 == 1
+#            define EK_RINGBUF_SPSC_SLOTS(n)       EK_POW2_ROUNDUP(n)
+#            define _EK_RINGBUF_SPSC_MASK_INIT(n) .mask = EK_POW2_ROUNDUP(n) - 1U,
+#        else
+#            define EK_RINGBUF_SPSC_SLOTS(n) (n)
+#            define _EK_RINGBUF_SPSC_MASK_INIT(n)
+#        endif /* EK_RINGBUF_SPSC_POW2 */
+
+/**
+ * @brief 静态定义 SPSC 环形缓冲区，头部和存储区都不占用堆
+ * @param name 缓冲区对象名（ek_ringbuf_spsc_t 类型，使用时取地址）
+ * @param type 元素类型
+ * @param n 底层槽位数量，规则与 ek_ringbuf_create_spsc() 相同
+ *
+ * @note 编译期完成初始化，无需再调用 ek_ringbuf_init_spsc()，也不能调用 ek_ringbuf_destroy_spsc()
+ */
+#        define EK_RINGBUF_SPSC_STATIC_DEFINE(name, type, n)             \
+            static type _ek_rb_storage_##name[EK_RINGBUF_SPSC_SLOTS(n)]; \
+            static ek_ringbuf_spsc_t name = {                            \
+                .buffer = (uint8_t *)_ek_rb_storage_##name,              \
+                .cap = EK_RINGBUF_SPSC_SLOTS(n),                         \
+                .item_size = sizeof(type),                               \
+                _EK_RINGBUF_SPSC_MASK_INIT(n)                            \
+            }
+
+/**
+ * @brief 在调用者提供的存储区上初始化 SPSC 环形缓冲区
+ * @param rb 环形缓冲区对象
+ * @param storage 存储区，至少 item_size * item_amount 字节
+ * @param item_size 单个元素大小（字节）
+ * @param item_amount 底层槽位数量
+ *
+ * @note EK_RINGBUF_SPSC_POW2 == 1 时 item_amount 必须是 2 的幂（可用 EK_RINGBUF_SPSC_SLOTS() 计算）
+ * @note 不分配任何内存，不能调用 ek_ringbuf_destroy_spsc()
+ */
+void ek_ringbuf_init_spsc(ek_ringbuf_spsc_t *rb, void *storage, size_t item_size, uint32_t item_amount);
+
 /**
  * @brief 创建 SPSC 环形缓冲区
  * @param item_size 单个元素大小（字节）
- * @param item_amount 底层槽位数量，实际最大可存元素数为 item_amount - 1
+ * @param item_amount 底层槽位数量
  * @return 成功返回缓冲区指针，失败返回 NULL
+ *
+ * @note EK_RINGBUF_SPSC_POW2 == 1 时槽位数向上取整为 2 的幂，且全部可用；
+ *       否则实际最大可存元素数为 item_amount - 1
  */
 ek_ringbuf_spsc_t *ek_ringbuf_create_spsc(size_t item_size, uint32_t item_amount);
 
@@ -193,12 +312,170 @@ bool ek_ringbuf_read_spsc(ek_ringbuf_spsc_t *rb, void *item);
  * @return false 查看失败（缓冲区为空）
  */
 bool ek_ringbuf_peek_spsc(ek_ringbuf_spsc_t *rb, void *item);
+
+/**
+ * @brief 获取 SPSC 环形缓冲区中可读的元素个数
+ * @param rb 环形缓冲区指针
+ * @return 可读元素个数
+ */
+uint32_t ek_ringbuf_count_spsc(const ek_ringbuf_spsc_t *rb);
+
+/**
+ * @brief 获取 SPSC 环形缓冲区中可写的元素个数
+ * @param rb 环形缓冲区指针
+ * @return 可写元素个数
+ */
+uint32_t ek_ringbuf_space_spsc(const ek_ringbuf_spsc_t *rb);
+
+/**
+ * @brief 向 SPSC 环形缓冲区批量写入元素
+ * @param rb 环形缓冲区指针
+ * @param items 要写入的连续元素数组
+ * @param amount 期望写入的元素个数
+ * @return 实际写入的元素个数（空间不足时小于 amount）
+ *
+ * @note 回绕时最多两次 memcpy，索引只更新一次
+ */
+uint32_t ek_ringbuf_write_bulk_spsc(ek_ringbuf_spsc_t *rb, const void *items, uint32_t amount);
+
+/**
+ * @brief 从 SPSC 环形缓冲区批量读取元素
+ * @param rb 环形缓冲区指针
+ * @param items 存储读取结果的数组，传入 NULL 则直接丢弃数据
+ * @param amount 期望读取的元素个数
+ * @return 实际读取的元素个数（数据不足时小于 amount）
+ */
+uint32_t ek_ringbuf_read_bulk_spsc(ek_ringbuf_spsc_t *rb, void *items, uint32_t amount);
+
+/**
+ * @brief 申请可直接写入的连续区间（零拷贝）
+ * @param rb 环形缓冲区指针
+ * @param span 输出的区间数组，固定两项；第二项仅在回绕时非空
+ * @param amount 期望申请的元素个数，传入 UINT32_MAX 表示申请全部空闲空间
+ * @return 实际可写的元素个数（两段之和）
+ *
+ * @note 写完后调用 ek_ringbuf_commit_write_spsc() 发布数据，未提交前消费者不可见
+ * @note 适合让 DMA 或解析器直接在缓冲区内工作
+ */
+uint32_t ek_ringbuf_acquire_write_spsc(ek_ringbuf_spsc_t *rb, ek_ringbuf_span_t span[2], uint32_t amount);
+
+/**
+ * @brief 提交已写入的元素
+ * @param rb 环形缓冲区指针
+ * @param amount 提交的元素个数，不能超过上一次 acquire 得到的数量
+ */
+void ek_ringbuf_commit_write_spsc(ek_ringbuf_spsc_t *rb, uint32_t amount);
+
+/**
+ * @brief 申请可直接读取的连续区间（零拷贝）
+ * @param rb 环形缓冲区指针
+ * @param span 输出的区间数组，固定两项；第二项仅在回绕时非空
+ * @param amount 期望申请的元素个数，传入 UINT32_MAX 表示申请全部可读数据
+ * @return 实际可读的元素个数（两段之和）
+ *
+ * @note 处理完后调用 ek_ringbuf_release_read_spsc() 归还空间
+ */
+uint32_t ek_ringbuf_acquire_read_spsc(ek_ringbuf_spsc_t *rb, ek_ringbuf_span_t span[2], uint32_t amount);
+
+/**
+ * @brief 归还已读取的元素空间
+ * @param rb 环形缓冲区指针
+ * @param amount 归还的元素个数，不能超过上一次 acquire 得到的数量
+ */
+void ek_ringbuf_release_read_spsc(ek_ringbuf_spsc_t *rb, uint32_t amount);
 #    endif /* EK_RINGBUF_SPSC_ENABLE */
 
+#    if EK_RINGBUF_MPMC_ENABLE == 1
+/**
+ * @brief MPMC 环形缓冲区单个槽位占用的字节数（32 位序号 + 4 字节对齐的元素）
+ */
+#        define EK_RINGBUF_MPMC_SLOT_SIZE(item_size) (sizeof(uint32_t) + (((item_size) + 3U) & ~(size_t)3U))
+
+/**
+ * @brief 在调用者提供的存储区上初始化 MPMC 环形缓冲区
+ * @param rb 环形缓冲区对象
+ * @param storage 存储区，4 字节对齐，至少 EK_RINGBUF_MPMC_SLOT_SIZE(item_size) * item_amount 字节
+ * @param item_size 单个元素大小（字节）
+ * @param item_amount 缓冲区容量，必须是不小于 2 的 2 的幂
+ *
+ * @note 每个槽位的序号需要运行时写入，因此 MPMC 没有编译期静态定义宏
+ * @note 不分配任何内存，不能调用 ek_ringbuf_destroy_mpmc()
+ */
+void ek_ringbuf_init_mpmc(ek_ringbuf_mpmc_t *rb, void *storage, size_t item_size, uint32_t item_amount);
+
+/**
+ * @brief 创建 MPMC 环形缓冲区
+ * @param item_size 单个元素大小（字节）
+ * @param item_amount 缓冲区容量（元素个数），向上取整为 2 的幂
+ * @return 成功返回缓冲区指针，失败返回 NULL
+ */
+ek_ringbuf_mpmc_t *ek_ringbuf_create_mpmc(size_t item_size, uint32_t item_amount);
+
+/**
+ * @brief 销毁 MPMC 环形缓冲区
+ * @param rb 要销毁的环形缓冲区
+ *
+ * @warning 调用时不能有其他生产者或消费者仍在访问
+ */
+void ek_ringbuf_destroy_mpmc(ek_ringbuf_mpmc_t *rb);
+
+/**
+ * @brief 销毁 MPMC 环形缓冲区并把 rb_ptr 设置为 NULL
+ * @param rb_ptr 要销毁的环形缓冲区
+ */
+#        define ek_ringbuf_destroy_safely_mpmc(rb_ptr) \
+            do                                         \
+            {                                          \
+                ek_ringbuf_destroy_mpmc(rb_ptr);       \
+                rb_ptr = NULL;                         \
+            } while (0)
+
+/**
+ * @brief 向 MPMC 环形缓冲区写入一个元素
+ * @param rb 环形缓冲区指针
+ * @param item 要写入的元素指针
+ * @return true 写入成功
+ * @return false 写入失败（缓冲区已满）
+ *
+ * @note 可在任务和中断中并发调用，竞争时重试而不是丢弃
+ */
+bool ek_ringbuf_write_mpmc(ek_ringbuf_mpmc_t *rb, const void *item);
+
+/**
+ * @brief 从 MPMC 环形缓冲区读取一个元素
+ * @param rb 环形缓冲区指针
+ * @param item 存储读取结果的缓冲区指针，传入 NULL 则直接丢弃数据
+ * @return true 读取成功
+ * @return false 读取失败（缓冲区为空）
+ *
+ * @note 可在任务和中断中并发调用
+ */
+bool ek_ringbuf_read_mpmc(ek_ringbuf_mpmc_t *rb, void *item);
+
+/**
+ * @brief 获取 MPMC 环形缓冲区中的元素个数
+ * @param rb 环形缓冲区指针
+ * @return 元素个数
+ *
+ * @note 并发读写时只是一个瞬时近似值
+ */
+uint32_t ek_ringbuf_count_mpmc(const ek_ringbuf_mpmc_t *rb);
+
+/**
+ * @brief 判断 MPMC 环形缓冲区是否为空
+ * @param rb 环形缓冲区指针
+ * @return true 为空
+ * @return false 不为空
+ *
+ * @note 并发读写时只是一个瞬时近似值
+ */
+bool ek_ringbuf_empty_mpmc(const ek_ringbuf_mpmc_t *rb);
+#    endif /* EK_RINGBUF_MPMC_ENABLE */
+
 #    ifdef __cplusplus
 }
 #    endif /* __cplusplus */
 
-#endif /* EK_RINGBUF_ENABLE || EK_RINGBUF_SPSC_ENABLE */
+#endif /* EK_RINGBUF_ENABLE || EK_RINGBUF_SPSC_ENABLE || EK_RINGBUF_MPMC_ENABLE */
 
 #endif /* EK_RINGBUF_H */
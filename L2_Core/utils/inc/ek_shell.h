@@ -22,6 +22,14 @@
 
 #include "shell.h"
 
+/**
+ * @brief 导出命令到 Shell
+ * @param cmd Shell 中的命令名
+ * @param func 命令函数
+ * @param desc 命令描述
+ */
+#define EK_SHELL_EXPORT_CMD(cmd, func, desc)           SHELL_EXPORT_CMD(cmd, func, desc)
+
 /**
  * @brief 导出整型变量到 Shell
  * @param var Shell 中的变量名
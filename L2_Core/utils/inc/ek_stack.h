@@ -6,8 +6,8 @@
  * 本模块实现了一个类型通用的栈（后进先出，LIFO）数据结构。
  * 支持任意数据类型的存储，通过指定元素大小实现类型安全。
  *
- * @note 栈基于动态内存分配，使用前需调用 ek_stack_create() 创建，
- *       使用完毕后需调用 ek_stack_destroy() 释放内存。
+ * @note 栈可以通过 ek_stack_create() 动态创建，使用完毕后需调用 ek_stack_destroy() 释放内存；
+ *       也可以用 EK_STACK_STATIC_DEFINE() 或 ek_stack_init() 放在静态存储区，不占用堆。
  *
  * @warning 所有操作函数均会对传入的栈指针进行断言检查，
  *          传入 NULL 指针将在调试模式下触发断言失败。
@@ -67,6 +67,37 @@ bool ek_stack_full(ek_stack_t *sk);
  */
 bool ek_stack_empty(ek_stack_t *sk);
 
+/**
+ * @brief 静态定义一个栈，头部和存储区都不占用堆
+ *
+ * @param name 栈对象名（ek_stack_t 类型，使用时取地址）
+ * @param type 元素类型
+ * @param n 栈的容量（最多可存储的元素数量）
+ *
+ * @note 编译期完成初始化，无需调用 ek_stack_init()
+ * @warning 不能对静态定义的栈调用 ek_stack_destroy()
+ */
+#    define EK_STACK_STATIC_DEFINE(name, type, n) \
+        static type _ek_sk_storage_##name[(n)];   \
+        static ek_stack_t name = {                \
+            .buffer = _ek_sk_storage_##name,      \
+            .item_size = sizeof(type),            \
+            .cap = (n),                           \
+        }
+
+/**
+ * @brief 在调用者提供的存储区上初始化栈
+ *
+ * @param sk 栈对象
+ * @param storage 存储区，至少 item_size * item_amount 字节
+ * @param item_size 单个元素的大小（字节）
+ * @param item_amount 栈的容量（最多可存储的元素数量）
+ *
+ * @note 不分配任何内存，存储区可以位于 .bss、CCM-RAM 或调用者的缓冲区
+ * @warning 不能对以此方式初始化的栈调用 ek_stack_destroy()
+ */
+void ek_stack_init(ek_stack_t *sk, void *storage, size_t item_size, uint32_t item_amount);
+
 /**
  * @brief 创建一个新栈
  *
@@ -10,6 +10,7 @@
  * - 字符串比较
  *
  * @note 使用前需调用 ek_str_create() 创建，使用完毕后需调用 ek_str_free() 释放
+ * @note 使用 ek_str_create_with() 可以指定分配器（例如 ek_arena），字符串头和内容都从该分配器分配
  */
 
 #ifndef EK_STR_H
@@ -20,6 +21,28 @@
 #if EK_STR_ENABLE == 1
 
 #    include "ek_def.h"
+#    include "ek_mem.h"
+
+/**
+ * @brief 字符串头（ek_str_t）是否从静态内存块池分配
+ * @note 只影响字符串头，字符串内容仍然来自堆；池耗尽时回退到 ek_malloc
+ */
+#    ifndef EK_STR_USE_MEMPOOL
+#        define EK_STR_USE_MEMPOOL (0)
+#    endif /* EK_STR_USE_MEMPOOL */
+
+#    if EK_STR_USE_MEMPOOL == 1
+#        if EK_MEMPOOL_ENABLE != 1
+#            error "EK_STR_USE_MEMPOOL requires EK_MEMPOOL_ENABLE"
+#        endif /* EK_MEMPOOL_ENABLE */
+
+/**
+ * @brief 字符串头内存块池容量
+ */
+#        ifndef EK_STR_POOL_SIZE
+#            define EK_STR_POOL_SIZE (8)
+#        endif /* EK_STR_POOL_SIZE */
+#    endif /* EK_STR_USE_MEMPOOL */
 
 #    ifdef __cplusplus
 extern "C"
@@ -36,6 +59,7 @@ struct ek_str_t
     char *buf; /**< 字符串缓冲区指针 */
     uint32_t cap; /**< 缓冲区容量（字节数） */
     uint32_t len; /**< 当前字符串长度（不包含 \0） */
+    const ek_allocator_t *alloc; /**< 分配器，NULL 表示默认堆 */
 };
 
 /**
@@ -46,6 +70,16 @@ struct ek_str_t
  */
 ek_str_t *ek_str_create(const char *str);
 
+/**
+ * @brief 使用指定的分配器创建动态字符串
+ * @param alloc 分配器（例如 ek_arena_allocator(&arena)），NULL 表示默认堆
+ * @param str 初始字符串内容（可为 NULL，表示创建空字符串）
+ * @return 字符串对象指针，失败返回 NULL
+ * @note 之后的扩容、切片都使用同一个分配器；来自 arena 的字符串可以不调用 ek_str_free()，
+ *       随 arena 一起重置
+ */
+ek_str_t *ek_str_create_with(const ek_allocator_t *alloc, const char *str);
+
 /**
  * @brief 释放动态字符串
  * @param s 字符串对象指针
@@ -100,7 +134,7 @@ bool ek_str_cat(ek_str_t *dst, ek_str_t *src);
  * @param start 起始索引（支持负数，-1 表示最后一个字符）
  * @param end 结束索引（不包含，支持负数）
  * @return 新的字符串对象，失败返回 NULL
- * @note 返回的字符串需要调用 ek_str_free() 释放
+ * @note 返回的字符串与源字符串使用同一个分配器，需要调用 ek_str_free() 释放
  */
 ek_str_t *ek_str_slice(const ek_str_t *s, int32_t start, int32_t end);
 
@@ -7,7 +7,10 @@
  * 使用宏实现类型生成，避免 void* 的类型不安全问题
  *
  * @note 使用前必须通过 EK_VEC_IMPLEMENT(type) 宏定义特定类型的向量
- * @note 所有内存操作使用 ek_malloc/ek_realloc/ek_free，需确保内存管理模块已初始化
+ * @note 使用 EK_VEC_STATIC_DEFINE() 或 ek_vec_init_static() 可以把数组放在静态存储区，
+ *       此时容量固定，不会调用任何内存分配函数
+ * @note 默认的内存操作使用 ek_malloc/ek_realloc/ek_free，需确保内存管理模块已初始化；
+ *       使用 ek_vec_init_with() 可以指定分配器（例如 ek_arena）
  */
 
 #ifndef EK_VEC_H
@@ -41,12 +44,14 @@
  * ek_vec_append(my_vec, 42);
  * ek_vec_destroy(my_vec);
  */
-#    define EK_VEC_IMPLEMENT(type) \
-        typedef struct             \
-        {                          \
-            type *items;           \
-            uint32_t amount;       \
-            uint32_t cap;          \
+#    define EK_VEC_IMPLEMENT(type)       \
+        typedef struct                   \
+        {                                \
+            type *items;                 \
+            uint32_t amount;             \
+            uint32_t cap;                \
+            bool fixed;                  \
+            const ek_allocator_t *alloc; \
         } ek_vec_##type##_t
 
 /**
@@ -81,14 +86,69 @@
  *
  * @note 使用前必须调用此宏进行初始化
  */
-#    define ek_vec_init(v)    \
-        do                    \
-        {                     \
-            (v).items = NULL; \
-            (v).amount = 0;   \
-            (v).cap = 0;      \
+#    define ek_vec_init(v)     \
+        do                     \
+        {                      \
+            (v).items = NULL;  \
+            (v).amount = 0;    \
+            (v).cap = 0;       \
+            (v).fixed = false; \
+            (v).alloc = NULL;  \
         } while (0)
 
+/**
+ * @brief 使用指定的分配器初始化动态数组
+ * @param v 动态数组变量
+ * @param allocator 分配器（例如 ek_arena_allocator(&arena)），NULL 表示默认堆
+ *
+ * @note 来自 arena 的动态数组可以不调用 ek_vec_destroy，随 arena 一起重置
+ */
+#    define ek_vec_init_with(v, allocator) \
+        do                                 \
+        {                                  \
+            (v).items = NULL;              \
+            (v).amount = 0;                \
+            (v).cap = 0;                   \
+            (v).fixed = false;             \
+            (v).alloc = (allocator);       \
+        } while (0)
+
+/**
+ * @brief 在调用者提供的存储区上初始化固定容量的动态数组
+ * @param v 动态数组变量
+ * @param storage 元素存储区（元素类型的数组）
+ * @param n 存储区可容纳的元素个数
+ *
+ * @note 容量固定为 n，写满后 ek_vec_append 不再追加；ek_vec_destroy/ek_vec_shrink 不会释放存储区
+ */
+#    define ek_vec_init_static(v, storage, n) \
+        do                                    \
+        {                                     \
+            (v).items = (storage);            \
+            (v).amount = 0;                   \
+            (v).cap = (n);                    \
+            (v).fixed = true;                 \
+            (v).alloc = NULL;                 \
+        } while (0)
+
+/**
+ * @brief 静态定义固定容量的动态数组，数组头和存储区都不占用堆
+ * @param name 动态数组变量名
+ * @param type 元素数据类型（需先通过 EK_VEC_IMPLEMENT(type) 定义）
+ * @param n 固定容量
+ *
+ * @note 编译期完成初始化，无需调用 ek_vec_init
+ */
+#    define EK_VEC_STATIC_DEFINE(name, type, n)  \
+        static type _ek_vec_storage_##name[(n)]; \
+        static ek_vec_t(type) name = {           \
+            .items = _ek_vec_storage_##name,     \
+            .amount = 0,                         \
+            .cap = (n),                          \
+            .fixed = true,                       \
+            .alloc = NULL,                       \
+        }
+
 /**
  * @brief 销毁动态数组并释放内存
  * @param v 动态数组变量
@@ -96,12 +156,16 @@
  * @note 销毁后动态数组变量仍存在，但内容已清空
  * @note 如需重新使用，应重新调用 ek_vec_init
  */
-#    define ek_vec_destroy(v)   \
-        do                      \
-        {                       \
-            ek_free((v).items); \
-            (v).amount = 0;     \
-            (v).cap = 0;        \
+#    define ek_vec_destroy(v)                                                          \
+        do                                                                             \
+        {                                                                              \
+            if (!(v).fixed)                                                            \
+            {                                                                          \
+                ek_allocator_free((v).alloc, (v).items, (v).cap * sizeof(*(v).items)); \
+                (v).items = NULL;                                                      \
+            }                                                                          \
+            (v).amount = 0;                                                            \
+            (v).cap = 0;                                                               \
         } while (0)
 
 /**
@@ -111,23 +175,26 @@
  *
  * @note 当容量不足时自动扩容
  * @note 扩容策略：小数组翻倍，大数组增加 1/2
+ * @note 固定容量的动态数组写满后不再追加
  */
-#    define ek_vec_append(v, val)                                                                            \
-        do                                                                                                   \
-        {                                                                                                    \
-            if ((v).cap <= (v).amount)                                                                       \
-            {                                                                                                \
-                uint32_t _temp_for_cap_ex_ =                                                                 \
-                    ((v).cap < VEC_LARGE_THRESHOLD) ? ((v).cap ? 2 * (v).cap : 8) : ((v).cap + (v).cap / 2); \
-                void *_temp_for_new_items_ = ek_realloc((v).items, _temp_for_cap_ex_ * sizeof(*(v).items));  \
-                if (_temp_for_new_items_ != NULL)                                                            \
-                {                                                                                            \
-                    (v).cap = _temp_for_cap_ex_;                                                             \
-                    (v).items = _temp_for_new_items_;                                                        \
-                }                                                                                            \
-                else break;                                                                                  \
-            }                                                                                                \
-            (v).items[(v).amount++] = (val);                                                                 \
+#    define ek_vec_append(v, val)                                                                                \
+        do                                                                                                       \
+        {                                                                                                        \
+            if ((v).cap <= (v).amount)                                                                           \
+            {                                                                                                    \
+                if ((v).fixed) break;                                                                            \
+                uint32_t _temp_for_cap_ex_ =                                                                     \
+                    ((v).cap < VEC_LARGE_THRESHOLD) ? ((v).cap ? 2 * (v).cap : 8) : ((v).cap + (v).cap / 2);     \
+                void *_temp_for_new_items_ = ek_allocator_realloc(                                               \
+                    (v).alloc, (v).items, (v).cap * sizeof(*(v).items), _temp_for_cap_ex_ * sizeof(*(v).items)); \
+                if (_temp_for_new_items_ != NULL)                                                                \
+                {                                                                                                \
+                    (v).cap = _temp_for_cap_ex_;                                                                 \
+                    (v).items = _temp_for_new_items_;                                                            \
+                }                                                                                                \
+                else break;                                                                                      \
+            }                                                                                                    \
+            (v).items[(v).amount++] = (val);                                                                     \
         } while (0)
 
 /**
@@ -189,25 +256,28 @@
  *
  * @note 将容量缩减为当前元素数量，释放多余内存,如果元素数目为0，则会释放items的所有内存
  * @note 如果 realloc 失败，则保持原状态不变
+ * @note 固定容量的动态数组不做任何处理
  */
-#    define ek_vec_shrink(v)                                                                         \
-        do                                                                                           \
-        {                                                                                            \
-            if ((v).amount)                                                                          \
-            {                                                                                        \
-                void *_temp_for_new_items_ = ek_realloc((v).items, (v).amount * sizeof(*(v).items)); \
-                if (_temp_for_new_items_)                                                            \
-                {                                                                                    \
-                    (v).items = _temp_for_new_items_;                                                \
-                    (v).cap = (v).amount;                                                            \
-                }                                                                                    \
-            }                                                                                        \
-            else if ((v).items)                                                                      \
-            {                                                                                        \
-                ek_free((v).items);                                                                  \
-                (v).items = NULL;                                                                    \
-                (v).cap = 0;                                                                         \
-            }                                                                                        \
+#    define ek_vec_shrink(v)                                                                              \
+        do                                                                                                \
+        {                                                                                                 \
+            if ((v).fixed) break;                                                                         \
+            if ((v).amount)                                                                               \
+            {                                                                                             \
+                void *_temp_for_new_items_ = ek_allocator_realloc(                                        \
+                    (v).alloc, (v).items, (v).cap * sizeof(*(v).items), (v).amount * sizeof(*(v).items)); \
+                if (_temp_for_new_items_)                                                                 \
+                {                                                                                         \
+                    (v).items = _temp_for_new_items_;                                                     \
+                    (v).cap = (v).amount;                                                                 \
+                }                                                                                         \
+            }                                                                                             \
+            else if ((v).items)                                                                           \
+            {                                                                                             \
+                ek_allocator_free((v).alloc, (v).items, (v).cap * sizeof(*(v).items));                    \
+                (v).items = NULL;                                                                         \
+                (v).cap = 0;                                                                              \
+            }                                                                                             \
         } while (0)
 
 #endif /* EK_VEC_ENABLE */
@@ -0,0 +1,137 @@
+/**
+ * @file ek_arena.c
+ * @brief 线性（bump）分配器实现
+ * @author N1netyNine99
+ */
+
+#include "ek_arena.h"
+
+#if EK_ARENA_ENABLE == 1
+
+#    include "ek_assert.h"
+
+void ek_arena_init(ek_arena_t *arena, void *buf, size_t size)
+{
+    ek_assert_param(arena != NULL);
+    ek_assert_param(buf != NULL);
+
+    arena->allocator.realloc = _ek_arena_realloc;
+    arena->allocator.ctx = arena;
+    arena->base = (uint8_t *)buf;
+    arena->size = size;
+    arena->offset = 0;
+    arena->peak = 0;
+}
+
+ek_arena_t *ek_arena_create(size_t size)
+{
+    // arena 头之后紧跟存储区，只占一次堆分配
+    size_t head_size = (sizeof(ek_arena_t) + EK_ARENA_ALIGN - 1U) & ~(size_t)(EK_ARENA_ALIGN - 1U);
+    ek_arena_t *arena = (ek_arena_t *)ek_malloc(head_size + size);
+    if (arena == NULL) return NULL;
+
+    ek_arena_init(arena, (uint8_t *)arena + head_size, size);
+
+    return arena;
+}
+
+void ek_arena_destroy(ek_arena_t *arena)
+{
+    ek_assert_param(arena != NULL);
+
+    ek_free(arena);
+}
+
+void *ek_arena_alloc(ek_arena_t *arena, size_t size)
+{
+    ek_assert_param(arena != NULL);
+
+    if (size == 0) return NULL;
+
+    // 按实际地址对齐，调用者提供的存储区不要求对齐
+    uintptr_t top = (uintptr_t)(arena->base + arena->offset);
+    size_t pad = (size_t)((EK_ARENA_ALIGN - (top & (EK_ARENA_ALIGN - 1U))) & (EK_ARENA_ALIGN - 1U));
+    if (pad > arena->size - arena->offset || size > arena->size - arena->offset - pad) return NULL;
+
+    void *ptr = arena->base + arena->offset + pad;
+    arena->offset += pad + size;
+    if (arena->offset > arena->peak) arena->peak = arena->offset;
+
+    return ptr;
+}
+
+ek_arena_mark_t ek_arena_save(const ek_arena_t *arena)
+{
+    ek_assert_param(arena != NULL);
+
+    return arena->offset;
+}
+
+void ek_arena_rewind(ek_arena_t *arena, ek_arena_mark_t mark)
+{
+    ek_assert_param(arena != NULL);
+    ek_assert_param(mark <= arena->offset);
+
+    arena->offset = mark;
+}
+
+void ek_arena_reset(ek_arena_t *arena)
+{
+    ek_assert_param(arena != NULL);
+
+    arena->offset = 0;
+}
+
+size_t ek_arena_used(const ek_arena_t *arena)
+{
+    ek_assert_param(arena != NULL);
+
+    return arena->offset;
+}
+
+size_t ek_arena_unused(const ek_arena_t *arena)
+{
+    ek_assert_param(arena != NULL);
+
+    return arena->size - arena->offset;
+}
+
+size_t ek_arena_peak(const ek_arena_t *arena)
+{
+    ek_assert_param(arena != NULL);
+
+    return arena->peak;
+}
+
+void *_ek_arena_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+    ek_arena_t *arena = (ek_arena_t *)ctx;
+    ek_assert_param(arena != NULL);
+
+    if (ptr == NULL) return ek_arena_alloc(arena, new_size);
+
+    // 最后一次分配可以直接移动偏移量，其余情况只能整体回收
+    bool is_top = ((uint8_t *)ptr + old_size == arena->base + arena->offset);
+    size_t start = (size_t)((uint8_t *)ptr - arena->base);
+
+    if (new_size == 0)
+    {
+        if (is_top) arena->offset = start;
+        return NULL;
+    }
+
+    if (is_top && new_size <= arena->size - start)
+    {
+        arena->offset = start + new_size;
+        if (arena->offset > arena->peak) arena->peak = arena->offset;
+        return ptr;
+    }
+
+    if (new_size <= old_size) return ptr;
+
+    void *new_ptr = ek_arena_alloc(arena, new_size);
+    if (new_ptr != NULL) memcpy(new_ptr, ptr, old_size);
+    return new_ptr;
+}
+
+#endif /* EK_ARENA_ENABLE */
@@ -12,6 +12,7 @@ void ek_assert_fault(const char *file, uint32_t line, const char *expr)
 #if EK_ASSERT_WITH_LOG == 1
     EK_LOG_FILE_TAG("ek_assert.c");
     EK_LOG_ERROR("file:%s,line:%" PRIu32 ",expr: %s", EK_GET_FILE_NAME(file), line, expr);
+    ek_io_flush(); // 停机前输出缓冲区中剩余的内容
 #else
     __EK_UNUSED(file);
     __EK_UNUSED(line);
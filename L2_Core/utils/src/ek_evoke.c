@@ -10,22 +10,36 @@
 
 #    include "ek_ringbuf.h"
 #    include "ek_mem.h"
+#    include "ek_mempool.h"
 #    include "ek_export.h"
 #    include "ek_log.h"
 #    include "ek_assert.h"
 
+#    if EK_EVOKE_STATS_ENABLE == 1
+#        include "ek_io.h"
+#        if EK_SHELL_ENABLE == 1
+#            include "ek_shell.h"
+#        endif /* EK_SHELL_ENABLE */
+#    endif /* EK_EVOKE_STATS_ENABLE */
+
 EK_LOG_FILE_TAG("ek_evoke.c");
 
 #    define ISR_REQ_PUBLISH       (0x01)
 #    define ISR_REQ_PUBLISH_DEALY (0x02)
 #    define ISR_REQ_BROADCAST     (0x04)
+#    define ISR_REQ_GROUP_SET     (0x08) /* payload 为事件组，delay 为要置位的位 */
+#    define ISR_REQ_CALL          (0x10) /* 在主循环中执行 fn(payload) */
 
 typedef uint8_t _isr_req_type_t;
 
 typedef struct
 {
     _isr_req_type_t type;
-    ek_evoke_event_t *evt;
+    union
+    {
+        ek_evoke_event_t *evt;
+        ek_evoke_call_cb_t fn; /* ISR_REQ_CALL */
+    };
     void *payload;
     uint32_t delay;
 } _isr_req_t;
@@ -33,32 +47,345 @@ typedef struct
 typedef struct
 {
     ek_list_node_t node;
+#    if EK_EVOKE_DEFER_USE_HEAP == 1
+    uint32_t heap_idx;
+#    endif /* EK_EVOKE_DEFER_USE_HEAP */
     ek_evoke_event_t *evt;
+    ek_evoke_task_t *tsk; /* 非 NULL 表示这是任务的等待超时，而不是延迟发布 */
     void *payload;
     uint32_t wakeup_tick;
+    uint32_t period; /* 非 0 表示周期请求，到期后原地重新排队 */
+    uint32_t gen; /* 请求每次归还或被覆盖时加一，与句柄中的代数不同说明句柄已失效 */
+#    if EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_OVERWRITE
+    uint32_t seq;
+#    endif /* EK_EVOKE_OVERFLOW_POLICY */
     bool broadcast;
 } _defer_req_t;
 
 static volatile uint32_t _sleep_lock;
-static volatile uint32_t _event_tick_base;
-static volatile uint32_t _event_tick_diff;
-static volatile uint32_t _defer_earilest_tick;
+static uint32_t _event_now; /* 调度器时间基准，只由睡眠钩子报告的经过时间推进 */
+static uint32_t _timer_xtick; /* 默认睡眠钩子已设置、尚未到期的定时时间 */
 static volatile bool _defer_evt_wakeup;
 
 static _defer_req_t _defer_req_pool[EK_EVOKE_MAX_DEFER_REQ];
 static ek_list_node_t _defer_pool_free_list;
-static ek_ringbuf_spsc_t *_isr_fifo;
+#    if EK_RINGBUF_SPSC_POW2 == 1
+EK_RINGBUF_SPSC_STATIC_DEFINE(_isr_fifo, _isr_req_t, EK_EVOKE_MAX_ISR_REQ);
+#    else
+/* 取模索引要留一个空槽区分满和空，多申请一个槽位才能存下 EK_EVOKE_MAX_ISR_REQ 个请求 */
+EK_RINGBUF_SPSC_STATIC_DEFINE(_isr_fifo, _isr_req_t, EK_EVOKE_MAX_ISR_REQ + 1U);
+#    endif /* EK_RINGBUF_SPSC_POW2 */
+
+static ek_evoke_queue_stats_t _defer_stats;
+static ek_evoke_queue_stats_t _isr_stats;
+#    if EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_OVERWRITE
+static uint32_t _defer_seq;
+#    endif /* EK_EVOKE_OVERFLOW_POLICY */
+
+#    if EK_EVOKE_USE_MEMPOOL == 1
+EK_MEMPOOL_DEFINE(_task_pool, ek_evoke_task_t, EK_EVOKE_TASK_POOL_SIZE);
+EK_MEMPOOL_DEFINE(_event_pool, ek_evoke_event_t, EK_EVOKE_EVENT_POOL_SIZE);
+
+static void *_ek_evoke_obj_alloc(ek_mempool_t *mp, size_t size)
+{
+    void *obj = ek_mempool_alloc(mp);
+    return (obj != NULL) ? obj : ek_malloc(size);
+}
+
+static void _ek_evoke_obj_free(ek_mempool_t *mp, void *obj)
+{
+    if (ek_mempool_contains(mp, obj)) ek_mempool_free(mp, obj);
+    else ek_free(obj);
+}
 
-static ek_list_node_t _ready_task_list;
+#        define _EK_EVOKE_ALLOC(pool, type) ((type *)_ek_evoke_obj_alloc(&(pool), sizeof(type)))
+#        define _EK_EVOKE_FREE(pool, obj)   _ek_evoke_obj_free(&(pool), (obj))
+#    else
+#        define _EK_EVOKE_ALLOC(pool, type) ((type *)ek_malloc(sizeof(type)))
+#        define _EK_EVOKE_FREE(pool, obj)   ek_free(obj)
+#    endif /* EK_EVOKE_USE_MEMPOOL */
+
+static ek_list_node_t _ready_task_list[EK_EVOKE_PRIO_LEVELS];
+static uint32_t _ready_prio_bitmap; /* 第 n 位为 1 表示优先级 n 的就绪链表非空 */
+static ek_evoke_task_t *_running_task;
+static bool _running_destroyed; /* 正在执行的任务在回调中销毁了自己，回调返回后再释放 */
+
+#    if EK_EVOKE_STATS_ENABLE == 1
+static ek_list_node_t _stats_task_list; /* 所有已创建的任务 */
+static uint32_t _stats_last; /* 上一次累加 _stats_elapsed 时的时间 */
+static uint64_t _stats_elapsed;
+static uint64_t _stats_light_sleep;
+static uint64_t _stats_deep_sleep;
+static uint32_t _stats_light_count;
+static uint32_t _stats_deep_count;
+#    endif /* EK_EVOKE_STATS_ENABLE */
+
+#    if EK_EVOKE_DEFER_USE_HEAP == 1
+static _defer_req_t *_defer_heap_storage[EK_EVOKE_MAX_DEFER_REQ];
+static _defer_req_t **_defer_heap = _defer_heap_storage;
+static uint32_t _defer_heap_cap = EK_EVOKE_MAX_DEFER_REQ;
+static uint32_t _defer_heap_len;
+#    else
 static ek_list_node_t _defer_evt_list;
+#    endif /* EK_EVOKE_DEFER_USE_HEAP */
 
 static _defer_req_t *_defer_req_malloc(void);
 static void _defer_req_free(_defer_req_t *req);
+static void _defer_store_init(void);
+static bool _defer_store_reserve(void);
+static void _defer_store_insert(_defer_req_t *req);
+static _defer_req_t *_defer_store_peek(void);
+static void _defer_store_remove(_defer_req_t *req);
+static void _defer_store_cancel(ek_evoke_event_t *evt);
+#    if EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_COALESCE
+static _defer_req_t *_defer_store_find(ek_evoke_event_t *evt, void *payload, bool broadcast);
+#    elif EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_OVERWRITE
+static _defer_req_t *_defer_store_oldest(void);
+#    endif /* EK_EVOKE_OVERFLOW_POLICY */
+
+#    if EK_EVOKE_DEFER_GROW == 1
+__EK_STATIC_INLINE bool _defer_req_in_pool(const _defer_req_t *req)
+{
+    return req >= &_defer_req_pool[0] && req < &_defer_req_pool[EK_EVOKE_MAX_DEFER_REQ];
+}
+#    endif /* EK_EVOKE_DEFER_GROW */
+
+/* 唤醒时间可能回绕，排队请求的唤醒时间与当前时间相差不超过 EK_EVOKE_MAX_DELAY，用有符号差值比较 */
+__EK_STATIC_INLINE bool _defer_before(const _defer_req_t *a, const _defer_req_t *b)
+{
+    return (int32_t)(a->wakeup_tick - b->wakeup_tick) < 0;
+}
+
+#    if EK_EVOKE_STATS_ENABLE == 1
+/* 32 位时钟会回绕，每次取时间时把增量累加到 64 位的运行时间上，主循环每次睡眠前后都会调用 */
+static uint32_t _ek_evoke_stats_now(void)
+{
+    uint32_t now = ek_evoke_stats_clock();
+    _stats_elapsed += (uint32_t)(now - _stats_last);
+    _stats_last = now;
+    return now;
+}
+
+static void _ek_evoke_stats_run(ek_evoke_task_t *tsk, uint32_t latency, uint32_t duration)
+{
+    ek_evoke_task_stats_t *st = &tsk->stats;
+
+    st->run_count++;
+    st->run_total += duration;
+    if (duration > st->run_max) st->run_max = duration;
+
+    st->latency_total += latency;
+    if (latency > st->latency_max) st->latency_max = latency;
+
+    // 第 n 档为 [2^(n-1), 2^n)，即 latency 的有效位数
+    uint32_t bin = (latency == 0) ? 0 : 32U - __EK_CLZ(latency);
+    if (bin >= EK_EVOKE_STATS_HIST_BINS) bin = EK_EVOKE_STATS_HIST_BINS - 1U;
+    st->latency_hist[bin]++;
+}
+#    endif /* EK_EVOKE_STATS_ENABLE */
+
+static void _ek_evoke_timer_cancel(ek_evoke_task_t *tsk)
+{
+    if (tsk->timer == NULL) return;
+
+    _defer_req_t *req = (_defer_req_t *)tsk->timer;
+    _defer_store_remove(req);
+    _defer_req_free(req);
+    tsk->timer = NULL;
+}
+
+static bool _ek_evoke_timer_start(ek_evoke_task_t *tsk, uint32_t timeout)
+{
+    ek_assert_param(timeout <= EK_EVOKE_MAX_DELAY);
+
+    // 超时请求和延迟发布共用请求池，但不参与合并或覆盖
+    _defer_req_t *req = _defer_store_reserve() ? _defer_req_malloc() : NULL;
+    if (req == NULL)
+    {
+        _defer_stats.dropped++;
+        EK_LOG_WARN("the defer request pool is empty, fail to start the timeout of task %s", tsk->name);
+        return false;
+    }
+
+    req->evt = NULL;
+    req->tsk = tsk;
+    req->payload = NULL;
+    req->broadcast = false;
+    req->period = 0;
+    req->wakeup_tick = timeout + _event_now;
+#    if EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_OVERWRITE
+    req->seq = _defer_seq++;
+#    endif /* EK_EVOKE_OVERFLOW_POLICY */
+    _defer_store_insert(req);
+    tsk->timer = req;
+
+    return true;
+}
+
+static void _ek_evoke_ready(ek_evoke_task_t *tsk)
+{
+    ek_list_node_t *head = &_ready_task_list[tsk->prio];
+    ek_list_node_t *pos = head;
+
+    // 事件先于超时到达
+    _ek_evoke_timer_cancel(tsk);
+
+#    if EK_EVOKE_DEADLINE_ENABLE == 1
+    // 有截止时间的任务排在同优先级中截止时间更晚或没有截止时间的任务之前
+    // 只需要越过链表头部有截止时间的任务，没有截止时间的任务直接插到末尾
+    if (tsk->deadline != 0)
+    {
+        tsk->due = ek_evoke_get_tick() + tsk->deadline;
+        ek_list_foreach(pos, head)
+        {
+            ek_evoke_task_t *pos_tsk = ek_list_container(pos, ek_evoke_task_t, node);
+            if (pos_tsk->deadline == 0 || (int32_t)(pos_tsk->due - tsk->due) > 0) break;
+        }
+    }
+#    endif /* EK_EVOKE_DEADLINE_ENABLE */
+
+#    if EK_EVOKE_STATS_ENABLE == 1
+    // 调整优先级时任务重新入队，唤醒延迟仍从第一次就绪开始计算
+    if (tsk->state != EK_EVOKE_STATE_READY) tsk->ready_stamp = ek_evoke_stats_clock();
+#    endif /* EK_EVOKE_STATS_ENABLE */
+
+    ek_list_insert_before(pos, &tsk->node);
+    _ready_prio_bitmap |= (1UL << tsk->prio);
+    tsk->state = EK_EVOKE_STATE_READY;
+}
+
+static void _ek_evoke_unready(ek_evoke_task_t *tsk)
+{
+    ek_list_remove(&tsk->node);
+    if (ek_list_is_empty(&_ready_task_list[tsk->prio])) _ready_prio_bitmap &= ~(1UL << tsk->prio);
+}
+
+/* 把等待中的任务的等待节点从所有事件（或事件组）的等待链表上摘下，O(等待的事件数) */
+static void _ek_evoke_unwait(ek_evoke_task_t *tsk)
+{
+#    if EK_EVOKE_GROUP_ENABLE == 1
+    if (tsk->wait_group != NULL)
+    {
+        ek_list_remove(&tsk->waiters[0].node);
+        return;
+    }
+#    endif /* EK_EVOKE_GROUP_ENABLE */
+    for (uint32_t i = 0; i < tsk->wait_count; i++) ek_list_remove(&tsk->waiters[i].node);
+}
+
+/* 把任务从就绪链表或等待链表中摘下并取消超时，运行中的任务不在任何链表中 */
+static void _ek_evoke_detach(ek_evoke_task_t *tsk)
+{
+    if (tsk->state == EK_EVOKE_STATE_READY) _ek_evoke_unready(tsk);
+    else if (tsk->state == EK_EVOKE_STATE_WAITTING) _ek_evoke_unwait(tsk);
+    _ek_evoke_timer_cancel(tsk);
+}
+
+/* 事件唤醒等待中的任务，evt 记录是哪个事件唤醒的 */
+static void _ek_evoke_wake(ek_evoke_task_t *tsk, ek_evoke_event_t *evt)
+{
+    _ek_evoke_unwait(tsk);
+    tsk->wait_event = evt;
+    _ek_evoke_ready(tsk);
+}
+
+static void _ek_evoke_timeout(ek_evoke_task_t *tsk)
+{
+    tsk->timer = NULL;
+    if (tsk->state == EK_EVOKE_STATE_WAITTING) _ek_evoke_unwait(tsk);
+#    if EK_EVOKE_GROUP_ENABLE == 1
+    if (tsk->wait_group != NULL) tsk->group_bits = tsk->wait_group->bits;
+#    endif /* EK_EVOKE_GROUP_ENABLE */
+    tsk->timed_out = true;
+    _ek_evoke_ready(tsk);
+}
+
+/* 按 waiters 中记录的事件开始等待 */
+static bool _ek_evoke_wait_on(ek_evoke_task_t *tsk, uint32_t timeout)
+{
+    tsk->wait_event = (tsk->wait_count == 1) ? tsk->waiters[0].evt : NULL;
+
+    // 等待的事件中有计数量
+    // 且没有其他任务已经在等待这个事件
+    // 则可以直接减少计数量并且运行任务
+    for (uint32_t i = 0; i < tsk->wait_count; i++)
+    {
+        ek_evoke_event_t *evt = tsk->waiters[i].evt;
+        if (evt->count && ek_list_is_empty(&evt->wait_list))
+        {
+            evt->count--;
+            tsk->wait_event = evt;
+            _ek_evoke_ready(tsk);
+
+            return true;
+        }
+    }
+
+    // 否则说明需要等待事件发布，超时请求启动失败时退化为一直等待
+    for (uint32_t i = 0; i < tsk->wait_count; i++)
+    {
+        ek_list_insert_tail(&tsk->waiters[i].evt->wait_list, &tsk->waiters[i].node);
+    }
+    tsk->state = EK_EVOKE_STATE_WAITTING;
+    if (timeout != 0) _ek_evoke_timer_start(tsk, timeout);
+
+    return false;
+}
 
-__EK_STATIC_INLINE void _ek_evoke_set_timer(uint32_t xtick)
+/* 回调中没有重新指定等待对象时，继续等待原来的事件（或事件组） */
+static void _ek_evoke_rearm(ek_evoke_task_t *tsk)
 {
-    ek_evoke_set_timer(xtick);
-    _event_tick_diff = xtick;
+#    if EK_EVOKE_GROUP_ENABLE == 1
+    if (tsk->wait_group != NULL)
+    {
+        ek_evoke_group_wait(tsk, tsk->wait_group, tsk->group_mask, tsk->group_flags, 0);
+        return;
+    }
+#    endif /* EK_EVOKE_GROUP_ENABLE */
+    if (tsk->wait_count == 0)
+    {
+        tsk->state = EK_EVOKE_STATE_IDLE;
+        return;
+    }
+    tsk->timed_out = false;
+    _ek_evoke_wait_on(tsk, 0);
+}
+
+static void _ek_evoke_sleep(uint32_t xtick)
+{
+    bool light = (_sleep_lock != 0);
+#    if EK_EVOKE_STATS_ENABLE == 1
+    uint32_t start = _ek_evoke_stats_now();
+#    endif /* EK_EVOKE_STATS_ENABLE */
+
+    // 时间只在这里推进，提前唤醒时报告的是实际经过的时间，下一次按剩余时间重新设置定时器
+    _event_now += ek_evoke_sleep(xtick, !light);
+
+#    if EK_EVOKE_STATS_ENABLE == 1
+    uint32_t slept = _ek_evoke_stats_now() - start;
+    if (light)
+    {
+        _stats_light_sleep += slept;
+        _stats_light_count++;
+    }
+    else
+    {
+        _stats_deep_sleep += slept;
+        _stats_deep_count++;
+    }
+#    endif /* EK_EVOKE_STATS_ENABLE */
+}
+
+static ek_evoke_task_t *_ek_evoke_ready_pop(void)
+{
+    if (_ready_prio_bitmap == 0) return NULL;
+
+    // 最高的置位即最高的就绪优先级，O(1)
+    uint32_t prio = 31U - __EK_CLZ(_ready_prio_bitmap);
+    ek_evoke_task_t *tsk = ek_list_container(ek_list_get_first(&_ready_task_list[prio]), ek_evoke_task_t, node);
+    _ek_evoke_unready(tsk);
+
+    return tsk;
 }
 
 void ek_evoke_sleep_lock(void)
@@ -75,28 +402,51 @@ void ek_evoke_sleep_unlock(void)
 void ek_evoke_delay_timer_callback(void)
 {
     _defer_evt_wakeup = true;
-    _event_tick_base += _event_tick_diff;
-    _event_tick_diff = 0;
 }
 
 void ek_evoke_init(void)
 {
-    ek_list_init(&_ready_task_list);
-    ek_list_init(&_defer_evt_list);
+    for (size_t i = 0; i < EK_EVOKE_PRIO_LEVELS; i++)
+    {
+        ek_list_init(&_ready_task_list[i]);
+    }
+    _ready_prio_bitmap = 0;
+#    if EK_EVOKE_DEFER_GROW == 1
+    // 从堆中扩展出的请求用完后留在空闲链表中，重新初始化时归还到堆
+    if (_defer_pool_free_list.next != NULL)
+    {
+        ek_list_node_t *pos, *n;
+        ek_list_foreach_safe(pos, n, &_defer_pool_free_list)
+        {
+            _defer_req_t *req = ek_list_container(pos, _defer_req_t, node);
+            if (!_defer_req_in_pool(req)) ek_free(req);
+        }
+    }
+#    endif /* EK_EVOKE_DEFER_GROW */
     ek_list_init(&_defer_pool_free_list);
+    _defer_store_init();
 
     for (size_t i = 0; i < EK_EVOKE_MAX_DEFER_REQ; i++)
     {
+        // 让初始化前发出的句柄全部失效
+        _defer_req_pool[i].gen++;
         ek_list_insert_tail(&_defer_pool_free_list, &_defer_req_pool[i].node);
     }
 
-    _isr_fifo = ek_ringbuf_create_spsc(sizeof(_isr_req_t), EK_EVOKE_MAX_ISR_REQ);
-    ek_assert_param(_isr_fifo != NULL);
+    memset(&_defer_stats, 0, sizeof(_defer_stats));
+    memset(&_isr_stats, 0, sizeof(_isr_stats));
+    _defer_stats.capacity = EK_EVOKE_MAX_DEFER_REQ;
+    _isr_stats.capacity = ek_ringbuf_count_spsc(&_isr_fifo) + ek_ringbuf_space_spsc(&_isr_fifo);
 
-    _defer_earilest_tick = UINT32_MAX;
-    _event_tick_base = 0;
+    _event_now = EK_EVOKE_TICK_INIT;
+    _timer_xtick = EK_EVOKE_TICK_FOREVER;
     _sleep_lock = 0;
     _defer_evt_wakeup = false;
+
+#    if EK_EVOKE_STATS_ENABLE == 1
+    ek_list_init(&_stats_task_list);
+    ek_evoke_stats_reset();
+#    endif /* EK_EVOKE_STATS_ENABLE */
 }
 
 EK_EXPORT_COMPONENTS(ek_evoke_init);
@@ -105,7 +455,7 @@ ek_evoke_task_handle_t ek_evoke_task_create(const char *name, ek_evoke_cb_t cb,
 {
     ek_assert_param(cb != NULL);
 
-    ek_evoke_task_t *tsk = ek_malloc(sizeof(*tsk));
+    ek_evoke_task_t *tsk = _EK_EVOKE_ALLOC(_task_pool, ek_evoke_task_t);
     ek_assert_param(tsk != NULL);
 
     ek_list_init(&tsk->node);
@@ -114,6 +464,33 @@ ek_evoke_task_handle_t ek_evoke_task_create(const char *name, ek_evoke_cb_t cb,
     tsk->arg = arg;
     tsk->state = EK_EVOKE_STATE_IDLE;
     tsk->wait_event = NULL;
+    for (size_t i = 0; i < EK_EVOKE_WAIT_ANY_MAX; i++)
+    {
+        ek_list_init(&tsk->waiters[i].node);
+        tsk->waiters[i].tsk = tsk;
+        tsk->waiters[i].evt = NULL;
+    }
+    tsk->wait_count = 0;
+    tsk->timer = NULL;
+    tsk->timed_out = false;
+    tsk->co_line = 0;
+    tsk->prio = 0;
+#    if EK_EVOKE_GROUP_ENABLE == 1
+    tsk->wait_group = NULL;
+    tsk->group_mask = 0;
+    tsk->group_flags = 0;
+    tsk->group_bits = 0;
+#    endif /* EK_EVOKE_GROUP_ENABLE */
+#    if EK_EVOKE_DEADLINE_ENABLE == 1
+    tsk->deadline = 0;
+    tsk->due = 0;
+    tsk->deadline_miss = 0;
+#    endif /* EK_EVOKE_DEADLINE_ENABLE */
+#    if EK_EVOKE_STATS_ENABLE == 1
+    tsk->ready_stamp = 0;
+    memset(&tsk->stats, 0, sizeof(tsk->stats));
+    ek_list_insert_tail(&_stats_task_list, &tsk->stats_node);
+#    endif /* EK_EVOKE_STATS_ENABLE */
 
     return tsk;
 }
@@ -121,16 +498,116 @@ ek_evoke_task_handle_t ek_evoke_task_create(const char *name, ek_evoke_cb_t cb,
 void ek_evoke_task_destroy(ek_evoke_task_handle_t tsk)
 {
     ek_assert_param(tsk != NULL);
-    if (tsk->state != EK_EVOKE_STATE_IDLE)
+    _ek_evoke_detach(tsk);
+#    if EK_EVOKE_STATS_ENABLE == 1
+    ek_list_remove(&tsk->stats_node);
+#    endif /* EK_EVOKE_STATS_ENABLE */
+
+    // 回调返回后主循环还要访问任务，推迟到那时释放
+    if (tsk == _running_task)
+    {
+        tsk->state = EK_EVOKE_STATE_IDLE;
+        _running_destroyed = true;
+        return;
+    }
+    _EK_EVOKE_FREE(_task_pool, tsk);
+}
+
+bool ek_evoke_task_await(ek_evoke_task_handle_t tsk, ek_evoke_event_handle_t evt, uint32_t timeout)
+{
+    ek_assert_param(tsk != NULL);
+
+    _ek_evoke_detach(tsk);
+    tsk->timed_out = false;
+#    if EK_EVOKE_GROUP_ENABLE == 1
+    tsk->wait_group = NULL;
+#    endif /* EK_EVOKE_GROUP_ENABLE */
+
+    if (evt == NULL)
+    {
+        // 纯延时，0 表示让出一次
+        tsk->wait_event = NULL;
+        tsk->wait_count = 0;
+        tsk->state = EK_EVOKE_STATE_DELAY;
+        if (timeout != 0 && _ek_evoke_timer_start(tsk, timeout)) return false;
+
+        tsk->timed_out = (timeout != 0);
+        _ek_evoke_ready(tsk);
+        return true;
+    }
+
+    tsk->waiters[0].evt = evt;
+    tsk->wait_count = 1;
+    return _ek_evoke_wait_on(tsk, timeout);
+}
+
+bool ek_evoke_task_await_any(ek_evoke_task_handle_t tsk,
+                             ek_evoke_event_handle_t const evts[],
+                             uint32_t amount,
+                             uint32_t timeout)
+{
+    ek_assert_param(tsk != NULL);
+    ek_assert_param(evts != NULL);
+    ek_assert_param(amount >= 1 && amount <= EK_EVOKE_WAIT_ANY_MAX);
+
+    _ek_evoke_detach(tsk);
+    tsk->timed_out = false;
+#    if EK_EVOKE_GROUP_ENABLE == 1
+    tsk->wait_group = NULL;
+#    endif /* EK_EVOKE_GROUP_ENABLE */
+
+    for (uint32_t i = 0; i < amount; i++)
+    {
+        ek_assert_param(evts[i] != NULL);
+        tsk->waiters[i].evt = evts[i];
+    }
+    tsk->wait_count = (uint8_t)amount;
+    return _ek_evoke_wait_on(tsk, timeout);
+}
+
+void ek_evoke_task_stop(ek_evoke_task_handle_t tsk)
+{
+    ek_assert_param(tsk != NULL);
+
+    _ek_evoke_detach(tsk);
+    tsk->state = EK_EVOKE_STATE_IDLE;
+    tsk->co_line = 0;
+}
+
+ek_evoke_task_handle_t ek_evoke_task_self(void)
+{
+    return _running_task;
+}
+
+void ek_evoke_task_set_priority(ek_evoke_task_handle_t tsk, uint8_t prio)
+{
+    ek_assert_param(tsk != NULL);
+    ek_assert_param(prio < EK_EVOKE_PRIO_LEVELS);
+
+    if (tsk->state == EK_EVOKE_STATE_READY)
     {
-        ek_list_remove(&tsk->node);
+        _ek_evoke_unready(tsk);
+        tsk->prio = prio;
+        _ek_evoke_ready(tsk);
+    }
+    else
+    {
+        tsk->prio = prio;
     }
-    ek_free(tsk);
 }
 
+#    if EK_EVOKE_DEADLINE_ENABLE == 1
+void ek_evoke_task_set_deadline(ek_evoke_task_handle_t tsk, uint32_t deadline)
+{
+    ek_assert_param(tsk != NULL);
+
+    tsk->deadline = deadline;
+}
+#    endif /* EK_EVOKE_DEADLINE_ENABLE */
+
 ek_evoke_event_handle_t ek_evoke_event_create(const char *name, uint32_t init)
 {
-    ek_evoke_event_t *evt = ek_malloc(sizeof(*evt));
+    ek_evoke_event_t *evt = _EK_EVOKE_ALLOC(_event_pool, ek_evoke_event_t);
     ek_assert_param(evt != NULL);
 
     ek_list_init(&evt->wait_list);
@@ -147,12 +624,14 @@ void ek_evoke_event_destroy(ek_evoke_event_handle_t evt)
     while (!ek_list_is_empty(&evt->wait_list))
     {
         ek_list_node_t *node = ek_list_get_first(&evt->wait_list);
-        ek_evoke_task_t *tsk = ek_list_container(node, ek_evoke_task_t, node);
-        ek_list_remove(&tsk->node);
+        ek_evoke_task_t *tsk = ek_list_container(node, ek_evoke_waiter_t, node)->tsk;
+        _ek_evoke_detach(tsk);
         tsk->wait_event = NULL;
+        tsk->wait_count = 0;
         tsk->state = EK_EVOKE_STATE_IDLE;
     }
-    ek_free(evt);
+    _defer_store_cancel(evt);
+    _EK_EVOKE_FREE(_event_pool, evt);
 }
 
 bool ek_evoke_event_subscribe(ek_evoke_task_handle_t tsk, ek_evoke_event_handle_t evt)
@@ -160,24 +639,12 @@ bool ek_evoke_event_subscribe(ek_evoke_task_handle_t tsk, ek_evoke_event_handle_
     ek_assert_param(tsk != NULL);
     ek_assert_param(evt != NULL);
 
-    tsk->wait_event = evt;
-    // 等待的事件中有计数量
-    // 且没有其他任务已经在等待这个事件
-    // 则可以直接减少计数量并且运行任务
-    if (evt->count && ek_list_is_empty(&evt->wait_list))
-    {
-        evt->count--;
-        ek_list_insert_tail(&_ready_task_list, &tsk->node);
-        tsk->state = EK_EVOKE_STATE_READY;
-
-        return true;
-    }
-
-    // 否则说明需要等待事件发布
-    ek_list_insert_tail(&evt->wait_list, &tsk->node);
-    tsk->state = EK_EVOKE_STATE_WAITTING;
+    return ek_evoke_task_await(tsk, evt, 0);
+}
 
-    return false;
+bool ek_evoke_event_subscribe_any(ek_evoke_task_handle_t tsk, ek_evoke_event_handle_t const evts[], uint32_t amount)
+{
+    return ek_evoke_task_await_any(tsk, evts, amount, 0);
 }
 
 void ek_evoke_event_broadcast(ek_evoke_event_handle_t evt, void *payload)
@@ -197,10 +664,7 @@ void ek_evoke_event_broadcast(ek_evoke_event_handle_t evt, void *payload)
     while (!ek_list_is_empty(&evt->wait_list))
     {
         ek_list_node_t *node = ek_list_get_first(&evt->wait_list);
-        ek_evoke_task_t *tsk = ek_list_container(node, ek_evoke_task_t, node);
-        ek_list_remove(node);
-        ek_list_insert_tail(&_ready_task_list, node);
-        tsk->state = EK_EVOKE_STATE_READY;
+        _ek_evoke_wake(ek_list_container(node, ek_evoke_waiter_t, node)->tsk, evt);
     }
 }
 
@@ -213,10 +677,7 @@ void ek_evoke_event_publish(ek_evoke_event_handle_t evt, void *payload)
     if (!ek_list_is_empty(&evt->wait_list))
     {
         ek_list_node_t *node = ek_list_get_first(&evt->wait_list);
-        ek_evoke_task_t *tsk = ek_list_container(node, ek_evoke_task_t, node);
-        ek_list_remove(node);
-        ek_list_insert_tail(&_ready_task_list, node);
-        tsk->state = EK_EVOKE_STATE_READY;
+        _ek_evoke_wake(ek_list_container(node, ek_evoke_waiter_t, node)->tsk, evt);
 
         return;
     }
@@ -225,76 +686,201 @@ void ek_evoke_event_publish(ek_evoke_event_handle_t evt, void *payload)
     evt->count++;
 }
 
-void ek_evoke_event_defer(ek_evoke_event_handle_t evt, void *payload, uint32_t delay, bool broadcast)
+__EK_STATIC_INLINE ek_evoke_defer_t _defer_handle(_defer_req_t *req)
 {
-    ek_assert_param(evt != NULL);
+    ek_evoke_defer_t handle = { req, (req != NULL) ? req->gen : 0 };
+    return handle;
+}
 
-    if (!delay)
+/* 句柄仍指向排队中的同一个请求时返回该请求，否则返回 NULL */
+static _defer_req_t *_defer_handle_get(ek_evoke_defer_t handle)
+{
+    _defer_req_t *req = (_defer_req_t *)handle.req;
+    if (req == NULL || req->gen != handle.gen) return NULL;
+    return req;
+}
+
+static ek_evoke_defer_t _ek_evoke_defer_submit(ek_evoke_event_t *evt, void *payload, uint32_t delay, uint32_t period,
+                                               bool broadcast)
+{
+    _defer_req_t *req = _defer_store_reserve() ? _defer_req_malloc() : NULL;
+    if (req == NULL)
     {
-        if (broadcast) return ek_evoke_event_broadcast(evt, payload);
-        else return ek_evoke_event_publish(evt, payload);
+#    if EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_COALESCE
+        // 已有相同的请求在等待，合并到它上面，返回的句柄指向已有的请求
+        // 周期请求不参与合并
+        req = (period == 0) ? _defer_store_find(evt, payload, broadcast) : NULL;
+        if (req != NULL)
+        {
+            _defer_stats.coalesced++;
+            return _defer_handle(req);
+        }
+#    elif EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_OVERWRITE
+        // 牺牲最早提交的请求，把它的位置让给新请求，任务的等待超时和周期请求不会被覆盖
+        req = _defer_store_oldest();
+        if (req != NULL)
+        {
+            _defer_store_remove(req);
+            req->gen++;
+            _defer_stats.overwritten++;
+        }
+#    endif /* EK_EVOKE_OVERFLOW_POLICY */
     }
-
-    _defer_req_t *req = _defer_req_malloc();
     if (req == NULL)
     {
+        _defer_stats.dropped++;
         EK_LOG_WARN("the defer request pool is empty, fail to create a defer request");
-        return;
+        return EK_EVOKE_DEFER_NONE;
     }
-    uint32_t wakeup_tick = delay + _event_tick_base;
 
     req->evt = evt;
+    req->tsk = NULL;
     req->broadcast = broadcast;
     req->payload = payload;
-    req->wakeup_tick = wakeup_tick;
+    req->period = period;
+    req->wakeup_tick = delay + _event_now;
+#    if EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_OVERWRITE
+    req->seq = _defer_seq++;
+#    endif /* EK_EVOKE_OVERFLOW_POLICY */
+
+    _defer_store_insert(req);
+    return _defer_handle(req);
+}
 
-    ek_list_node_t *pos;
-    ek_list_foreach(pos, &_defer_evt_list)
+ek_evoke_defer_t ek_evoke_event_defer(ek_evoke_event_handle_t evt, void *payload, uint32_t delay, bool broadcast)
+{
+    ek_assert_param(evt != NULL);
+    ek_assert_param(delay <= EK_EVOKE_MAX_DELAY);
+
+    if (!delay)
     {
-        _defer_req_t *pos_req = ek_list_container(pos, _defer_req_t, node);
-        if (pos_req->wakeup_tick >= wakeup_tick) break;
+        if (broadcast) ek_evoke_event_broadcast(evt, payload);
+        else ek_evoke_event_publish(evt, payload);
+        return EK_EVOKE_DEFER_NONE;
     }
-    ek_list_insert_before(pos, &req->node);
+
+    return _ek_evoke_defer_submit(evt, payload, delay, 0, broadcast);
 }
 
-void ek_evoke_event_broadcast_from_isr(ek_evoke_event_handle_t evt, void *payload)
+ek_evoke_defer_t ek_evoke_event_defer_periodic(ek_evoke_event_handle_t evt, void *payload, uint32_t period,
+                                               bool broadcast)
 {
     ek_assert_param(evt != NULL);
+    ek_assert_param(period != 0 && period <= EK_EVOKE_MAX_DELAY);
+
+    return _ek_evoke_defer_submit(evt, payload, period, period, broadcast);
+}
+
+bool ek_evoke_defer_cancel(ek_evoke_defer_t handle)
+{
+    _defer_req_t *req = _defer_handle_get(handle);
+    if (req == NULL) return false;
 
+    _defer_store_remove(req);
+    _defer_req_free(req);
+    return true;
+}
+
+bool ek_evoke_defer_restart(ek_evoke_defer_t handle, uint32_t delay)
+{
+    ek_assert_param(delay <= EK_EVOKE_MAX_DELAY);
+
+    _defer_req_t *req = _defer_handle_get(handle);
+    if (req == NULL) return false;
+
+    // 请求原地重新排队，不经过请求池
+    _defer_store_remove(req);
+    req->wakeup_tick = delay + _event_now;
+#    if EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_OVERWRITE
+    req->seq = _defer_seq++;
+#    endif /* EK_EVOKE_OVERFLOW_POLICY */
+    _defer_store_insert(req);
+    return true;
+}
+
+bool ek_evoke_defer_pending(ek_evoke_defer_t handle)
+{
+    return _defer_handle_get(handle) != NULL;
+}
+
+#    if EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_COALESCE
+static bool _isr_req_coalesce(const _isr_req_t *req)
+{
+    // 在中断上下文中只读遍历队列，主循环无法在此期间取走请求
+    ek_ringbuf_span_t span[2];
+    ek_ringbuf_acquire_read_spsc(&_isr_fifo, span, UINT32_MAX);
+    for (uint32_t s = 0; s < 2; s++)
+    {
+        const _isr_req_t *items = (const _isr_req_t *)span[s].buf;
+        for (uint32_t i = 0; i < span[s].amount; i++)
+        {
+            if (items[i].type != req->type || items[i].payload != req->payload || items[i].delay != req->delay)
+            {
+                continue;
+            }
+            if ((req->type == ISR_REQ_CALL) ? (items[i].fn == req->fn) : (items[i].evt == req->evt))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+#    endif /* EK_EVOKE_OVERFLOW_POLICY */
+
+static void _isr_req_post(const _isr_req_t *req)
+{
     ek_evoke_enter_critical();
 
+    if (!ek_ringbuf_write_spsc(&_isr_fifo, req))
+    {
+#    if EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_COALESCE
+        if (_isr_req_coalesce(req)) _isr_stats.coalesced++;
+        else _isr_stats.dropped++;
+#    elif EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_OVERWRITE
+        // 主循环在临界区内读取队列，这里可以安全地丢弃队首
+        ek_ringbuf_read_spsc(&_isr_fifo, NULL);
+        ek_ringbuf_write_spsc(&_isr_fifo, req);
+        _isr_stats.overwritten++;
+#    else
+        _isr_stats.dropped++;
+#    endif /* EK_EVOKE_OVERFLOW_POLICY */
+    }
+
+    uint32_t used = ek_ringbuf_count_spsc(&_isr_fifo);
+    if (used > _isr_stats.peak) _isr_stats.peak = used;
+
+    ek_evoke_exit_critical();
+}
+
+void ek_evoke_event_broadcast_from_isr(ek_evoke_event_handle_t evt, void *payload)
+{
+    ek_assert_param(evt != NULL);
+
     _isr_req_t req = {
         .type = ISR_REQ_BROADCAST,
         .evt = evt,
         .payload = payload,
     };
-    ek_ringbuf_write_spsc(_isr_fifo, &req);
-
-    ek_evoke_exit_critical();
+    _isr_req_post(&req);
 }
 
 void ek_evoke_event_publish_from_isr(ek_evoke_event_handle_t evt, void *payload)
 {
     ek_assert_param(evt != NULL);
 
-    ek_evoke_enter_critical();
-
     _isr_req_t req = {
         .type = ISR_REQ_PUBLISH,
         .evt = evt,
         .payload = payload,
     };
-    ek_ringbuf_write_spsc(_isr_fifo, &req);
-
-    ek_evoke_exit_critical();
+    _isr_req_post(&req);
 }
 
 void ek_evoke_event_defer_from_isr(ek_evoke_event_handle_t evt, void *payload, uint32_t delay, bool broadcast)
 {
     ek_assert_param(evt != NULL);
 
-    ek_evoke_enter_critical();
-
     _isr_req_t req = {
         .type = (broadcast == true) ? (ISR_REQ_PUBLISH_DEALY | ISR_REQ_BROADCAST)
                                     : (ISR_REQ_PUBLISH_DEALY | ISR_REQ_PUBLISH),
@@ -302,110 +888,661 @@ void ek_evoke_event_defer_from_isr(ek_evoke_event_handle_t evt, void *payload, u
         .payload = payload,
         .delay = delay,
     };
-    ek_ringbuf_write_spsc(_isr_fifo, &req);
+    _isr_req_post(&req);
+}
+
+#    if EK_EVOKE_GROUP_ENABLE == 1
+static bool _ek_evoke_group_match(const ek_evoke_task_t *tsk, uint32_t bits)
+{
+    uint32_t hit = bits & tsk->group_mask;
+    return (tsk->group_flags & EK_EVOKE_GROUP_WAIT_ALL) ? (hit == tsk->group_mask) : (hit != 0);
+}
+
+ek_evoke_group_handle_t ek_evoke_group_create(const char *name)
+{
+    ek_evoke_group_t *grp = (ek_evoke_group_t *)ek_malloc(sizeof(ek_evoke_group_t));
+    ek_assert_param(grp != NULL);
+
+    ek_list_init(&grp->wait_list);
+    grp->name = name;
+    grp->bits = 0;
 
+    return grp;
+}
+
+void ek_evoke_group_destroy(ek_evoke_group_handle_t grp)
+{
+    ek_assert_param(grp != NULL);
+    while (!ek_list_is_empty(&grp->wait_list))
+    {
+        ek_list_node_t *node = ek_list_get_first(&grp->wait_list);
+        ek_evoke_task_t *tsk = ek_list_container(node, ek_evoke_waiter_t, node)->tsk;
+        _ek_evoke_detach(tsk);
+        tsk->wait_group = NULL;
+        tsk->state = EK_EVOKE_STATE_IDLE;
+    }
+    ek_free(grp);
+}
+
+uint32_t ek_evoke_group_set(ek_evoke_group_handle_t grp, uint32_t bits)
+{
+    ek_assert_param(grp != NULL);
+
+    grp->bits |= bits;
+
+    // 所有等待者都按置位后的同一个值判断，需要清除的位在最后统一清除
+    uint32_t clear = 0;
+    ek_list_node_t *pos, *n;
+    ek_list_foreach_safe(pos, n, &grp->wait_list)
+    {
+        ek_evoke_task_t *tsk = ek_list_container(pos, ek_evoke_waiter_t, node)->tsk;
+        if (!_ek_evoke_group_match(tsk, grp->bits)) continue;
+
+        tsk->group_bits = grp->bits;
+        if (tsk->group_flags & EK_EVOKE_GROUP_CLEAR) clear |= tsk->group_mask;
+        _ek_evoke_wake(tsk, NULL);
+    }
+    grp->bits &= ~clear;
+
+    return grp->bits;
+}
+
+uint32_t ek_evoke_group_clear(ek_evoke_group_handle_t grp, uint32_t bits)
+{
+    ek_assert_param(grp != NULL);
+
+    uint32_t old = grp->bits;
+    grp->bits &= ~bits;
+    return old;
+}
+
+uint32_t ek_evoke_group_get(ek_evoke_group_handle_t grp)
+{
+    ek_assert_param(grp != NULL);
+
+    return grp->bits;
+}
+
+bool ek_evoke_group_wait(ek_evoke_task_handle_t tsk,
+                         ek_evoke_group_handle_t grp,
+                         uint32_t mask,
+                         uint8_t flags,
+                         uint32_t timeout)
+{
+    ek_assert_param(tsk != NULL);
+    ek_assert_param(grp != NULL);
+    ek_assert_param(mask != 0);
+
+    _ek_evoke_detach(tsk);
+    tsk->timed_out = false;
+    tsk->wait_event = NULL;
+    tsk->wait_count = 0;
+    tsk->wait_group = grp;
+    tsk->group_mask = mask;
+    tsk->group_flags = flags;
+
+    if (_ek_evoke_group_match(tsk, grp->bits))
+    {
+        tsk->group_bits = grp->bits;
+        if (flags & EK_EVOKE_GROUP_CLEAR) grp->bits &= ~mask;
+        _ek_evoke_ready(tsk);
+
+        return true;
+    }
+
+    // 事件组上只挂一个等待节点，超时请求启动失败时退化为一直等待
+    ek_list_insert_tail(&grp->wait_list, &tsk->waiters[0].node);
+    tsk->state = EK_EVOKE_STATE_WAITTING;
+    if (timeout != 0) _ek_evoke_timer_start(tsk, timeout);
+
+    return false;
+}
+
+void ek_evoke_group_set_from_isr(ek_evoke_group_handle_t grp, uint32_t bits)
+{
+    ek_assert_param(grp != NULL);
+
+    _isr_req_t req = {
+        .type = ISR_REQ_GROUP_SET,
+        .payload = grp,
+        .delay = bits,
+    };
+    _isr_req_post(&req);
+}
+#    endif /* EK_EVOKE_GROUP_ENABLE */
+
+void ek_evoke_call_from_isr(ek_evoke_call_cb_t fn, void *arg)
+{
+    ek_assert_param(fn != NULL);
+
+    _isr_req_t req = {
+        .type = ISR_REQ_CALL,
+        .fn = fn,
+        .payload = arg,
+    };
+    _isr_req_post(&req);
+}
+
+void ek_evoke_defer_stats(ek_evoke_queue_stats_t *stats)
+{
+    ek_assert_param(stats != NULL);
+
+    *stats = _defer_stats;
+}
+
+void ek_evoke_isr_stats(ek_evoke_queue_stats_t *stats)
+{
+    ek_assert_param(stats != NULL);
+
+    ek_evoke_enter_critical();
+    *stats = _isr_stats;
+    stats->used = ek_ringbuf_count_spsc(&_isr_fifo);
     ek_evoke_exit_critical();
 }
 
-void ek_evoke_event_loop(void)
+#    if EK_EVOKE_STATS_ENABLE == 1
+void ek_evoke_task_stats(ek_evoke_task_handle_t tsk, ek_evoke_task_stats_t *stats)
 {
-    while (1)
+    ek_assert_param(tsk != NULL);
+    ek_assert_param(stats != NULL);
+
+    *stats = tsk->stats;
+}
+
+void ek_evoke_loop_stats(ek_evoke_loop_stats_t *stats)
+{
+    ek_assert_param(stats != NULL);
+
+    ek_evoke_queue_stats_t isr;
+    ek_evoke_isr_stats(&isr);
+    _ek_evoke_stats_now();
+
+    stats->elapsed = _stats_elapsed;
+    stats->light_sleep = _stats_light_sleep;
+    stats->deep_sleep = _stats_deep_sleep;
+    stats->busy = _stats_elapsed - _stats_light_sleep - _stats_deep_sleep;
+    stats->light_count = _stats_light_count;
+    stats->deep_count = _stats_deep_count;
+    stats->isr_depth = isr.used;
+    stats->isr_peak = isr.peak;
+    stats->defer_len = _defer_stats.used;
+    stats->defer_peak = _defer_stats.peak;
+}
+
+void ek_evoke_stats_reset(void)
+{
+    ek_list_node_t *pos;
+    ek_list_foreach(pos, &_stats_task_list)
+    {
+        ek_evoke_task_t *tsk = ek_list_container(pos, ek_evoke_task_t, stats_node);
+        memset(&tsk->stats, 0, sizeof(tsk->stats));
+    }
+
+    _stats_last = ek_evoke_stats_clock();
+    _stats_elapsed = 0;
+    _stats_light_sleep = 0;
+    _stats_deep_sleep = 0;
+    _stats_light_count = 0;
+    _stats_deep_count = 0;
+}
+
+/* 千分比，打印成一位小数的百分比 */
+static unsigned long _ek_evoke_permille(uint64_t part, uint64_t whole)
+{
+    return (whole != 0) ? (unsigned long)(part * 1000U / whole) : 0UL;
+}
+
+void ek_evoke_top(void)
+{
+    ek_evoke_loop_stats_t loop;
+    ek_evoke_loop_stats(&loop);
+
+    unsigned long busy = _ek_evoke_permille(loop.busy, loop.elapsed);
+    unsigned long light = _ek_evoke_permille(loop.light_sleep, loop.elapsed);
+    unsigned long deep = _ek_evoke_permille(loop.deep_sleep, loop.elapsed);
+    ek_printf("evoke: elapsed %lu, busy %lu.%lu%%, light sleep %lu.%lu%% (%lu), deep sleep %lu.%lu%% (%lu)" CRLF,
+              (unsigned long)loop.elapsed,
+              busy / 10UL,
+              busy % 10UL,
+              light / 10UL,
+              light % 10UL,
+              (unsigned long)loop.light_count,
+              deep / 10UL,
+              deep % 10UL,
+              (unsigned long)loop.deep_count);
+    ek_printf("       isr fifo %lu (peak %lu), defer %lu (peak %lu)" CRLF,
+              (unsigned long)loop.isr_depth,
+              (unsigned long)loop.isr_peak,
+              (unsigned long)loop.defer_len,
+              (unsigned long)loop.defer_peak);
+
+    ek_printf("  task             prio     runs   cpu%%   run avg   run max   lat avg   lat max" CRLF);
+    ek_list_node_t *pos;
+    ek_list_foreach(pos, &_stats_task_list)
+    {
+        ek_evoke_task_t *tsk = ek_list_container(pos, ek_evoke_task_t, stats_node);
+        const ek_evoke_task_stats_t *st = &tsk->stats;
+        unsigned long cpu = _ek_evoke_permille(st->run_total, loop.elapsed);
+        unsigned long run_avg = (st->run_count != 0) ? (unsigned long)(st->run_total / st->run_count) : 0UL;
+        unsigned long lat_avg = (st->run_count != 0) ? (unsigned long)(st->latency_total / st->run_count) : 0UL;
+        ek_printf("  %-16s %4u %8lu %4lu.%lu %9lu %9lu %9lu %9lu" CRLF,
+                  (tsk->name != NULL) ? tsk->name : "?",
+                  (unsigned)tsk->prio,
+                  (unsigned long)st->run_count,
+                  cpu / 10UL,
+                  cpu % 10UL,
+                  run_avg,
+                  (unsigned long)st->run_max,
+                  lat_avg,
+                  (unsigned long)st->latency_max);
+    }
+}
+
+#        if EK_SHELL_ENABLE == 1
+static int _ek_evoke_shell(const char *sub)
+{
+    if (sub == NULL || strcmp(sub, "top") == 0) ek_evoke_top();
+    else if (strcmp(sub, "reset") == 0) ek_evoke_stats_reset();
+    else ek_printf("usage: evoke top|reset" CRLF);
+    return 0;
+}
+
+EK_SHELL_EXPORT_CMD(evoke, _ek_evoke_shell, evoke top : show task stats / evoke reset : clear stats);
+#        endif /* EK_SHELL_ENABLE */
+#    endif /* EK_EVOKE_STATS_ENABLE */
+
+/* 执行一轮主循环，睡眠时间不超过 limit；执行了一个任务回调时返回 true */
+static bool _ek_evoke_step(uint32_t limit)
+{
+    // 先处理是否有来自中断的请求
+    // 从中断请求fifo中读取
+    while (!ek_ringbuf_empty_spsc(&_isr_fifo))
     {
-        // 先处理是否有来自中断的请求
-        // 从中断请求fifo中读取
-        while (!ek_ringbuf_empty_spsc(_isr_fifo))
+        _isr_req_t req = { 0 };
+#    if EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_OVERWRITE
+        // 中断可能在满时丢弃队首，读取必须和它互斥
+        ek_evoke_enter_critical();
+        bool got = ek_ringbuf_read_spsc(&_isr_fifo, &req);
+        ek_evoke_exit_critical();
+#    else
+        bool got = ek_ringbuf_read_spsc(&_isr_fifo, &req);
+#    endif /* EK_EVOKE_OVERFLOW_POLICY */
+        if (got)
         {
-            _isr_req_t req = { 0 };
-            if (ek_ringbuf_read_spsc(_isr_fifo, &req))
+            if (req.type & ISR_REQ_PUBLISH)
             {
-                if (req.type & ISR_REQ_PUBLISH)
-                {
-                    if (req.type & ISR_REQ_PUBLISH_DEALY) ek_evoke_event_defer(req.evt, req.payload, req.delay, false);
-                    else ek_evoke_event_publish(req.evt, req.payload);
-                }
-                else if (req.type & ISR_REQ_BROADCAST)
-                {
-                    if (req.type & ISR_REQ_PUBLISH_DEALY) ek_evoke_event_defer(req.evt, req.payload, req.delay, true);
-                    else ek_evoke_event_broadcast(req.evt, req.payload);
-                }
+                if (req.type & ISR_REQ_PUBLISH_DEALY) ek_evoke_event_defer(req.evt, req.payload, req.delay, false);
+                else ek_evoke_event_publish(req.evt, req.payload);
+            }
+            else if (req.type & ISR_REQ_BROADCAST)
+            {
+                if (req.type & ISR_REQ_PUBLISH_DEALY) ek_evoke_event_defer(req.evt, req.payload, req.delay, true);
+                else ek_evoke_event_broadcast(req.evt, req.payload);
+            }
+#    if EK_EVOKE_GROUP_ENABLE == 1
+            else if (req.type & ISR_REQ_GROUP_SET)
+            {
+                ek_evoke_group_set((ek_evoke_group_t *)req.payload, req.delay);
+            }
+#    endif /* EK_EVOKE_GROUP_ENABLE */
+            else if (req.type & ISR_REQ_CALL)
+            {
+                req.fn(req.payload);
             }
         }
+    }
 
-        // 首先检查就绪链表是否为空
-        // 如果不为空则执行所有到期任务
-        // 如果为空就直接去检查延时链表
-        while (!ek_list_is_empty(&_ready_task_list))
-        {
-            ek_list_node_t *node = ek_list_get_first(&_ready_task_list);
-            ek_evoke_task_t *tsk = ek_list_container(node, ek_evoke_task_t, node);
-            ek_list_remove(&tsk->node);
-            tsk->state = EK_EVOKE_STATE_RUNNING;
-            tsk->cb(tsk->wait_event, tsk->arg);
-            ek_list_insert_tail(&tsk->wait_event->wait_list, &tsk->node);
-            tsk->state = EK_EVOKE_STATE_WAITTING;
-        }
-
-        // 检查延时链表
-        // 如果有延时的事件，则取出最早的唤醒事件然后设置中断时间
-        if (!ek_list_is_empty(&_defer_evt_list))
+    // 然后检查就绪链表是否为空
+    // 如果不为空则执行优先级最高的一个任务，执行完回到循环开头，
+    // 让回调或中断中新就绪的高优先级任务排在已就绪的低优先级任务之前
+    // 如果为空就直接去检查延时链表
+    ek_evoke_task_t *tsk = _ek_evoke_ready_pop();
+    if (tsk != NULL)
+    {
+#    if EK_EVOKE_DEADLINE_ENABLE == 1
+        if (tsk->deadline != 0)
         {
-            ek_list_node_t *node = ek_list_get_first(&_defer_evt_list);
-            _defer_req_t *req = ek_list_container(node, _defer_req_t, node);
-            if (req->wakeup_tick != _defer_earilest_tick)
+            int32_t late = (int32_t)(ek_evoke_get_tick() - tsk->due);
+            if (late > 0)
             {
-                _defer_earilest_tick = req->wakeup_tick;
-                _ek_evoke_set_timer(_defer_earilest_tick - _event_tick_base);
+                tsk->deadline_miss++;
+                ek_evoke_deadline_miss(tsk, (uint32_t)late);
             }
         }
+#    endif /* EK_EVOKE_DEADLINE_ENABLE */
+        tsk->state = EK_EVOKE_STATE_RUNNING;
+        _running_task = tsk;
+#    if EK_EVOKE_STATS_ENABLE == 1
+        uint32_t start = ek_evoke_stats_clock();
+        tsk->cb(tsk->wait_event, tsk->arg);
+        _ek_evoke_stats_run(tsk, start - tsk->ready_stamp, ek_evoke_stats_clock() - start);
+#    else
+        tsk->cb(tsk->wait_event, tsk->arg);
+#    endif /* EK_EVOKE_STATS_ENABLE */
+        _running_task = NULL;
+
+        if (_running_destroyed)
+        {
+            _running_destroyed = false;
+            _EK_EVOKE_FREE(_task_pool, tsk);
+        }
+        else if (tsk->state == EK_EVOKE_STATE_RUNNING)
+        {
+            _ek_evoke_rearm(tsk);
+        }
+        return true;
+    }
+
+    // 检查延时链表
+    // 如果有延时的事件，则按最早的唤醒时间计算睡眠时间，已经到期就不睡眠
+    // 唤醒时间可能跨过 32 位回绕，用有符号差值比较
+    _defer_req_t *first = _defer_store_peek();
+    uint32_t xtick = limit;
+    if (first != NULL)
+    {
+        int32_t left = (int32_t)(first->wakeup_tick - _event_now);
+        if (left <= 0) xtick = 0;
+        else if ((uint32_t)left < xtick) xtick = (uint32_t)left;
+    }
 
-        // 检查睡眠锁，根据锁的状态来执行不同的睡眠状态
-        // 如果有锁没有释放，则去浅睡眠 WFI
-        // 如果所有的锁都释放了，则进行深度睡眠
-        if (_sleep_lock) ek_evoke_light_sleep();
-        else ek_evoke_deep_sleep();
-
-        // 中断唤醒，要去检查是否有延时事件被唤醒
-        // 如果有，则依次唤醒
-        // 并且要去检查是否有其他同样唤醒时间的事件
-        // 如果有，一并发布
-        if (_defer_evt_wakeup)
+    // 检查睡眠锁，根据锁的状态来执行不同的睡眠状态
+    // 如果有锁没有释放，则去浅睡眠 WFI
+    // 如果所有的锁都释放了，则进行深度睡眠
+    if (xtick != 0) _ek_evoke_sleep(xtick);
+
+    // 不论是定时器到期还是其他中断提前唤醒，都按推进后的时间发布所有到期的请求
+    _defer_req_t *req;
+    while ((req = _defer_store_peek()) != NULL)
+    {
+        if ((int32_t)(req->wakeup_tick - _event_now) > 0) break;
+
+        _defer_store_remove(req);
+        if (req->tsk != NULL) _ek_evoke_timeout(req->tsk);
+        else if (req->broadcast) ek_evoke_event_broadcast(req->evt, req->payload);
+        else ek_evoke_event_publish(req->evt, req->payload);
+
+        if (req->period != 0)
+        {
+            // 周期请求按周期累加唤醒时间，不随处理延迟漂移；错过的周期合并为一次
+            uint32_t late = _event_now - req->wakeup_tick;
+            req->wakeup_tick += req->period * (late / req->period + 1U);
+            _defer_store_insert(req);
+        }
+        else
         {
-            _defer_evt_wakeup = false;
+            _defer_req_free(req);
+        }
+    }
 
-            while (!ek_list_is_empty(&_defer_evt_list))
-            {
-                ek_list_node_t *node = ek_list_get_first(&_defer_evt_list);
-                _defer_req_t *req = ek_list_container(node, _defer_req_t, node);
+    return false;
+}
 
-                if (req->wakeup_tick > _defer_earilest_tick) break;
+void ek_evoke_event_loop(void)
+{
+    while (1)
+    {
+        _ek_evoke_step(EK_EVOKE_TICK_FOREVER);
+    }
+}
 
-                ek_list_remove(node);
-                if (req->broadcast) ek_evoke_event_broadcast(req->evt, req->payload);
-                else ek_evoke_event_publish(req->evt, req->payload);
-                _defer_req_free(req);
-            }
-            _defer_earilest_tick = UINT32_MAX;
+bool ek_evoke_run_once(void)
+{
+    return _ek_evoke_step(EK_EVOKE_TICK_FOREVER);
+}
+
+void ek_evoke_run_until(uint32_t tick)
+{
+    while (1)
+    {
+        // 到达目标时间后继续处理完已到期的请求、ISR 请求和就绪任务再返回
+        int32_t left = (int32_t)(tick - _event_now);
+        if (left <= 0)
+        {
+            _defer_req_t *first = _defer_store_peek();
+            bool due = (first != NULL && (int32_t)(first->wakeup_tick - _event_now) <= 0);
+            if (!due && _ready_prio_bitmap == 0 && ek_ringbuf_empty_spsc(&_isr_fifo)) break;
         }
+        _ek_evoke_step((left > 0) ? (uint32_t)left : 0);
     }
 }
 
 static _defer_req_t *_defer_req_malloc(void)
 {
+    _defer_req_t *req = NULL;
     if (!ek_list_is_empty(&_defer_pool_free_list))
     {
         ek_list_node_t *node = ek_list_get_first(&_defer_pool_free_list);
         ek_list_remove(node);
-        _defer_req_t *req = ek_list_container(node, _defer_req_t, node);
-        return req;
+        req = ek_list_container(node, _defer_req_t, node);
     }
-    return NULL;
+#    if EK_EVOKE_DEFER_GROW == 1
+    else
+    {
+        req = (_defer_req_t *)ek_malloc(sizeof(_defer_req_t));
+    }
+#    endif /* EK_EVOKE_DEFER_GROW */
+    if (req == NULL) return NULL;
+
+    if (++_defer_stats.used > _defer_stats.peak) _defer_stats.peak = _defer_stats.used;
+    return req;
 }
 
 static void _defer_req_free(_defer_req_t *req)
 {
+    // 扩展出的请求也放回空闲链表而不是归还到堆，失效的句柄总是指向有效的内存
+    _defer_stats.used--;
+    req->gen++;
     ek_list_insert_tail(&_defer_pool_free_list, &req->node);
 }
 
+#    if EK_EVOKE_DEFER_USE_HEAP == 1
+
+/* 二叉最小堆：_defer_heap[0] 是最早唤醒的请求，每个请求记录自己在堆中的下标，取消时无需查找 */
+
+__EK_STATIC_INLINE void _defer_heap_place(_defer_req_t *req, uint32_t idx)
+{
+    _defer_heap[idx] = req;
+    req->heap_idx = idx;
+}
+
+static void _defer_heap_sift_up(uint32_t idx)
+{
+    _defer_req_t *req = _defer_heap[idx];
+    while (idx > 0)
+    {
+        uint32_t parent = (idx - 1U) / 2U;
+        if (!_defer_before(req, _defer_heap[parent])) break;
+        _defer_heap_place(_defer_heap[parent], idx);
+        idx = parent;
+    }
+    _defer_heap_place(req, idx);
+}
+
+static void _defer_heap_sift_down(uint32_t idx)
+{
+    _defer_req_t *req = _defer_heap[idx];
+    while (1)
+    {
+        uint32_t child = idx * 2U + 1U;
+        if (child >= _defer_heap_len) break;
+        if (child + 1U < _defer_heap_len && _defer_before(_defer_heap[child + 1U], _defer_heap[child])) child++;
+        if (!_defer_before(_defer_heap[child], req)) break;
+        _defer_heap_place(_defer_heap[child], idx);
+        idx = child;
+    }
+    _defer_heap_place(req, idx);
+}
+
+static void _defer_store_init(void)
+{
+#        if EK_EVOKE_DEFER_GROW == 1
+    if (_defer_heap != _defer_heap_storage) ek_free(_defer_heap);
+    _defer_heap = _defer_heap_storage;
+    _defer_heap_cap = EK_EVOKE_MAX_DEFER_REQ;
+#        endif /* EK_EVOKE_DEFER_GROW */
+    _defer_heap_len = 0;
+}
+
+static bool _defer_store_reserve(void)
+{
+    // 不扩展时请求来自容量相同的池，堆数组不会溢出；扩展时堆数组按两倍增长
+    if (_defer_heap_len < _defer_heap_cap) return true;
+
+#        if EK_EVOKE_DEFER_GROW == 1
+    uint32_t cap = _defer_heap_cap * 2U;
+    _defer_req_t **heap = (_defer_req_t **)ek_malloc(cap * sizeof(_defer_req_t *));
+    if (heap == NULL) return false;
+    memcpy(heap, _defer_heap, _defer_heap_len * sizeof(_defer_req_t *));
+    if (_defer_heap != _defer_heap_storage) ek_free(_defer_heap);
+    _defer_heap = heap;
+    _defer_heap_cap = cap;
+    return true;
+#        else
+    return false;
+#        endif /* EK_EVOKE_DEFER_GROW */
+}
+
+static void _defer_store_insert(_defer_req_t *req)
+{
+    _defer_heap_place(req, _defer_heap_len++);
+    _defer_heap_sift_up(req->heap_idx);
+}
+
+static _defer_req_t *_defer_store_peek(void)
+{
+    return (_defer_heap_len != 0) ? _defer_heap[0] : NULL;
+}
+
+static void _defer_store_remove(_defer_req_t *req)
+{
+    uint32_t idx = req->heap_idx;
+    _defer_req_t *last = _defer_heap[--_defer_heap_len];
+    if (last == req) return;
+
+    // 用最后一个元素填补空位，再向上或向下调整
+    _defer_heap_place(last, idx);
+    _defer_heap_sift_up(idx);
+    _defer_heap_sift_down(last->heap_idx);
+}
+
+static void _defer_store_cancel(ek_evoke_event_t *evt)
+{
+    // 压缩掉属于该事件的请求后整体重新建堆，O(n)
+    uint32_t len = 0;
+    for (uint32_t i = 0; i < _defer_heap_len; i++)
+    {
+        if (_defer_heap[i]->evt == evt) _defer_req_free(_defer_heap[i]);
+        else _defer_heap_place(_defer_heap[i], len++);
+    }
+    _defer_heap_len = len;
+
+    for (uint32_t i = len / 2U; i > 0; i--) _defer_heap_sift_down(i - 1U);
+}
+
+#        if EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_COALESCE
+static _defer_req_t *_defer_store_find(ek_evoke_event_t *evt, void *payload, bool broadcast)
+{
+    for (uint32_t i = 0; i < _defer_heap_len; i++)
+    {
+        _defer_req_t *req = _defer_heap[i];
+        if (req->evt == evt && req->payload == payload && req->broadcast == broadcast && req->period == 0)
+        {
+            return req;
+        }
+    }
+    return NULL;
+}
+#        elif EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_OVERWRITE
+static _defer_req_t *_defer_store_oldest(void)
+{
+    _defer_req_t *oldest = NULL;
+    for (uint32_t i = 0; i < _defer_heap_len; i++)
+    {
+        _defer_req_t *req = _defer_heap[i];
+        if (req->tsk != NULL || req->period != 0) continue;
+        if (oldest == NULL || (int32_t)(req->seq - oldest->seq) < 0) oldest = req;
+    }
+    return oldest;
+}
+#        endif /* EK_EVOKE_OVERFLOW_POLICY */
+
+#    else
+
+static void _defer_store_init(void)
+{
+    ek_list_init(&_defer_evt_list);
+}
+
+static bool _defer_store_reserve(void)
+{
+    return true;
+}
+
+static void _defer_store_insert(_defer_req_t *req)
+{
+    ek_list_node_t *pos;
+    ek_list_foreach(pos, &_defer_evt_list)
+    {
+        _defer_req_t *pos_req = ek_list_container(pos, _defer_req_t, node);
+        if (!_defer_before(pos_req, req)) break;
+    }
+    ek_list_insert_before(pos, &req->node);
+}
+
+static _defer_req_t *_defer_store_peek(void)
+{
+    if (ek_list_is_empty(&_defer_evt_list)) return NULL;
+    return ek_list_container(ek_list_get_first(&_defer_evt_list), _defer_req_t, node);
+}
+
+static void _defer_store_remove(_defer_req_t *req)
+{
+    ek_list_remove(&req->node);
+}
+
+static void _defer_store_cancel(ek_evoke_event_t *evt)
+{
+    ek_list_node_t *pos, *n;
+    ek_list_foreach_safe(pos, n, &_defer_evt_list)
+    {
+        _defer_req_t *req = ek_list_container(pos, _defer_req_t, node);
+        if (req->evt != evt) continue;
+        ek_list_remove(pos);
+        _defer_req_free(req);
+    }
+}
+
+#        if EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_COALESCE
+static _defer_req_t *_defer_store_find(ek_evoke_event_t *evt, void *payload, bool broadcast)
+{
+    ek_list_node_t *pos;
+    ek_list_foreach(pos, &_defer_evt_list)
+    {
+        _defer_req_t *req = ek_list_container(pos, _defer_req_t, node);
+        if (req->evt == evt && req->payload == payload && req->broadcast == broadcast && req->period == 0)
+        {
+            return req;
+        }
+    }
+    return NULL;
+}
+#        elif EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_OVERWRITE
+static _defer_req_t *_defer_store_oldest(void)
+{
+    _defer_req_t *oldest = NULL;
+    ek_list_node_t *pos;
+    ek_list_foreach(pos, &_defer_evt_list)
+    {
+        _defer_req_t *req = ek_list_container(pos, _defer_req_t, node);
+        if (req->tsk != NULL || req->period != 0) continue;
+        if (oldest == NULL || (int32_t)(req->seq - oldest->seq) < 0) oldest = req;
+    }
+    return oldest;
+}
+#        endif /* EK_EVOKE_OVERFLOW_POLICY */
+
+#    endif /* EK_EVOKE_DEFER_USE_HEAP */
+
 __EK_WEAK void ek_evoke_enter_critical(void)
 {
 }
@@ -414,6 +1551,48 @@ __EK_WEAK void ek_evoke_exit_critical(void)
 {
 }
 
+__EK_WEAK uint32_t ek_evoke_get_tick(void)
+{
+    return _event_now;
+}
+
+__EK_WEAK uint32_t ek_evoke_sleep(uint32_t xtick, bool deep)
+{
+    // 兼容只实现了定时器和睡眠钩子的移植，这种移植无法知道实际睡了多久：
+    // 定时器到期时认为恰好经过了设定的时间；被其他中断提前唤醒时认为没有经过时间，
+    // 定时器继续计时，剩余时间不变时不重新设置，避免频繁的中断把定时器一直推后
+    if (xtick != EK_EVOKE_TICK_FOREVER && xtick != _timer_xtick)
+    {
+        ek_evoke_set_timer(xtick);
+        _timer_xtick = xtick;
+    }
+
+    if (deep) ek_evoke_deep_sleep();
+    else ek_evoke_light_sleep();
+
+    if (!_defer_evt_wakeup) return 0;
+    _defer_evt_wakeup = false;
+
+    uint32_t elapsed = (_timer_xtick != EK_EVOKE_TICK_FOREVER) ? _timer_xtick : 0;
+    _timer_xtick = EK_EVOKE_TICK_FOREVER;
+    return elapsed;
+}
+
+#    if EK_EVOKE_STATS_ENABLE == 1
+__EK_WEAK uint32_t ek_evoke_stats_clock(void)
+{
+    return ek_evoke_get_tick();
+}
+#    endif /* EK_EVOKE_STATS_ENABLE */
+
+#    if EK_EVOKE_DEADLINE_ENABLE == 1
+__EK_WEAK void ek_evoke_deadline_miss(ek_evoke_task_handle_t tsk, uint32_t late)
+{
+    __EK_UNUSED(tsk);
+    __EK_UNUSED(late);
+}
+#    endif /* EK_EVOKE_DEADLINE_ENABLE */
+
 __EK_WEAK void ek_evoke_light_sleep(void)
 {
 }
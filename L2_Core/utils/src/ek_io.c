@@ -15,6 +15,76 @@ __EK_WEAK void _ek_io_fputc(int ch)
     __EK_UNUSED(ch);
 }
 
+__EK_WEAK void _ek_io_write(const uint8_t *buf, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) _ek_io_fputc(buf[i]);
+}
+
+#    if EK_IO_BUFFER_SIZE > 0
+
+// 两块缓冲区轮流使用，交给 _ek_io_write() 的一块在下一次输出之前保持不变，供 DMA 读取
+static uint8_t _io_buf[2][EK_IO_BUFFER_SIZE];
+static uint8_t _io_index;
+static uint32_t _io_len;
+
+__EK_WEAK void ek_io_enter_critical(void)
+{
+}
+
+__EK_WEAK void ek_io_exit_critical(void)
+{
+}
+
+/* 在临界区内调用：交出当前缓冲区并切换到另一块，返回交出的长度 */
+static uint32_t _ek_io_swap(const uint8_t **buf)
+{
+    uint32_t len = _io_len;
+    if (len == 0) return 0;
+
+    *buf = _io_buf[_io_index];
+    _io_index ^= 1U;
+    _io_len = 0;
+    return len;
+}
+
+void ek_io_flush(void)
+{
+    const uint8_t *buf = NULL;
+
+    ek_io_enter_critical();
+    uint32_t len = _ek_io_swap(&buf);
+    ek_io_exit_critical();
+
+    // 驱动可能阻塞等待发送完成，在临界区外调用
+    if (len != 0) _ek_io_write(buf, len);
+}
+
+static int _ek_io_printf(int ch, lwprintf_t *lwp)
+{
+    __EK_UNUSED(lwp);
+    if (ch == '\0') return ch;
+
+    const uint8_t *buf = NULL;
+    uint32_t len = 0;
+
+    ek_io_enter_critical();
+    // 写入前检查边界，不依赖上一次写入后恰好等于容量时的刷新
+    if (_io_len >= EK_IO_BUFFER_SIZE) len = _ek_io_swap(&buf);
+    _io_buf[_io_index][_io_len++] = (uint8_t)ch;
+    bool flush = (ch == '\n' || _io_len >= EK_IO_BUFFER_SIZE);
+    ek_io_exit_critical();
+
+    if (len != 0) _ek_io_write(buf, len);
+    if (flush) ek_io_flush();
+    return ch;
+}
+
+#    else /* EK_IO_BUFFER_SIZE > 0 */
+
+void ek_io_flush(void)
+{
+}
+
 static int _ek_io_printf(int ch, lwprintf_t *lwp)
 {
     __EK_UNUSED(lwp);
@@ -25,6 +95,8 @@ static int _ek_io_printf(int ch, lwprintf_t *lwp)
     return ch;
 }
 
+#    endif /* EK_IO_BUFFER_SIZE > 0 */
+
 void ek_io_init(void)
 {
     lwprintf_init(_ek_io_printf);
@@ -33,6 +105,18 @@ void ek_io_init(void)
 #else
 // 如果不使用lwprintf作为IO库，需要自己在这里实现
 
+#    include "../inc/ek_def.h"
+
+__EK_WEAK void _ek_io_write(const uint8_t *buf, uint32_t len)
+{
+    __EK_UNUSED(buf);
+    __EK_UNUSED(len);
+}
+
+void ek_io_flush(void)
+{
+}
+
 void ek_io_init(void)
 {
 }
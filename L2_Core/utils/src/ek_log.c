@@ -8,18 +8,20 @@
 
 #if EK_LOG_ENABLE == 1
 
+#    include <string.h>
+#    include "ek_ringbuf.h"
+#    include "ek_assert.h"
+
+#    if EK_SHELL_ENABLE == 1
+#        include "ek_shell.h"
+#    endif
+
 #    define EK_LOG_COLOR_NONE   "\033[0;0m"
 #    define EK_LOG_COLOR_YELLOW "\033[33m"
 #    define EK_LOG_COLOR_RED    "\033[91m"
 #    define EK_LOG_COLOR_BLUE   "\033[94m"
 #    define EK_LOG_COLOR_GREEN  "\033[92m"
 
-#    define EK_LOG_CHECK_LOCK() (_lock == 1)
-#    define EK_LOG_LOCK()       (_lock = 1)
-#    define EK_LOG_UNLOCK()     (_lock = 0)
-
-static uint8_t _lock = 0;
-
 #    if (EK_LOG_COLOR_ENABLE == 1)
 
 static const char *const ek_log_color_table[EK_LOG_TYPE_MAX] = {
@@ -32,25 +34,454 @@ static const char *ek_log_type_table[EK_LOG_TYPE_MAX] = {
     "None", "Debug", "Info", "Warn", "Error",
 };
 
-static char ek_log_buffer[EK_LOG_BUFFER_SIZE];
+#    if (EK_LOG_COLOR_ENABLE == 1)
+#        define EK_LOG_TAIL EK_LOG_COLOR_NONE CRLF // 恢复日志颜色并换行
+#    else
+#        define EK_LOG_TAIL CRLF
+#    endif /* EK_LOG_COLOR_ENABLE == 1 */
+
+#    define EK_LOG_TAIL_LEN (sizeof(EK_LOG_TAIL) - 1U)
+
+static uint32_t _dropped[EK_LOG_TYPE_MAX];
 
 __EK_WEAK uint32_t _ek_log_get_tick(void)
 {
     return 0;
 }
 
+__EK_WEAK void ek_log_enter_critical(void)
+{
+}
+
+__EK_WEAK void ek_log_exit_critical(void)
+{
+}
+
+uint32_t ek_log_dropped(ek_log_type_t type)
+{
+    ek_assert_param(type < EK_LOG_TYPE_MAX);
+
+    return __EK_LOAD_ACQUIRE(&_dropped[type]);
+}
+
+#    if EK_LOG_ASYNC_ENABLE == 1 || EK_LOG_PERSIST_ENABLE == 1
+
+/* 格式化一整条日志，保证结尾的颜色恢复和换行不被截掉，返回长度 */
+static uint32_t _ek_log_format(char *buf,
+                               const char *tag,
+                               uint32_t line,
+                               ek_log_type_t type,
+                               uint32_t tick,
+                               const char *fmt,
+                               va_list args)
+{
+    const uint32_t room = EK_LOG_BUFFER_SIZE - EK_LOG_TAIL_LEN;
+    uint32_t len;
+    int ret;
+
+#        if (EK_LOG_COLOR_ENABLE == 1)
+    ret = ek_snprintf(buf,
+                      room,
+                      "%s[%s/%s L:%" PRIu32 ",T:%" PRIu32 "]:",
+                      ek_log_color_table[type],
+                      ek_log_type_table[type],
+                      tag,
+                      line,
+                      tick);
+#        else /* EK_LOG_COLOR_ENABLE == 1 */
+    ret = ek_snprintf(buf, room, "[%s/%s L:%" PRIu32 ",T:%" PRIu32 "]:", ek_log_type_table[type], tag, line, tick);
+#        endif /* EK_LOG_COLOR_ENABLE == 1 */
+    len = (ret < 0) ? 0 : ((uint32_t)ret >= room ? room - 1U : (uint32_t)ret);
+
+    ret = ek_vsnprintf(buf + len, room - len, fmt, args);
+    len += (ret < 0) ? 0 : ((uint32_t)ret >= room - len ? room - len - 1U : (uint32_t)ret);
+
+    memcpy(buf + len, EK_LOG_TAIL, EK_LOG_TAIL_LEN);
+    return len + EK_LOG_TAIL_LEN;
+}
+
+#    endif /* EK_LOG_ASYNC_ENABLE == 1 || EK_LOG_PERSIST_ENABLE == 1 */
+
+#    if EK_LOG_TAG_LEVEL_ENABLE == 1
+
+// 由链接器提供：GNU ld 为名字是合法标识符的段自动生成，MCU 链接脚本中在 .data 内显式定义
+extern ek_log_tag_t __start_ek_log_tag[];
+extern ek_log_tag_t __stop_ek_log_tag[];
+
+// 保证 ek_log_tag 段总是存在
+EK_LOG_FILE_TAG("ek_log.c")
+
+uint32_t ek_log_set_level(const char *tag, ek_log_type_t level)
+{
+    ek_assert_param(level <= EK_LOG_TYPE_MAX);
+
+    bool all = (tag == NULL) || (strcmp(tag, "*") == 0);
+    uint32_t count = 0;
+    for (ek_log_tag_t *t = __start_ek_log_tag; t < __stop_ek_log_tag; t++)
+    {
+        if (all || strcmp(t->name, tag) == 0)
+        {
+            t->level = (uint8_t)level;
+            count++;
+        }
+    }
+    return count;
+}
+
+ek_log_type_t ek_log_get_level(const char *tag)
+{
+    ek_assert_param(tag != NULL);
+
+    for (const ek_log_tag_t *t = __start_ek_log_tag; t < __stop_ek_log_tag; t++)
+    {
+        if (strcmp(t->name, tag) == 0) return (ek_log_type_t)t->level;
+    }
+    return EK_LOG_TYPE_NONE;
+}
+
+void ek_log_level_dump(void)
+{
+    for (const ek_log_tag_t *t = __start_ek_log_tag; t < __stop_ek_log_tag; t++)
+    {
+        ek_printf("  %-24s %s" CRLF, t->name, (t->level < EK_LOG_TYPE_MAX) ? ek_log_type_table[t->level] : "Off");
+    }
+}
+
+#        if EK_SHELL_ENABLE == 1
+/* 不区分大小写地比较级别名称 */
+static bool _ek_log_name_equal(const char *a, const char *b)
+{
+    for (; *a != '\0' && *b != '\0'; a++, b++)
+    {
+        if ((*a | 0x20) != (*b | 0x20)) return false;
+    }
+    return *a == *b;
+}
+
+static int _ek_log_shell_level(const char *tag, const char *level)
+{
+    ek_log_type_t type = EK_LOG_TYPE_MAX;
+    if (!_ek_log_name_equal(level, "off"))
+    {
+        for (type = EK_LOG_TYPE_DEBUG; type < EK_LOG_TYPE_MAX; type++)
+        {
+            if (_ek_log_name_equal(level, ek_log_type_table[type])) break;
+        }
+        if (type == EK_LOG_TYPE_MAX)
+        {
+            ek_printf("usage: loglevel <tag|*> <debug|info|warn|error|off>" CRLF);
+            return -1;
+        }
+    }
+
+    uint32_t count = ek_log_set_level(tag, type);
+    if (count == 0) ek_printf("no such tag: %s" CRLF, tag);
+    return (count != 0) ? 0 : -1;
+}
+
+EK_SHELL_EXPORT_CMD(loglevel, _ek_log_shell_level, loglevel <tag|*> <debug|info|warn|error|off> : set log level);
+EK_SHELL_EXPORT_CMD(logtags, ek_log_level_dump, list log tags and their levels);
+#        endif /* EK_SHELL_ENABLE */
+
+#    endif /* EK_LOG_TAG_LEVEL_ENABLE == 1 */
+
+#    if EK_LOG_PERSIST_ENABLE == 1
+
+// 放在复位不清零的段中，内容由头部校验决定是否保留
+ek_log_persist_t _ek_log_persist __EK_SECTION(EK_LOG_PERSIST_SECTION);
+static bool _persist_ready;
+
+/* 头部不变字段的 CRC32，只在打开和清空时计算 */
+static uint32_t _ek_log_persist_crc(const ek_log_persist_t *p)
+{
+    const uint32_t words[3] = { p->magic, p->size, p->resets };
+    const uint8_t *bytes = (const uint8_t *)words;
+    uint32_t crc = 0xFFFFFFFFU;
+
+    for (uint32_t i = 0; i < sizeof(words); i++)
+    {
+        crc ^= bytes[i];
+        for (uint32_t bit = 0; bit < 8U; bit++) crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+    }
+    return ~crc;
+}
+
+static bool _ek_log_persist_valid(const ek_log_persist_t *p)
+{
+    uint32_t head = p->head;
+    return p->magic == EK_LOG_PERSIST_MAGIC && p->size == EK_LOG_PERSIST_SIZE && head == ~p->head_inv &&
+           (head & ~EK_LOG_PERSIST_FULL) < EK_LOG_PERSIST_SIZE && p->crc == _ek_log_persist_crc(p);
+}
+
+void ek_log_persist_clear(void)
+{
+    ek_log_persist_t *p = &_ek_log_persist;
+
+    ek_log_enter_critical();
+    p->magic = EK_LOG_PERSIST_MAGIC;
+    p->size = EK_LOG_PERSIST_SIZE;
+    p->resets = 0;
+    p->crc = _ek_log_persist_crc(p);
+    p->head = 0;
+    p->head_inv = ~0U;
+    ek_log_exit_critical();
+
+    __EK_STORE_RELEASE(&_persist_ready, true);
+}
+
+bool ek_log_persist_init(void)
+{
+    ek_log_persist_t *p = &_ek_log_persist;
+
+    if (!_ek_log_persist_valid(p))
+    {
+        ek_log_persist_clear();
+        return false;
+    }
+
+    p->resets++;
+    p->crc = _ek_log_persist_crc(p);
+    __EK_STORE_RELEASE(&_persist_ready, true);
+    return true;
+}
+
+uint32_t ek_log_persist_used(void)
+{
+    uint32_t head = _ek_log_persist.head;
+    if (!__EK_LOAD_ACQUIRE(&_persist_ready)) return 0;
+    return (head & EK_LOG_PERSIST_FULL) ? EK_LOG_PERSIST_SIZE : head;
+}
+
+uint32_t ek_log_persist_resets(void)
+{
+    return _ek_log_persist.resets;
+}
+
+uint32_t ek_log_persist_read(uint32_t offset, uint8_t *buf, uint32_t len)
+{
+    ek_assert_param(buf != NULL);
+
+    uint32_t head = _ek_log_persist.head;
+    uint32_t used = ek_log_persist_used();
+    if (offset >= used) return 0;
+    if (len > used - offset) len = used - offset;
+
+    // 写满一圈后最旧的字节就在写入位置上
+    uint32_t pos = ((head & EK_LOG_PERSIST_FULL) ? (head & ~EK_LOG_PERSIST_FULL) : 0U) + offset;
+    if (pos >= EK_LOG_PERSIST_SIZE) pos -= EK_LOG_PERSIST_SIZE;
+
+    uint32_t first = EK_LOG_PERSIST_SIZE - pos;
+    if (first > len) first = len;
+    memcpy(buf, &_ek_log_persist.data[pos], first);
+    memcpy(buf + first, _ek_log_persist.data, len - first);
+    return len;
+}
+
+void ek_log_persist_dump(void)
+{
+    uint32_t head = _ek_log_persist.head;
+    uint32_t used = ek_log_persist_used();
+    if (used == 0) return;
+
+    ek_io_flush();
+    if (head & EK_LOG_PERSIST_FULL)
+    {
+        uint32_t pos = head & ~EK_LOG_PERSIST_FULL;
+        _ek_io_write(&_ek_log_persist.data[pos], EK_LOG_PERSIST_SIZE - pos);
+        if (pos != 0) _ek_io_write(_ek_log_persist.data, pos);
+    }
+    else
+    {
+        _ek_io_write(_ek_log_persist.data, used);
+    }
+}
+
+/* 把一条已经成形的日志复制进区域，只有 memcpy 和两次写头部 */
+static void _ek_log_persist_write(const void *data, uint32_t len)
+{
+    ek_log_persist_t *p = &_ek_log_persist;
+    const uint8_t *src = (const uint8_t *)data;
+
+    if (!__EK_LOAD_ACQUIRE(&_persist_ready)) return;
+    if (len > EK_LOG_PERSIST_SIZE)
+    {
+        src += len - EK_LOG_PERSIST_SIZE;
+        len = EK_LOG_PERSIST_SIZE;
+    }
+
+    ek_log_enter_critical();
+    uint32_t head = p->head;
+    uint32_t pos = head & ~EK_LOG_PERSIST_FULL;
+    uint32_t first = EK_LOG_PERSIST_SIZE - pos;
+    if (first > len) first = len;
+    memcpy(&p->data[pos], src, first);
+    memcpy(p->data, src + first, len - first);
+
+    pos += len;
+    if (pos >= EK_LOG_PERSIST_SIZE)
+    {
+        pos -= EK_LOG_PERSIST_SIZE;
+        head |= EK_LOG_PERSIST_FULL;
+    }
+    head = (head & EK_LOG_PERSIST_FULL) | pos;
+    // 数据先于头部写入，复位只会丢掉正在写的这一条
+    p->head_inv = ~head;
+    p->head = head;
+    ek_log_exit_critical();
+}
+
+#        define _EK_LOG_PERSIST(data, len) _ek_log_persist_write(data, len)
+
+#        if EK_SHELL_ENABLE == 1
+static void _ek_log_shell_crashlog(void)
+{
+    ek_printf("crash log: %" PRIu32 " bytes, %" PRIu32 " resets" CRLF, ek_log_persist_used(), ek_log_persist_resets());
+    ek_log_persist_dump();
+    ek_printf(CRLF);
+}
+
+EK_SHELL_EXPORT_CMD(crashlog, _ek_log_shell_crashlog, dump the log kept across resets);
+EK_SHELL_EXPORT_CMD(crashclear, ek_log_persist_clear, clear the log kept across resets);
+#        endif /* EK_SHELL_ENABLE */
+
+#    else /* EK_LOG_PERSIST_ENABLE == 1 */
+
+#        define _EK_LOG_PERSIST(data, len) ((void)0)
+
+#    endif /* EK_LOG_PERSIST_ENABLE == 1 */
+
+#    if EK_LOG_ASYNC_ENABLE == 1
+
+EK_RINGBUF_SPSC_STATIC_DEFINE(_async_ring, uint8_t, EK_LOG_ASYNC_SIZE);
+
+static bool _tx_busy; /* 是否有一段数据正在发送 */
+static uint32_t _tx_len; /* 正在发送的字节数 */
+
+/* 空闲时取出一段连续数据交给发送函数 */
+static void _ek_log_async_start(void)
+{
+    ek_ringbuf_span_t span[2];
+
+    ek_log_enter_critical();
+    if (_tx_busy || ek_ringbuf_acquire_read_spsc(&_async_ring, span, UINT32_MAX) == 0)
+    {
+        ek_log_exit_critical();
+        return;
+    }
+    _tx_busy = true;
+    _tx_len = span[0].amount;
+    ek_log_exit_critical();
+
+    if (!_ek_log_async_write((const uint8_t *)span[0].buf, span[0].amount))
+    {
+        ek_log_enter_critical();
+        _tx_busy = false;
+        ek_log_exit_critical();
+    }
+}
+
+__EK_WEAK bool _ek_log_async_write(const uint8_t *data, uint32_t len)
+{
+    ek_io_flush();
+    _ek_io_write(data, len);
+    ek_log_async_done();
+    return true;
+}
+
+void ek_log_async_done(void)
+{
+    ek_log_enter_critical();
+    if (_tx_busy)
+    {
+        ek_ringbuf_release_read_spsc(&_async_ring, _tx_len);
+        _tx_busy = false;
+    }
+    ek_log_exit_critical();
+
+    _ek_log_async_start();
+}
+
+void ek_log_async_poll(void)
+{
+    _ek_log_async_start();
+}
+
+uint32_t ek_log_async_pending(void)
+{
+    return ek_ringbuf_count_spsc(&_async_ring);
+}
+
 void _ek_log_printf(const char *tag, uint32_t line, ek_log_type_t type, uint32_t tick, const char *fmt, ...)
 {
-    if (EK_LOG_CHECK_LOCK() == 1) return;
+    char buf[EK_LOG_BUFFER_SIZE];
+
+    va_list args;
+    va_start(args, fmt);
+    uint32_t len = _ek_log_format(buf, tag, line, type, tick, fmt, args);
+    va_end(args);
+
+    _EK_LOG_PERSIST(buf, len);
+
+    // 多个生产者在临界区内依次写入，消费者（发送）一侧无锁
+    ek_log_enter_critical();
+    uint32_t space = ek_ringbuf_space_spsc(&_async_ring);
+    if (len <= space)
+    {
+        ek_ringbuf_write_bulk_spsc(&_async_ring, buf, len);
+    }
+#        if EK_LOG_OVERFLOW_POLICY == EK_LOG_OVERFLOW_TRUNCATE
+    else if (space > EK_LOG_TAIL_LEN)
+    {
+        ek_ringbuf_write_bulk_spsc(&_async_ring, buf, space - EK_LOG_TAIL_LEN);
+        ek_ringbuf_write_bulk_spsc(&_async_ring, EK_LOG_TAIL, EK_LOG_TAIL_LEN);
+        _dropped[type]++;
+    }
+#        endif /* EK_LOG_OVERFLOW_POLICY == EK_LOG_OVERFLOW_TRUNCATE */
+    else
+    {
+        _dropped[type]++;
+    }
+    ek_log_exit_critical();
+
+    _ek_log_async_start();
+}
+
+#    else /* EK_LOG_ASYNC_ENABLE == 1 */
+
+#        define EK_LOG_CHECK_LOCK() (_lock == 1)
+#        define EK_LOG_LOCK()       (_lock = 1)
+#        define EK_LOG_UNLOCK()     (_lock = 0)
+
+static uint8_t _lock = 0;
+static char ek_log_buffer[EK_LOG_BUFFER_SIZE];
+
+void _ek_log_printf(const char *tag, uint32_t line, ek_log_type_t type, uint32_t tick, const char *fmt, ...)
+{
+    if (EK_LOG_CHECK_LOCK() == 1)
+    {
+        _dropped[type]++;
+        return;
+    }
 
     EK_LOG_LOCK();
 
-#    if (EK_LOG_COLOR_ENABLE == 1)
+#        if EK_LOG_PERSIST_ENABLE == 1
+    // 整行格式化一次，同时写入持久化区域和输出
+    va_list args;
+    va_start(args, fmt);
+    uint32_t len = _ek_log_format(ek_log_buffer, tag, line, type, tick, fmt, args);
+    va_end(args);
+
+    _EK_LOG_PERSIST(ek_log_buffer, len);
+    ek_log_buffer[len] = '\0';
+    ek_printf("%s", ek_log_buffer);
+#        else /* EK_LOG_PERSIST_ENABLE == 1 */
+#            if (EK_LOG_COLOR_ENABLE == 1)
     ek_printf(
         "%s[%s/%s L:%" PRIu32 ",T:%" PRIu32 "]:", ek_log_color_table[type], ek_log_type_table[type], tag, line, tick);
-#    else /* EK_LOG_COLOR_ENABLE == 1 */
+#            else /* EK_LOG_COLOR_ENABLE == 1 */
     ek_printf("[%s/%s L:%" PRIu32 ",T:%" PRIu32 "]:", ek_log_type_table[type], tag, line, tick);
-#    endif /* EK_LOG_COLOR_ENABLE == 1 */
+#            endif /* EK_LOG_COLOR_ENABLE == 1 */
 
     va_list args;
     va_start(args, fmt);
@@ -58,14 +489,162 @@ void _ek_log_printf(const char *tag, uint32_t line, ek_log_type_t type, uint32_t
     va_end(args);
 
     ek_printf("%s", ek_log_buffer);
+    ek_printf(EK_LOG_TAIL);
+#        endif /* EK_LOG_PERSIST_ENABLE == 1 */
 
-#    if (EK_LOG_COLOR_ENABLE == 1)
-    ek_printf(EK_LOG_COLOR_NONE); // 恢复日志颜色
-#    endif /* EK_LOG_COLOR_ENABLE == 1 */
+    EK_LOG_UNLOCK();
+}
 
-    ek_printf(CRLF); // 换行符
+#    endif /* EK_LOG_ASYNC_ENABLE == 1 */
 
-    EK_LOG_UNLOCK();
+#    if EK_RINGBUF_MPMC_ENABLE == 1
+
+#        define EK_LOG_DEFER_SYNC   (0xA5U)
+#        define EK_LOG_DEFER_HEADER (11U) /* id + tick + types + amount */
+
+/* 一条延迟日志，参数区按 32 位字对齐，字符串以 1 字节长度开头 */
+typedef struct
+{
+    uint32_t id; /* 格式描述串相对 ek_log_fmt 段首的偏移 */
+    uint32_t tick;
+    uint16_t types; /* 每个参数 2 位 ek_log_arg_type_t */
+    uint8_t amount; /* 实际保存的参数个数 */
+    uint8_t words; /* 参数区使用的字数 */
+    uint32_t data[EK_LOG_DEFER_WORDS];
+} _defer_rec_t;
+
+// 由链接器提供：GNU ld 为名字是合法标识符的段自动生成，MCU 链接脚本中显式定义
+extern const char __start_ek_log_fmt[];
+
+// 保证 ek_log_fmt 段总是存在，不会被任何记录引用
+static const char _ek_log_fmt_base[] __EK_USED __EK_SECTION("ek_log_fmt") = "";
+
+#        define EK_LOG_DEFER_FRAME_MAX (2U + EK_LOG_DEFER_HEADER + EK_LOG_DEFER_WORDS * sizeof(uint32_t))
+
+/* 把记录编码成帧，返回帧长度 */
+static uint32_t _ek_log_defer_encode(const _defer_rec_t *rec, uint8_t *frame)
+{
+    uint32_t payload = EK_LOG_DEFER_HEADER + rec->words * sizeof(uint32_t);
+
+    frame[0] = EK_LOG_DEFER_SYNC;
+    frame[1] = (uint8_t)payload;
+    for (uint32_t i = 0; i < 4U; i++)
+    {
+        frame[2U + i] = (uint8_t)(rec->id >> (8U * i));
+        frame[6U + i] = (uint8_t)(rec->tick >> (8U * i));
+    }
+    frame[10] = (uint8_t)rec->types;
+    frame[11] = (uint8_t)(rec->types >> 8U);
+    frame[12] = rec->amount;
+    // 参数区按小端机器的内存布局原样输出
+    memcpy(&frame[13], rec->data, rec->words * sizeof(uint32_t));
+
+    return 2U + payload;
+}
+
+static uint8_t _defer_storage[EK_RINGBUF_MPMC_SLOT_SIZE(sizeof(_defer_rec_t)) * EK_LOG_DEFER_DEPTH] __EK_ALIGNED(4);
+static ek_ringbuf_mpmc_t _defer_ring;
+static bool _defer_ready;
+static uint32_t _defer_dropped;
+
+void ek_log_defer_init(void)
+{
+    ek_ringbuf_init_mpmc(&_defer_ring, _defer_storage, sizeof(_defer_rec_t), EK_LOG_DEFER_DEPTH);
+    __EK_STORE_RELEASE(&_defer_dropped, 0U);
+    __EK_STORE_RELEASE(&_defer_ready, true);
+}
+
+uint32_t ek_log_defer_dropped(void)
+{
+    return __EK_LOAD_ACQUIRE(&_defer_dropped);
 }
 
+void _ek_log_defer(const char *fmt, uint32_t tick, const ek_log_arg_t *args, uint32_t amount)
+{
+    _defer_rec_t rec;
+    uint8_t *bytes = (uint8_t *)rec.data;
+    uint32_t used = 0;
+
+    rec.id = (uint32_t)((uintptr_t)fmt - (uintptr_t)__start_ek_log_fmt);
+    rec.tick = tick;
+    rec.types = 0;
+    rec.amount = 0;
+
+    // 按顺序装入参数，装不下的参数及其后的参数都不保存，解码时显示为 <?>
+    for (uint32_t i = 0; i < amount; i++)
+    {
+        uint32_t need;
+        if (args[i].type == EK_LOG_ARG_STR)
+        {
+            const char *str = (args[i].str != NULL) ? args[i].str : "(null)";
+            uint32_t space = (EK_LOG_DEFER_WORDS - used) * sizeof(uint32_t);
+            if (space < 2U) break;
+            space = (space - 1U > 255U) ? 255U : space - 1U;
+
+            uint32_t len = 0;
+            while (len < space && str[len] != '\0') len++;
+            bytes[used * sizeof(uint32_t)] = (uint8_t)len;
+            memcpy(&bytes[used * sizeof(uint32_t) + 1U], str, len);
+            need = (len + 1U + 3U) / sizeof(uint32_t);
+        }
+        else if (args[i].type == EK_LOG_ARG_U32)
+        {
+            need = 1U;
+            if (used + need > EK_LOG_DEFER_WORDS) break;
+            rec.data[used] = args[i].u32;
+        }
+        else
+        {
+            need = 2U;
+            if (used + need > EK_LOG_DEFER_WORDS) break;
+            memcpy(&rec.data[used], &args[i].u64, sizeof(uint64_t));
+        }
+
+        rec.types |= (uint16_t)(args[i].type << (2U * i));
+        rec.amount++;
+        used += need;
+    }
+    rec.words = (uint8_t)used;
+
+#        if EK_LOG_PERSIST_ENABLE == 1
+    // 帧在记录时就写入持久化区域，还在队列里的日志复位后也不会丢
+    uint8_t frame[EK_LOG_DEFER_FRAME_MAX];
+    _EK_LOG_PERSIST(frame, _ek_log_defer_encode(&rec, frame));
+#        endif /* EK_LOG_PERSIST_ENABLE == 1 */
+
+    if (!__EK_LOAD_ACQUIRE(&_defer_ready) || !ek_ringbuf_write_mpmc(&_defer_ring, &rec))
+    {
+        // 可能在中断中调用，用 CAS 累加，AC5 也能编译；失败时 dropped 会被更新为最新值
+        uint32_t dropped = __EK_LOAD_ACQUIRE(&_defer_dropped);
+        while (!__EK_CAS(&_defer_dropped, &dropped, dropped + 1U))
+        {
+        }
+    }
+}
+
+__EK_WEAK void _ek_log_defer_write(const uint8_t *data, uint32_t len)
+{
+    ek_io_flush();
+    _ek_io_write(data, len);
+}
+
+uint32_t ek_log_defer_flush(void)
+{
+    _defer_rec_t rec;
+    uint8_t frame[EK_LOG_DEFER_FRAME_MAX];
+    uint32_t count = 0;
+
+    if (!__EK_LOAD_ACQUIRE(&_defer_ready)) return 0;
+
+    while (ek_ringbuf_read_mpmc(&_defer_ring, &rec))
+    {
+        _ek_log_defer_write(frame, _ek_log_defer_encode(&rec, frame));
+        count++;
+    }
+
+    return count;
+}
+
+#    endif /* EK_RINGBUF_MPMC_ENABLE == 1 */
+
 #endif /* EK_LOG_ENABLE */
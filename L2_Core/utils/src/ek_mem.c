@@ -5,6 +5,24 @@
  */
 
 #include "ek_mem.h"
+#include "ek_io.h"
+#include "ek_assert.h"
+
+#if EK_LOG_ENABLE == 1
+#    include "ek_log.h"
+#endif
+
+#if EK_SHELL_ENABLE == 1
+#    include "ek_shell.h"
+#endif
+
+__EK_WEAK void ek_mem_enter_critical(void)
+{
+}
+
+__EK_WEAK void ek_mem_exit_critical(void)
+{
+}
 
 #if EK_HEAP_NO_TLSF == 0
 
@@ -63,54 +81,619 @@
 uint8_t ek_default_heap[EK_HEAP_SIZE];
 tlsf_t ek_default_tlsf;
 
-static size_t ek_unused_bytes = 0;
-static size_t ek_used_bytes = 0;
+/* 默认堆的运行计数，在分配/释放时维护，查询为 O(1) */
+static ek_heap_stats_t _ek_default_stats;
 
-__EK_WEAK void *_ek_malloc(size_t size)
+#    if EK_HEAP_REGION_ENABLE == 1
+
+ek_heap_t ek_heap_fast = { .name = "fast" };
+ek_heap_t ek_heap_dma = { .name = "dma" };
+ek_heap_t ek_heap_bulk = { .name = "bulk" };
+
+#        if EK_HEAP_REGION_STUB == 1
+/* 主机测试时用普通数组模拟 CCM-RAM 和 SDRAM 中的剩余空间 */
+#            ifndef EK_HEAP_REGION_STUB_SIZE
+#                define EK_HEAP_REGION_STUB_SIZE (16 * 1024)
+#            endif
+static uint64_t _ek_heap_fast_stub[EK_HEAP_REGION_STUB_SIZE / sizeof(uint64_t)];
+static uint64_t _ek_heap_bulk_stub[EK_HEAP_REGION_STUB_SIZE / sizeof(uint64_t)];
+static uint64_t _ek_heap_bulk2_stub[EK_HEAP_REGION_STUB_SIZE / sizeof(uint64_t)];
+#            define _EK_HEAP_REGION(stub) (uint8_t *)(stub), (uint8_t *)(stub) + sizeof(stub)
+#        else
+/* 由链接脚本在对应内存区域存在时导出，不存在时弱引用解析为 0 */
+__EK_WEAK extern uint8_t _ek_heap_fast_start[];
+__EK_WEAK extern uint8_t _ek_heap_fast_end[];
+__EK_WEAK extern uint8_t _ek_heap_bulk_start[];
+__EK_WEAK extern uint8_t _ek_heap_bulk_end[];
+__EK_WEAK extern uint8_t _ek_heap_bulk2_start[];
+__EK_WEAK extern uint8_t _ek_heap_bulk2_end[];
+#        endif /* EK_HEAP_REGION_STUB */
+
+static void _ek_heap_add_region(ek_heap_t *heap, uint8_t *start, uint8_t *end)
 {
-    return tlsf_malloc(ek_default_tlsf, size);
+    if (start == NULL || end <= start || heap->pool_amount >= EK_HEAP_REGION_MAX_POOLS) return;
+
+    size_t align = tlsf_align_size();
+    uint8_t *mem = (uint8_t *)(((uintptr_t)start + align - 1U) & ~(uintptr_t)(align - 1U));
+    if (mem >= end) return;
+    size_t bytes = (size_t)(end - mem) & ~(align - 1U);
+
+    pool_t pool;
+    if (heap->tlsf == NULL)
+    {
+        // 区域太小时 TLSF 会拒绝创建，此时该堆保持不可用
+        if (bytes <= tlsf_size() + tlsf_pool_overhead()) return;
+        heap->tlsf = tlsf_create_with_pool(mem, bytes);
+        if (heap->tlsf == NULL) return;
+        pool = tlsf_get_pool(heap->tlsf);
+        heap->stats.total += bytes - tlsf_size();
+    }
+    else
+    {
+        pool = tlsf_add_pool(heap->tlsf, mem, bytes);
+        if (pool == NULL) return;
+        heap->stats.total += bytes;
+    }
+
+    heap->pools[heap->pool_amount].pool = pool;
+    heap->pools[heap->pool_amount].start = mem;
+    heap->pools[heap->pool_amount].end = mem + bytes;
+    heap->pool_amount++;
 }
 
-__EK_WEAK void *_ek_realloc(void *ptr, size_t size)
+static bool _ek_heap_contains(const ek_heap_t *heap, const void *ptr)
 {
-    return tlsf_realloc(ek_default_tlsf, ptr, size);
+    for (uint32_t i = 0; i < heap->pool_amount; i++)
+    {
+        if ((const uint8_t *)ptr >= heap->pools[i].start && (const uint8_t *)ptr < heap->pools[i].end) return true;
+    }
+    return false;
 }
 
-__EK_WEAK void _ek_free(void *ptr)
+void ek_heap_regions_init(void)
 {
-    tlsf_free(ek_default_tlsf, ptr);
+    ek_heap_t *heaps[] = { &ek_heap_fast, &ek_heap_dma, &ek_heap_bulk };
+    for (size_t i = 0; i < EK_ARRAY_LEN(heaps); i++)
+    {
+        heaps[i]->tlsf = NULL;
+        heaps[i]->pool_amount = 0;
+        memset(&heaps[i]->stats, 0, sizeof(heaps[i]->stats));
+    }
+
+    // DMA 堆就是默认堆，只登记范围，计数沿用默认堆的
+    ek_heap_dma.tlsf = ek_default_tlsf;
+    ek_heap_dma.pools[0].pool = tlsf_get_pool(ek_default_tlsf);
+    ek_heap_dma.pools[0].start = ek_default_heap;
+    ek_heap_dma.pools[0].end = ek_default_heap + EK_HEAP_SIZE;
+    ek_heap_dma.pool_amount = 1;
+
+#        if EK_HEAP_REGION_STUB == 1
+    _ek_heap_add_region(&ek_heap_fast, _EK_HEAP_REGION(_ek_heap_fast_stub));
+    _ek_heap_add_region(&ek_heap_bulk, _EK_HEAP_REGION(_ek_heap_bulk_stub));
+    _ek_heap_add_region(&ek_heap_bulk, _EK_HEAP_REGION(_ek_heap_bulk2_stub));
+#        else
+    _ek_heap_add_region(&ek_heap_fast, _ek_heap_fast_start, _ek_heap_fast_end);
+    _ek_heap_add_region(&ek_heap_bulk, _ek_heap_bulk_start, _ek_heap_bulk_end);
+    _ek_heap_add_region(&ek_heap_bulk, _ek_heap_bulk2_start, _ek_heap_bulk2_end);
+#        endif /* EK_HEAP_REGION_STUB */
+}
+
+ek_heap_t *ek_heap_of(const void *ptr)
+{
+    if (_ek_heap_contains(&ek_heap_fast, ptr)) return &ek_heap_fast;
+    if (_ek_heap_contains(&ek_heap_bulk, ptr)) return &ek_heap_bulk;
+    return &ek_heap_dma;
 }
 
-// walker 函数：统计空闲内存
-static void ek_mem_walker(void *ptr, size_t size, int used, void *user)
+/* 按地址找到内存所属的 TLSF 实例和计数，不在任何命名区域内的都属于默认堆 */
+static ek_heap_stats_t *_ek_heap_owner(const void *ptr, tlsf_t *tlsf)
+{
+    ek_heap_t *heap = ek_heap_of(ptr);
+    if (heap == &ek_heap_dma || heap->tlsf == NULL)
+    {
+        *tlsf = ek_default_tlsf;
+        return &_ek_default_stats;
+    }
+    *tlsf = heap->tlsf;
+    return &heap->stats;
+}
+#    else
+static ek_heap_stats_t *_ek_heap_owner(const void *ptr, tlsf_t *tlsf)
 {
     __EK_UNUSED(ptr);
-    __EK_UNUSED(user);
+    *tlsf = ek_default_tlsf;
+    return &_ek_default_stats;
+}
+#    endif /* EK_HEAP_REGION_ENABLE */
+
+#    if EK_HEAP_THREAD_SAFE == 1
+/* TLSF、运行计数和追踪表都是共享状态，分配/释放全程在临界区内完成 */
+#        define _EK_HEAP_LOCK()   ek_mem_enter_critical()
+#        define _EK_HEAP_UNLOCK() ek_mem_exit_critical()
+#    else
+#        define _EK_HEAP_LOCK()
+#        define _EK_HEAP_UNLOCK()
+#    endif /* EK_HEAP_THREAD_SAFE */
+
+#    if EK_HEAP_TRACE == 1
+
+#        if (EK_HEAP_TRACE_DEPTH & (EK_HEAP_TRACE_DEPTH - 1)) != 0
+#            error "EK_HEAP_TRACE_DEPTH must be a power of 2"
+#        endif
+
+#        define _EK_HEAP_TRACE_MASK ((uint32_t)EK_HEAP_TRACE_DEPTH - 1U)
+
+/*
+ * 追踪表：以分配地址为键的开放寻址哈希表（线性探测）。
+ * 删除时把探测链上后续的记录前移填补空位，不使用墓碑，
+ * 因此查找遇到空槽即可停止，长时间运行后也不会退化。
+ */
+static ek_heap_trace_rec_t _ek_heap_trace_tab[EK_HEAP_TRACE_DEPTH];
+static uint32_t _ek_heap_trace_count;
+static uint32_t _ek_heap_trace_lost_count;
+
+__EK_WEAK uint32_t ek_heap_trace_get_tick(void)
+{
+#        if EK_LOG_ENABLE == 1
+    return _ek_log_get_tick();
+#        else
+    return 0;
+#        endif
+}
+
+static uint32_t _ek_heap_trace_hash(const void *ptr)
+{
+    uint32_t h = (uint32_t)(uintptr_t)ptr * 2654435761U;
+    return (h ^ (h >> 16)) & _EK_HEAP_TRACE_MASK;
+}
+
+static void _ek_heap_trace_add(void *ptr, size_t size, void *caller)
+{
+    if (_ek_heap_trace_count >= EK_HEAP_TRACE_DEPTH)
+    {
+        _ek_heap_trace_lost_count++;
+        return;
+    }
+
+    uint32_t i = _ek_heap_trace_hash(ptr);
+    while (_ek_heap_trace_tab[i].ptr != NULL) i = (i + 1U) & _EK_HEAP_TRACE_MASK;
+
+    _ek_heap_trace_tab[i].ptr = ptr;
+    _ek_heap_trace_tab[i].caller = caller;
+    _ek_heap_trace_tab[i].size = (uint32_t)size;
+    _ek_heap_trace_tab[i].tick = ek_heap_trace_get_tick();
+    _ek_heap_trace_count++;
+}
+
+static void _ek_heap_trace_del(const void *ptr)
+{
+    uint32_t i = _ek_heap_trace_hash(ptr);
+    uint32_t n = 0;
+    while (_ek_heap_trace_tab[i].ptr != ptr)
+    {
+        // 表满时没有记录下来的分配，释放时自然查不到
+        if (_ek_heap_trace_tab[i].ptr == NULL || ++n >= EK_HEAP_TRACE_DEPTH) return;
+        i = (i + 1U) & _EK_HEAP_TRACE_MASK;
+    }
+
+    _ek_heap_trace_tab[i].ptr = NULL;
+    _ek_heap_trace_count--;
+
+    uint32_t j = i;
+    for (;;)
+    {
+        j = (j + 1U) & _EK_HEAP_TRACE_MASK;
+        if (_ek_heap_trace_tab[j].ptr == NULL) return;
+
+        // 记录的理想位置不在 (i, j] 之间时，说明它是越过 i 探测过来的，可以前移到 i
+        uint32_t home = _ek_heap_trace_hash(_ek_heap_trace_tab[j].ptr);
+        if (((j - home) & _EK_HEAP_TRACE_MASK) >= ((j - i) & _EK_HEAP_TRACE_MASK))
+        {
+            _ek_heap_trace_tab[i] = _ek_heap_trace_tab[j];
+            _ek_heap_trace_tab[j].ptr = NULL;
+            i = j;
+        }
+    }
+}
+
+uint32_t ek_heap_trace_report(ek_heap_trace_site_t *sites, uint32_t max)
+{
+    uint32_t amount = 0;
+
+    _EK_HEAP_LOCK();
+    for (uint32_t i = 0; i < EK_HEAP_TRACE_DEPTH; i++)
+    {
+        const ek_heap_trace_rec_t *rec = &_ek_heap_trace_tab[i];
+        if (rec->ptr == NULL) continue;
+
+        uint32_t k = 0;
+        while (k < amount && sites[k].caller != rec->caller) k++;
+        if (k == amount)
+        {
+            if (amount >= max) continue;
+            sites[k].caller = rec->caller;
+            sites[k].count = 0;
+            sites[k].bytes = 0;
+            sites[k].oldest_tick = rec->tick;
+            amount++;
+        }
+        sites[k].count++;
+        sites[k].bytes += rec->size;
+        // 按时间差比较，时间戳回绕后仍然正确
+        if ((int32_t)(rec->tick - sites[k].oldest_tick) < 0) sites[k].oldest_tick = rec->tick;
+    }
+    _EK_HEAP_UNLOCK();
+
+    // 调用点数量很少，插入排序即可
+    for (uint32_t i = 1; i < amount; i++)
+    {
+        ek_heap_trace_site_t key = sites[i];
+        uint32_t k = i;
+        while (k > 0 && sites[k - 1].bytes < key.bytes)
+        {
+            sites[k] = sites[k - 1];
+            k--;
+        }
+        sites[k] = key;
+    }
+
+    return amount;
+}
+
+uint32_t ek_heap_trace_live(void)
+{
+    return _ek_heap_trace_count;
+}
+
+uint32_t ek_heap_trace_lost(void)
+{
+    return _ek_heap_trace_lost_count;
+}
+#    else
+#        define _ek_heap_trace_add(ptr, size, caller) ((void)(size), (void)(caller))
+#        define _ek_heap_trace_del(ptr)               ((void)0)
+#    endif /* EK_HEAP_TRACE */
+
+static void _ek_heap_count_alloc(ek_heap_stats_t *stats, void *ptr)
+{
+    if (ptr == NULL)
+    {
+        stats->failed_count++;
+        return;
+    }
+    stats->alloc_count++;
+    stats->used += tlsf_block_size(ptr);
+    if (stats->used > stats->peak) stats->peak = stats->used;
+}
+
+/*
+ * 所有分配入口的公共路径，caller 由入口函数取得，保证记录的是用户代码的调用点；
+ * block 是实际向 TLSF 申请的大小，size 是用户请求的大小
+ */
+static void *_ek_heap_alloc(tlsf_t tlsf, ek_heap_stats_t *stats, size_t block, size_t size, void *caller)
+{
+    _EK_HEAP_LOCK();
+    void *ptr = tlsf_malloc(tlsf, block);
+    _ek_heap_count_alloc(stats, ptr);
+    if (ptr != NULL) _ek_heap_trace_add(ptr, size, caller);
+    _EK_HEAP_UNLOCK();
+    return ptr;
+}
+
+#    if EK_HEAP_CACHE_ENABLE == 1
+
+#        define _EK_HEAP_CACHE_SIZE(cls) ((size_t)EK_HEAP_CACHE_MIN_SIZE << (cls))
+
+/*
+ * 每任务缓存：释放的小块先挂到当前任务自己的链表上，同一任务再次分配同一分级时直接取回。
+ * 缓存只被所属任务访问，命中时不进入临界区；缓存中的块对 TLSF 来说仍是已分配状态。
+ */
+__EK_WEAK ek_heap_cache_t *ek_mem_task_cache(void)
+{
+    return NULL;
+}
+
+/* 能容纳请求的最小分级，不属于任何分级时返回 -1 */
+static int32_t _ek_heap_cache_class(size_t size)
+{
+    if (size == 0) return -1;
+    for (int32_t cls = 0; cls < EK_HEAP_CACHE_CLASSES; cls++)
+    {
+        if (size <= _EK_HEAP_CACHE_SIZE(cls)) return cls;
+    }
+    return -1;
+}
 
-    if (!used)
+/* 块能服务的分级；比下一分级还大的块不进缓存，避免大块被长期占用 */
+static int32_t _ek_heap_cache_block_class(size_t block)
+{
+    for (int32_t cls = EK_HEAP_CACHE_CLASSES - 1; cls >= 0; cls--)
+    {
+        if (block >= _EK_HEAP_CACHE_SIZE(cls)) return (block < _EK_HEAP_CACHE_SIZE(cls + 1)) ? cls : -1;
+    }
+    return -1;
+}
+
+static void *_ek_heap_cache_get(ek_heap_cache_t *cache, int32_t cls, size_t size, void *caller)
+{
+    void *ptr = cache->head[cls];
+    if (ptr == NULL)
     {
-        ek_unused_bytes += size;
+        cache->misses++;
+        return NULL;
+    }
+
+    cache->head[cls] = *(void **)ptr;
+    cache->count[cls]--;
+    cache->hits++;
+
+#        if EK_HEAP_TRACE == 1
+    // 只有追踪表需要加锁，关闭追踪时命中路径完全不进入临界区
+    _EK_HEAP_LOCK();
+    _ek_heap_trace_add(ptr, size, caller);
+    _EK_HEAP_UNLOCK();
+#        else
+    __EK_UNUSED(size);
+    __EK_UNUSED(caller);
+#        endif /* EK_HEAP_TRACE */
+    return ptr;
+}
+
+static bool _ek_heap_cache_put(ek_heap_cache_t *cache, void *ptr)
+{
+    // 已分配块的大小字段只有所有者会改，读取不需要加锁
+    int32_t cls = _ek_heap_cache_block_class(tlsf_block_size(ptr));
+    if (cls < 0 || cache->count[cls] >= EK_HEAP_CACHE_DEPTH) return false;
+
+#        if EK_HEAP_TRACE == 1
+    _EK_HEAP_LOCK();
+    _ek_heap_trace_del(ptr);
+    _EK_HEAP_UNLOCK();
+#        endif /* EK_HEAP_TRACE */
+
+    *(void **)ptr = cache->head[cls];
+    cache->head[cls] = ptr;
+    cache->count[cls]++;
+    return true;
+}
+
+void ek_heap_cache_flush(ek_heap_cache_t *cache)
+{
+    ek_assert_param(cache != NULL);
+
+    _EK_HEAP_LOCK();
+    for (uint32_t cls = 0; cls < EK_HEAP_CACHE_CLASSES; cls++)
+    {
+        while (cache->head[cls] != NULL)
+        {
+            void *ptr = cache->head[cls];
+            cache->head[cls] = *(void **)ptr;
+            _ek_default_stats.free_count++;
+            _ek_default_stats.used -= tlsf_block_size(ptr);
+            tlsf_free(ek_default_tlsf, ptr);
+        }
+        cache->count[cls] = 0;
+    }
+    _EK_HEAP_UNLOCK();
+}
+#    endif /* EK_HEAP_CACHE_ENABLE */
+
+__EK_WEAK void *_ek_malloc(size_t size)
+{
+    void *caller = __EK_RETURN_ADDR();
+    size_t block = size;
+
+#    if EK_HEAP_CACHE_ENABLE == 1
+    ek_heap_cache_t *cache = ek_mem_task_cache();
+    int32_t cls = _ek_heap_cache_class(size);
+    if (cache != NULL && cls >= 0)
+    {
+        void *ptr = _ek_heap_cache_get(cache, cls, size, caller);
+        if (ptr != NULL) return ptr;
+        // 未命中时按整个分级申请，释放后能服务同一分级的任何请求
+        block = _EK_HEAP_CACHE_SIZE(cls);
+    }
+#    endif /* EK_HEAP_CACHE_ENABLE */
+
+    return _ek_heap_alloc(ek_default_tlsf, &_ek_default_stats, block, size, caller);
+}
+
+__EK_WEAK void *_ek_realloc(void *ptr, size_t size)
+{
+    void *caller = __EK_RETURN_ADDR();
+    if (ptr == NULL) return _ek_heap_alloc(ek_default_tlsf, &_ek_default_stats, size, size, caller);
+
+    tlsf_t tlsf;
+    ek_heap_stats_t *stats = _ek_heap_owner(ptr, &tlsf);
+
+    _EK_HEAP_LOCK();
+    size_t old_size = tlsf_block_size(ptr);
+    void *new_ptr = tlsf_realloc(tlsf, ptr, size);
+    if (size == 0)
+    {
+        // size 为 0 时 tlsf_realloc 等同于释放
+        stats->free_count++;
+        stats->used -= old_size;
+        _ek_heap_trace_del(ptr);
+    }
+    else if (new_ptr == NULL)
+    {
+        stats->failed_count++;
     }
     else
     {
-        ek_used_bytes += size;
+        stats->used = stats->used - old_size + tlsf_block_size(new_ptr);
+        if (stats->used > stats->peak) stats->peak = stats->used;
+        // 记录归属到最后一次调整大小的调用点
+        _ek_heap_trace_del(ptr);
+        _ek_heap_trace_add(new_ptr, size, caller);
+    }
+    _EK_HEAP_UNLOCK();
+
+    return new_ptr;
+}
+
+__EK_WEAK void _ek_free(void *ptr)
+{
+    if (ptr == NULL) return;
+
+    tlsf_t tlsf;
+    ek_heap_stats_t *stats = _ek_heap_owner(ptr, &tlsf);
+
+#    if EK_HEAP_CACHE_ENABLE == 1
+    if (tlsf == ek_default_tlsf)
+    {
+        ek_heap_cache_t *cache = ek_mem_task_cache();
+        if (cache != NULL && _ek_heap_cache_put(cache, ptr)) return;
     }
+#    endif /* EK_HEAP_CACHE_ENABLE */
+
+    _EK_HEAP_LOCK();
+    stats->free_count++;
+    stats->used -= tlsf_block_size(ptr);
+    _ek_heap_trace_del(ptr);
+    tlsf_free(tlsf, ptr);
+    _EK_HEAP_UNLOCK();
+}
+
+/* 填充只能在查询时得到的字段，其余字段直接拷贝运行计数 */
+static void _ek_heap_stats_fill(const ek_heap_stats_t *counter, tlsf_t tlsf, ek_heap_stats_t *stats)
+{
+    _EK_HEAP_LOCK();
+    *stats = *counter;
+    stats->largest_free = (tlsf != NULL) ? tlsf_largest_free(tlsf) : 0;
+    _EK_HEAP_UNLOCK();
+}
+
+void ek_heap_stats(ek_heap_stats_t *stats)
+{
+    _ek_default_stats.total = ek_heap_total_size();
+    _ek_heap_stats_fill(&_ek_default_stats, ek_default_tlsf, stats);
+}
+
+/* 空闲字节数 = 总量 - 已用 - 已分配块的块头；空闲块自身的块头未扣除，所以会比逐块遍历略大 */
+static size_t _ek_heap_unused_of(const ek_heap_stats_t *stats)
+{
+    _EK_HEAP_LOCK();
+    size_t overhead = (size_t)(stats->alloc_count - stats->free_count) * tlsf_alloc_overhead();
+    size_t taken = stats->used + overhead;
+    _EK_HEAP_UNLOCK();
+    return (stats->total > taken) ? (stats->total - taken) : 0;
 }
 
 size_t ek_heap_unused(void)
 {
-    pool_t pool = tlsf_get_pool(ek_default_tlsf);
-    ek_unused_bytes = 0;
-    tlsf_walk_pool(pool, ek_mem_walker, NULL);
-    return ek_unused_bytes;
+    _ek_default_stats.total = ek_heap_total_size();
+    return _ek_heap_unused_of(&_ek_default_stats);
 }
 
 size_t ek_heap_used(void)
 {
-    pool_t pool = tlsf_get_pool(ek_default_tlsf);
-    ek_used_bytes = 0;
-    tlsf_walk_pool(pool, ek_mem_walker, NULL);
-    return ek_used_bytes;
+    return _ek_default_stats.used;
+}
+
+/* TLSF 的一级分级数不超过 32（一级位图是一个 unsigned int） */
+#    define _EK_HEAP_FRAG_MAX_CLASSES (32U)
+
+uint32_t ek_heap_frag_histogram(uint32_t counts[], uint32_t classes)
+{
+    unsigned int tmp[_EK_HEAP_FRAG_MAX_CLASSES];
+    if (classes > _EK_HEAP_FRAG_MAX_CLASSES) classes = _EK_HEAP_FRAG_MAX_CLASSES;
+
+    _EK_HEAP_LOCK();
+    uint32_t filled = (uint32_t)tlsf_free_histogram(ek_default_tlsf, tmp, (int)classes);
+    _EK_HEAP_UNLOCK();
+    for (uint32_t i = 0; i < filled; i++) counts[i] = tmp[i];
+    return filled;
+}
+
+size_t ek_heap_frag_class_size(uint32_t cls)
+{
+    return tlsf_fl_class_size((int)cls);
+}
+
+#    ifndef EK_HEAP_DUMP_SITES
+#        define EK_HEAP_DUMP_SITES (16) /* heap 命令最多打印的调用点数量 */
+#    endif
+
+void ek_heap_dump(void)
+{
+    ek_heap_stats_t stats;
+    ek_heap_stats(&stats);
+    ek_printf("heap: total %lu, used %lu, peak %lu, largest free %lu" CRLF,
+              (unsigned long)stats.total,
+              (unsigned long)stats.used,
+              (unsigned long)stats.peak,
+              (unsigned long)stats.largest_free);
+    ek_printf("      alloc %lu, free %lu, failed %lu" CRLF,
+              (unsigned long)stats.alloc_count,
+              (unsigned long)stats.free_count,
+              (unsigned long)stats.failed_count);
+
+    uint32_t counts[_EK_HEAP_FRAG_MAX_CLASSES];
+    uint32_t classes = ek_heap_frag_histogram(counts, _EK_HEAP_FRAG_MAX_CLASSES);
+    ek_printf("free blocks by size class:" CRLF);
+    for (uint32_t i = 0; i < classes; i++)
+    {
+        if (counts[i] == 0) continue;
+        ek_printf("  >= %8lu: %lu" CRLF, (unsigned long)ek_heap_frag_class_size(i), (unsigned long)counts[i]);
+    }
+
+#    if EK_HEAP_TRACE == 1
+    ek_heap_trace_site_t sites[EK_HEAP_DUMP_SITES];
+    uint32_t amount = ek_heap_trace_report(sites, EK_HEAP_DUMP_SITES);
+    ek_printf("live allocations: %lu (lost %lu)" CRLF,
+              (unsigned long)ek_heap_trace_live(),
+              (unsigned long)ek_heap_trace_lost());
+    ek_printf("  caller             count      bytes   oldest" CRLF);
+    for (uint32_t i = 0; i < amount; i++)
+    {
+        ek_printf("  0x%-14p %7lu %10lu %8lu" CRLF,
+                  sites[i].caller,
+                  (unsigned long)sites[i].count,
+                  (unsigned long)sites[i].bytes,
+                  (unsigned long)sites[i].oldest_tick);
+    }
+#    endif /* EK_HEAP_TRACE */
+}
+
+#    if EK_SHELL_ENABLE == 1
+EK_SHELL_EXPORT_CMD(heap, ek_heap_dump, show heap stats and live allocations);
+#    endif
+
+#    if EK_HEAP_REGION_ENABLE == 1
+// 名字加括号，追踪模式下不被同名的包装宏展开
+void *(ek_malloc_in)(ek_heap_t *heap, size_t size)
+{
+    void *caller = __EK_RETURN_ADDR();
+    if (heap == NULL || heap == &ek_heap_dma || heap->tlsf == NULL)
+    {
+        return _ek_heap_alloc(ek_default_tlsf, &_ek_default_stats, size, size, caller);
+    }
+    return _ek_heap_alloc(heap->tlsf, &heap->stats, size, size, caller);
+}
+
+void ek_heap_stats_in(ek_heap_t *heap, ek_heap_stats_t *stats)
+{
+    if (heap == &ek_heap_dma)
+    {
+        ek_heap_stats(stats);
+        return;
+    }
+    _ek_heap_stats_fill(&heap->stats, heap->tlsf, stats);
+}
+
+size_t ek_heap_unused_in(ek_heap_t *heap)
+{
+    if (heap == &ek_heap_dma) return ek_heap_unused();
+    return _ek_heap_unused_of(&heap->stats);
+}
+
+size_t ek_heap_used_in(ek_heap_t *heap)
+{
+    if (heap == &ek_heap_dma) return ek_heap_used();
+    return heap->stats.used;
 }
+#    endif /* EK_HEAP_REGION_ENABLE */
 
 #endif /* EK_HEAP_NO_TLSF */
@@ -0,0 +1,133 @@
+/**
+ * @file ek_mempool.c
+ * @brief 固定大小内存块池实现
+ * @author N1netyNine99
+ */
+
+#include "ek_mempool.h"
+
+#if EK_MEMPOOL_ENABLE == 1
+
+#    include "ek_mem.h"
+#    include "ek_assert.h"
+
+void ek_mempool_init(ek_mempool_t *mp, void *storage, size_t block_size, uint32_t block_amount)
+{
+    ek_assert_param(mp != NULL);
+    ek_assert_param(storage != NULL);
+    ek_assert_param(((uintptr_t)storage & (EK_MEMPOOL_ALIGN - 1U)) == 0U);
+    ek_assert_param(block_size != 0U);
+    ek_assert_param(block_amount != 0U);
+
+    mp->storage = (uint8_t *)storage;
+    mp->block_size = EK_MEMPOOL_BLOCK_SIZE(block_size);
+    mp->block_amount = block_amount;
+    mp->carved = 0U;
+    mp->free_list = NULL;
+    mp->used = 0U;
+    mp->peak = 0U;
+}
+
+ek_mempool_t *ek_mempool_create(size_t block_size, uint32_t block_amount)
+{
+    ek_assert_param(block_size != 0U);
+    ek_assert_param(block_amount != 0U);
+
+    // 池头之后紧跟存储区，只占一次堆分配
+    size_t head_size = EK_MEMPOOL_BLOCK_SIZE(sizeof(ek_mempool_t));
+    ek_mempool_t *mp = (ek_mempool_t *)ek_malloc(head_size + EK_MEMPOOL_BLOCK_SIZE(block_size) * block_amount);
+    if (mp == NULL)
+    {
+        return NULL;
+    }
+
+    ek_mempool_init(mp, (uint8_t *)mp + head_size, block_size, block_amount);
+
+    return mp;
+}
+
+void ek_mempool_destroy(ek_mempool_t *mp)
+{
+    ek_assert_param(mp != NULL);
+
+    ek_free(mp);
+}
+
+void *ek_mempool_alloc(ek_mempool_t *mp)
+{
+    ek_assert_param(mp != NULL);
+
+    void *block = NULL;
+
+    ek_mem_enter_critical();
+
+    if (mp->free_list != NULL)
+    {
+        block = mp->free_list;
+        mp->free_list = *(void **)block;
+    }
+    else if (mp->carved < mp->block_amount)
+    {
+        // 从未分配过的块直接按顺序切出，省去初始化时串链表
+        block = mp->storage + mp->carved * mp->block_size;
+        mp->carved++;
+    }
+
+    if (block != NULL)
+    {
+        mp->used++;
+        if (mp->used > mp->peak) mp->peak = mp->used;
+    }
+
+    ek_mem_exit_critical();
+
+    return block;
+}
+
+void ek_mempool_free(ek_mempool_t *mp, void *ptr)
+{
+    ek_assert_param(mp != NULL);
+    ek_assert_param(ek_mempool_contains(mp, ptr));
+    ek_assert_param(((size_t)((uint8_t *)ptr - mp->storage) % mp->block_size) == 0U);
+
+    ek_mem_enter_critical();
+
+    *(void **)ptr = mp->free_list;
+    mp->free_list = ptr;
+    mp->used--;
+
+    ek_mem_exit_critical();
+}
+
+bool ek_mempool_contains(const ek_mempool_t *mp, const void *ptr)
+{
+    ek_assert_param(mp != NULL);
+
+    // carved 在分配时增长，和分配放在同一个临界区里读取
+    ek_mem_enter_critical();
+    uint32_t carved = mp->carved;
+    ek_mem_exit_critical();
+
+    const uint8_t *p = (const uint8_t *)ptr;
+    return p >= mp->storage && p < mp->storage + carved * mp->block_size;
+}
+
+uint32_t ek_mempool_used(const ek_mempool_t *mp)
+{
+    ek_assert_param(mp != NULL);
+    return mp->used;
+}
+
+uint32_t ek_mempool_unused(const ek_mempool_t *mp)
+{
+    ek_assert_param(mp != NULL);
+    return mp->block_amount - mp->used;
+}
+
+uint32_t ek_mempool_peak(const ek_mempool_t *mp)
+{
+    ek_assert_param(mp != NULL);
+    return mp->peak;
+}
+
+#endif /* EK_MEMPOOL_ENABLE */
@@ -6,11 +6,24 @@
 
 #include "ek_ringbuf.h"
 
-#if (EK_RINGBUF_ENABLE == 1) || (EK_RINGBUF_SPSC_ENABLE == 1)
+#if (EK_RINGBUF_ENABLE == 1) || (EK_RINGBUF_SPSC_ENABLE == 1) || (EK_RINGBUF_MPMC_ENABLE == 1)
 
 #    include "ek_mem.h"
 #    include "ek_assert.h"
 
+#    if (EK_RINGBUF_SPSC_ENABLE == 1 && EK_RINGBUF_SPSC_POW2 == 1) || (EK_RINGBUF_MPMC_ENABLE == 1)
+static uint32_t _ek_ringbuf_roundup_pow2(uint32_t val)
+{
+    val--;
+    val |= val >> 1;
+    val |= val >> 2;
+    val |= val >> 4;
+    val |= val >> 8;
+    val |= val >> 16;
+    return val + 1U;
+}
+#    endif
+
 #    if EK_RINGBUF_ENABLE == 1
 #        if EK_USE_RTOS == 1
 #            define EK_LOCKUP(prb)    ((prb)->lock = true)
@@ -34,6 +47,24 @@ bool ek_ringbuf_empty(const ek_ringbuf_t *rb)
     return rb->item_amount == 0;
 }
 
+void ek_ringbuf_init(ek_ringbuf_t *rb, void *storage, size_t item_size, uint32_t item_amount)
+{
+    ek_assert_param(rb != NULL);
+    ek_assert_param(storage != NULL);
+    ek_assert_param(item_amount != 0);
+    ek_assert_param(item_size != 0);
+
+    rb->buffer = (uint8_t *)storage;
+    rb->cap = item_amount;
+    rb->item_size = item_size;
+    rb->read_idx = 0;
+    rb->write_idx = 0;
+    rb->item_amount = 0;
+#        if EK_USE_RTOS == 1
+    rb->lock = false;
+#        endif /* EK_USE_RTOS */
+}
+
 ek_ringbuf_t *ek_ringbuf_create(size_t item_size, uint32_t item_amount)
 {
     ek_assert_param(item_amount != 0);
@@ -44,21 +75,14 @@ ek_ringbuf_t *ek_ringbuf_create(size_t item_size, uint32_t item_amount)
     {
         return NULL;
     }
-    rb->buffer = (uint8_t *)ek_malloc(item_amount * item_size);
-    if (rb->buffer == NULL)
+    void *storage = ek_malloc(item_amount * item_size);
+    if (storage == NULL)
     {
         ek_free(rb);
         return NULL;
     }
 
-    rb->cap = item_amount;
-    rb->item_size = item_size;
-    rb->read_idx = 0;
-    rb->write_idx = 0;
-    rb->item_amount = 0;
-#        if EK_USE_RTOS == 1
-    rb->lock = false;
-#        endif /* EK_USE_RTOS */
+    ek_ringbuf_init(rb, storage, item_size, item_amount);
 
     return rb;
 }
@@ -150,26 +174,118 @@ bool ek_ringbuf_peek(ek_ringbuf_t *rb, void *item)
 #    endif /* EK_RINGBUF_ENABLE */
 
 #    if EK_RINGBUF_SPSC_ENABLE == 1
-__EK_STATIC_INLINE uint32_t _ek_ringbuf_spsc_next_idx(const ek_ringbuf_spsc_t *rb, uint32_t idx)
+/*
+ * 索引约定：
+ * - write_idx 只由生产者修改，read_idx 只由消费者修改
+ * - 读对方的索引用获取语义，发布自己的索引用释放语义，
+ *   保证索引可见时槽位中的数据一定已经写完/读完
+ * - EK_RINGBUF_SPSC_POW2 == 1 时索引自由增长，通过掩码映射到槽位，
+ *   全部槽位都可用；否则索引在 [0, cap) 内回绕，保留一个空槽区分满/空
+ */
+#        if EK_RINGBUF_SPSC_POW2 == 1
+__EK_STATIC_INLINE uint32_t _ek_ringbuf_spsc_slot(const ek_ringbuf_spsc_t *rb, uint32_t idx)
+{
+    return idx & rb->mask;
+}
+
+__EK_STATIC_INLINE uint32_t _ek_ringbuf_spsc_advance_idx(const ek_ringbuf_spsc_t *rb, uint32_t idx, uint32_t amount)
+{
+    __EK_UNUSED(rb);
+    return idx + amount;
+}
+
+__EK_STATIC_INLINE uint32_t _ek_ringbuf_spsc_used(const ek_ringbuf_spsc_t *rb, uint32_t read_idx, uint32_t write_idx)
+{
+    __EK_UNUSED(rb);
+    return write_idx - read_idx;
+}
+
+__EK_STATIC_INLINE uint32_t _ek_ringbuf_spsc_capacity(const ek_ringbuf_spsc_t *rb)
+{
+    return (uint32_t)rb->cap;
+}
+#        else
+__EK_STATIC_INLINE uint32_t _ek_ringbuf_spsc_slot(const ek_ringbuf_spsc_t *rb, uint32_t idx)
+{
+    __EK_UNUSED(rb);
+    return idx;
+}
+
+__EK_STATIC_INLINE uint32_t _ek_ringbuf_spsc_advance_idx(const ek_ringbuf_spsc_t *rb, uint32_t idx, uint32_t amount)
+{
+    idx += amount;
+    return (idx >= rb->cap) ? (idx - (uint32_t)rb->cap) : idx;
+}
+
+__EK_STATIC_INLINE uint32_t _ek_ringbuf_spsc_used(const ek_ringbuf_spsc_t *rb, uint32_t read_idx, uint32_t write_idx)
+{
+    return (write_idx >= read_idx) ? (write_idx - read_idx) : (write_idx + (uint32_t)rb->cap - read_idx);
+}
+
+__EK_STATIC_INLINE uint32_t _ek_ringbuf_spsc_capacity(const ek_ringbuf_spsc_t *rb)
+{
+    return (uint32_t)rb->cap - 1U;
+}
+#        endif /* EK_RINGBUF_SPSC_POW2 */
+
+// 从 idx 开始切出 amount 个元素，回绕时拆成两段
+static void _ek_ringbuf_spsc_fill_span(const ek_ringbuf_spsc_t *rb,
+                                       uint32_t idx,
+                                       uint32_t amount,
+                                       ek_ringbuf_span_t span[2])
 {
-    return (idx + 1U) % rb->cap;
+    uint32_t slot = _ek_ringbuf_spsc_slot(rb, idx);
+    uint32_t first = (uint32_t)rb->cap - slot;
+    if (first > amount) first = amount;
+
+    span[0].buf = rb->buffer + (slot * rb->item_size);
+    span[0].amount = first;
+    span[1].buf = (amount > first) ? rb->buffer : NULL;
+    span[1].amount = amount - first;
 }
 
 bool ek_ringbuf_full_spsc(const ek_ringbuf_spsc_t *rb)
 {
     ek_assert_param(rb != NULL);
-    return _ek_ringbuf_spsc_next_idx(rb, rb->write_idx) == rb->read_idx;
+    return ek_ringbuf_space_spsc(rb) == 0U;
 }
 
 bool ek_ringbuf_empty_spsc(const ek_ringbuf_spsc_t *rb)
 {
     ek_assert_param(rb != NULL);
-    return rb->read_idx == rb->write_idx;
+    return __EK_LOAD_ACQUIRE(&rb->read_idx) == __EK_LOAD_ACQUIRE(&rb->write_idx);
+}
+
+void ek_ringbuf_init_spsc(ek_ringbuf_spsc_t *rb, void *storage, size_t item_size, uint32_t item_amount)
+{
+    ek_assert_param(rb != NULL);
+    ek_assert_param(storage != NULL);
+#        if EK_RINGBUF_SPSC_POW2 == 1
+    ek_assert_param(EK_IS_POW2(item_amount));
+#        else
+    ek_assert_param(item_amount > 1U);
+#        endif /* EK_RINGBUF_SPSC_POW2 */
+    ek_assert_param(item_size != 0U);
+
+    rb->buffer = (uint8_t *)storage;
+    rb->cap = item_amount;
+    rb->item_size = item_size;
+#        if EK_RINGBUF_SPSC_POW2 == 1
+    rb->mask = item_amount - 1U;
+#        endif /* EK_RINGBUF_SPSC_POW2 */
+    rb->read_idx = 0U;
+    rb->write_idx = 0U;
 }
 
 ek_ringbuf_spsc_t *ek_ringbuf_create_spsc(size_t item_size, uint32_t item_amount)
 {
+#        if EK_RINGBUF_SPSC_POW2 == 1
+    ek_assert_param(item_amount != 0U);
+    ek_assert_param(item_amount <= 0x80000000U);
+    item_amount = _ek_ringbuf_roundup_pow2(item_amount);
+#        else
     ek_assert_param(item_amount > 1U);
+#        endif /* EK_RINGBUF_SPSC_POW2 */
     ek_assert_param(item_size != 0U);
 
     ek_ringbuf_spsc_t *rb = (ek_ringbuf_spsc_t *)ek_malloc(sizeof(ek_ringbuf_spsc_t));
@@ -178,17 +294,14 @@ ek_ringbuf_spsc_t *ek_ringbuf_create_spsc(size_t item_size, uint32_t item_amount
         return NULL;
     }
 
-    rb->buffer = (uint8_t *)ek_malloc(item_amount * item_size);
-    if (rb->buffer == NULL)
+    void *storage = ek_malloc(item_amount * item_size);
+    if (storage == NULL)
     {
         ek_free(rb);
         return NULL;
     }
 
-    rb->cap = item_amount;
-    rb->item_size = item_size;
-    rb->read_idx = 0U;
-    rb->write_idx = 0U;
+    ek_ringbuf_init_spsc(rb, storage, item_size, item_amount);
 
     return rb;
 }
@@ -206,15 +319,16 @@ bool ek_ringbuf_write_spsc(ek_ringbuf_spsc_t *rb, const void *item)
     ek_assert_param(rb != NULL);
     ek_assert_param(item != NULL);
 
-    uint32_t next_idx = _ek_ringbuf_spsc_next_idx(rb, rb->write_idx);
-    if (next_idx == rb->read_idx)
+    uint32_t write_idx = rb->write_idx;
+    uint32_t read_idx = __EK_LOAD_ACQUIRE(&rb->read_idx);
+    if (_ek_ringbuf_spsc_used(rb, read_idx, write_idx) >= _ek_ringbuf_spsc_capacity(rb))
     {
         return false;
     }
 
-    uint8_t *target = rb->buffer + (rb->write_idx * rb->item_size);
+    uint8_t *target = rb->buffer + (_ek_ringbuf_spsc_slot(rb, write_idx) * rb->item_size);
     memcpy(target, item, rb->item_size);
-    rb->write_idx = next_idx;
+    __EK_STORE_RELEASE(&rb->write_idx, _ek_ringbuf_spsc_advance_idx(rb, write_idx, 1U));
 
     return true;
 }
@@ -223,18 +337,19 @@ bool ek_ringbuf_read_spsc(ek_ringbuf_spsc_t *rb, void *item)
 {
     ek_assert_param(rb != NULL);
 
-    if (rb->read_idx == rb->write_idx)
+    uint32_t read_idx = rb->read_idx;
+    if (read_idx == __EK_LOAD_ACQUIRE(&rb->write_idx))
     {
         return false;
     }
 
     if (item != NULL)
     {
-        const uint8_t *source = rb->buffer + (rb->read_idx * rb->item_size);
+        const uint8_t *source = rb->buffer + (_ek_ringbuf_spsc_slot(rb, read_idx) * rb->item_size);
         memcpy(item, source, rb->item_size);
     }
 
-    rb->read_idx = _ek_ringbuf_spsc_next_idx(rb, rb->read_idx);
+    __EK_STORE_RELEASE(&rb->read_idx, _ek_ringbuf_spsc_advance_idx(rb, read_idx, 1U));
 
     return true;
 }
@@ -244,16 +359,282 @@ bool ek_ringbuf_peek_spsc(ek_ringbuf_spsc_t *rb, void *item)
     ek_assert_param(rb != NULL);
     ek_assert_param(item != NULL);
 
-    if (rb->read_idx == rb->write_idx)
+    uint32_t read_idx = rb->read_idx;
+    if (read_idx == __EK_LOAD_ACQUIRE(&rb->write_idx))
     {
         return false;
     }
 
-    const uint8_t *source = rb->buffer + (rb->read_idx * rb->item_size);
+    const uint8_t *source = rb->buffer + (_ek_ringbuf_spsc_slot(rb, read_idx) * rb->item_size);
     memcpy(item, source, rb->item_size);
 
     return true;
 }
+
+uint32_t ek_ringbuf_count_spsc(const ek_ringbuf_spsc_t *rb)
+{
+    ek_assert_param(rb != NULL);
+
+    uint32_t read_idx = __EK_LOAD_ACQUIRE(&rb->read_idx);
+    uint32_t write_idx = __EK_LOAD_ACQUIRE(&rb->write_idx);
+
+    return _ek_ringbuf_spsc_used(rb, read_idx, write_idx);
+}
+
+uint32_t ek_ringbuf_space_spsc(const ek_ringbuf_spsc_t *rb)
+{
+    ek_assert_param(rb != NULL);
+    return _ek_ringbuf_spsc_capacity(rb) - ek_ringbuf_count_spsc(rb);
+}
+
+uint32_t ek_ringbuf_write_bulk_spsc(ek_ringbuf_spsc_t *rb, const void *items, uint32_t amount)
+{
+    ek_assert_param(rb != NULL);
+    ek_assert_param(items != NULL);
+
+    ek_ringbuf_span_t span[2];
+    amount = ek_ringbuf_acquire_write_spsc(rb, span, amount);
+    if (amount == 0U) return 0U;
+
+    size_t first_bytes = span[0].amount * rb->item_size;
+    memcpy(span[0].buf, items, first_bytes);
+    if (span[1].amount != 0U)
+    {
+        memcpy(span[1].buf, (const uint8_t *)items + first_bytes, span[1].amount * rb->item_size);
+    }
+
+    ek_ringbuf_commit_write_spsc(rb, amount);
+
+    return amount;
+}
+
+uint32_t ek_ringbuf_read_bulk_spsc(ek_ringbuf_spsc_t *rb, void *items, uint32_t amount)
+{
+    ek_assert_param(rb != NULL);
+
+    ek_ringbuf_span_t span[2];
+    amount = ek_ringbuf_acquire_read_spsc(rb, span, amount);
+    if (amount == 0U) return 0U;
+
+    if (items != NULL)
+    {
+        size_t first_bytes = span[0].amount * rb->item_size;
+        memcpy(items, span[0].buf, first_bytes);
+        if (span[1].amount != 0U)
+        {
+            memcpy((uint8_t *)items + first_bytes, span[1].buf, span[1].amount * rb->item_size);
+        }
+    }
+
+    ek_ringbuf_release_read_spsc(rb, amount);
+
+    return amount;
+}
+
+uint32_t ek_ringbuf_acquire_write_spsc(ek_ringbuf_spsc_t *rb, ek_ringbuf_span_t span[2], uint32_t amount)
+{
+    ek_assert_param(rb != NULL);
+    ek_assert_param(span != NULL);
+
+    uint32_t write_idx = rb->write_idx;
+    uint32_t read_idx = __EK_LOAD_ACQUIRE(&rb->read_idx);
+    uint32_t space = _ek_ringbuf_spsc_capacity(rb) - _ek_ringbuf_spsc_used(rb, read_idx, write_idx);
+    if (amount > space) amount = space;
+
+    _ek_ringbuf_spsc_fill_span(rb, write_idx, amount, span);
+
+    return amount;
+}
+
+void ek_ringbuf_commit_write_spsc(ek_ringbuf_spsc_t *rb, uint32_t amount)
+{
+    ek_assert_param(rb != NULL);
+    ek_assert_param(amount <= ek_ringbuf_space_spsc(rb));
+
+    __EK_STORE_RELEASE(&rb->write_idx, _ek_ringbuf_spsc_advance_idx(rb, rb->write_idx, amount));
+}
+
+uint32_t ek_ringbuf_acquire_read_spsc(ek_ringbuf_spsc_t *rb, ek_ringbuf_span_t span[2], uint32_t amount)
+{
+    ek_assert_param(rb != NULL);
+    ek_assert_param(span != NULL);
+
+    uint32_t read_idx = rb->read_idx;
+    uint32_t count = _ek_ringbuf_spsc_used(rb, read_idx, __EK_LOAD_ACQUIRE(&rb->write_idx));
+    if (amount > count) amount = count;
+
+    _ek_ringbuf_spsc_fill_span(rb, read_idx, amount, span);
+
+    return amount;
+}
+
+void ek_ringbuf_release_read_spsc(ek_ringbuf_spsc_t *rb, uint32_t amount)
+{
+    ek_assert_param(rb != NULL);
+    ek_assert_param(amount <= ek_ringbuf_count_spsc(rb));
+
+    __EK_STORE_RELEASE(&rb->read_idx, _ek_ringbuf_spsc_advance_idx(rb, rb->read_idx, amount));
+}
 #    endif /* EK_RINGBUF_SPSC_ENABLE */
 
-#endif /* EK_RINGBUF_ENABLE || EK_RINGBUF_SPSC_ENABLE */
+#    if EK_RINGBUF_MPMC_ENABLE == 1
+/*
+ * Vyukov 有界 MPMC 队列：
+ * - 槽位 i 的序号初始为 i
+ * - 序号 == pos 表示该槽位可写，写完后发布为 pos + 1
+ * - 序号 == pos + 1 表示该槽位可读，读完后发布为 pos + cap，留给下一圈的生产者
+ * - 序号落后说明满/空，超前说明位置已被别人抢走，重新读取位置后重试
+ */
+__EK_STATIC_INLINE uint32_t *_ek_ringbuf_mpmc_seq(const ek_ringbuf_mpmc_t *rb, uint32_t pos)
+{
+    return (uint32_t *)(rb->buffer + (pos & rb->mask) * rb->slot_size);
+}
+
+void ek_ringbuf_init_mpmc(ek_ringbuf_mpmc_t *rb, void *storage, size_t item_size, uint32_t item_amount)
+{
+    ek_assert_param(rb != NULL);
+    ek_assert_param(storage != NULL);
+    ek_assert_param(((uintptr_t)storage & 3U) == 0U);
+    ek_assert_param(EK_IS_POW2(item_amount) && item_amount >= 2U);
+    ek_assert_param(item_size != 0U);
+
+    rb->buffer = (uint8_t *)storage;
+    rb->cap = item_amount;
+    rb->item_size = item_size;
+    // 元素按 4 字节对齐，保证每个槽位开头的序号可以原子访问
+    rb->slot_size = EK_RINGBUF_MPMC_SLOT_SIZE(item_size);
+    rb->mask = item_amount - 1U;
+    rb->enqueue_pos = 0U;
+    rb->dequeue_pos = 0U;
+
+    for (uint32_t i = 0; i < item_amount; i++)
+    {
+        *_ek_ringbuf_mpmc_seq(rb, i) = i;
+    }
+}
+
+ek_ringbuf_mpmc_t *ek_ringbuf_create_mpmc(size_t item_size, uint32_t item_amount)
+{
+    ek_assert_param(item_amount != 0U);
+    ek_assert_param(item_amount <= 0x80000000U);
+    ek_assert_param(item_size != 0U);
+
+    item_amount = _ek_ringbuf_roundup_pow2(item_amount);
+    if (item_amount < 2U) item_amount = 2U;
+
+    ek_ringbuf_mpmc_t *rb = (ek_ringbuf_mpmc_t *)ek_malloc(sizeof(ek_ringbuf_mpmc_t));
+    if (rb == NULL)
+    {
+        return NULL;
+    }
+
+    void *storage = ek_malloc(item_amount * EK_RINGBUF_MPMC_SLOT_SIZE(item_size));
+    if (storage == NULL)
+    {
+        ek_free(rb);
+        return NULL;
+    }
+
+    ek_ringbuf_init_mpmc(rb, storage, item_size, item_amount);
+
+    return rb;
+}
+
+void ek_ringbuf_destroy_mpmc(ek_ringbuf_mpmc_t *rb)
+{
+    ek_assert_param(rb != NULL);
+
+    ek_free(rb->buffer);
+    ek_free(rb);
+}
+
+bool ek_ringbuf_write_mpmc(ek_ringbuf_mpmc_t *rb, const void *item)
+{
+    ek_assert_param(rb != NULL);
+    ek_assert_param(item != NULL);
+
+    uint32_t *seq;
+    uint32_t pos = __EK_LOAD_ACQUIRE(&rb->enqueue_pos);
+
+    while (1)
+    {
+        seq = _ek_ringbuf_mpmc_seq(rb, pos);
+        int32_t diff = (int32_t)(__EK_LOAD_ACQUIRE(seq) - pos);
+
+        if (diff == 0)
+        {
+            // 槽位空闲，抢占该位置；失败时 pos 会被更新为最新值
+            if (__EK_CAS(&rb->enqueue_pos, &pos, pos + 1U)) break;
+        }
+        else if (diff < 0)
+        {
+            // 槽位还没被上一圈的消费者读走，缓冲区已满
+            return false;
+        }
+        else
+        {
+            pos = __EK_LOAD_ACQUIRE(&rb->enqueue_pos);
+        }
+    }
+
+    memcpy(seq + 1, item, rb->item_size);
+    __EK_STORE_RELEASE(seq, pos + 1U);
+
+    return true;
+}
+
+bool ek_ringbuf_read_mpmc(ek_ringbuf_mpmc_t *rb, void *item)
+{
+    ek_assert_param(rb != NULL);
+
+    uint32_t *seq;
+    uint32_t pos = __EK_LOAD_ACQUIRE(&rb->dequeue_pos);
+
+    while (1)
+    {
+        seq = _ek_ringbuf_mpmc_seq(rb, pos);
+        int32_t diff = (int32_t)(__EK_LOAD_ACQUIRE(seq) - (pos + 1U));
+
+        if (diff == 0)
+        {
+            if (__EK_CAS(&rb->dequeue_pos, &pos, pos + 1U)) break;
+        }
+        else if (diff < 0)
+        {
+            // 槽位还没被生产者发布，缓冲区为空
+            return false;
+        }
+        else
+        {
+            pos = __EK_LOAD_ACQUIRE(&rb->dequeue_pos);
+        }
+    }
+
+    if (item != NULL)
+    {
+        memcpy(item, seq + 1, rb->item_size);
+    }
+    __EK_STORE_RELEASE(seq, pos + rb->mask + 1U);
+
+    return true;
+}
+
+uint32_t ek_ringbuf_count_mpmc(const ek_ringbuf_mpmc_t *rb)
+{
+    ek_assert_param(rb != NULL);
+
+    uint32_t dequeue_pos = __EK_LOAD_ACQUIRE(&rb->dequeue_pos);
+    uint32_t enqueue_pos = __EK_LOAD_ACQUIRE(&rb->enqueue_pos);
+    uint32_t count = enqueue_pos - dequeue_pos;
+
+    // 两次读取之间位置可能继续前进，结果钳位到合法范围
+    return (count > rb->cap) ? (uint32_t)rb->cap : count;
+}
+
+bool ek_ringbuf_empty_mpmc(const ek_ringbuf_mpmc_t *rb)
+{
+    return ek_ringbuf_count_mpmc(rb) == 0U;
+}
+#    endif /* EK_RINGBUF_MPMC_ENABLE */
+
+#endif /* EK_RINGBUF_ENABLE || EK_RINGBUF_SPSC_ENABLE || EK_RINGBUF_MPMC_ENABLE */
@@ -33,6 +33,22 @@ bool ek_stack_empty(ek_stack_t *sk)
     return sk->sp == 0;
 }
 
+void ek_stack_init(ek_stack_t *sk, void *storage, size_t item_size, uint32_t item_amount)
+{
+    ek_assert_param(sk != NULL);
+    ek_assert_param(storage != NULL);
+    ek_assert_param(item_amount != 0);
+    ek_assert_param(item_size != 0);
+
+    sk->buffer = storage;
+    sk->sp = 0;
+    sk->cap = item_amount;
+    sk->item_size = item_size;
+#    if EK_USE_RTOS == 1
+    sk->lock = false;
+#    endif /* EK_USE_RTOS */
+}
+
 ek_stack_t *ek_stack_create(size_t item_size, uint32_t item_amount)
 {
     ek_assert_param(item_amount != 0);
@@ -43,19 +59,14 @@ ek_stack_t *ek_stack_create(size_t item_size, uint32_t item_amount)
     {
         return NULL;
     }
-    sk->buffer = (uint8_t *)ek_malloc(item_amount * item_size);
-    if (sk->buffer == NULL)
+    void *storage = ek_malloc(item_amount * item_size);
+    if (storage == NULL)
     {
         ek_free(sk);
         return NULL;
     }
 
-    sk->sp = 0;
-    sk->cap = item_amount;
-    sk->item_size = item_size;
-#    if EK_USE_RTOS == 1
-    sk->lock = false;
-#    endif /* EK_USE_RTOS */
+    ek_stack_init(sk, storage, item_size, item_amount);
 
     return sk;
 }
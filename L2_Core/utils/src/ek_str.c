@@ -20,37 +20,78 @@
             if ((idx) > (len)) (idx) = (len); \
         } while (0)
 
+#    if EK_STR_USE_MEMPOOL == 1
+#        include "../inc/ek_mempool.h"
+
+EK_MEMPOOL_DEFINE(_str_pool, ek_str_t, EK_STR_POOL_SIZE);
+#    endif /* EK_STR_USE_MEMPOOL */
+
 static bool _ek_str_ensure_cap(ek_str_t *s, uint32_t len);
 
-ek_str_t *ek_str_create(const char *str)
+static ek_str_t *_ek_str_head_alloc(const ek_allocator_t *alloc)
+{
+    if (alloc != NULL) return ek_allocator_realloc(alloc, NULL, 0, sizeof(ek_str_t));
+#    if EK_STR_USE_MEMPOOL == 1
+    ek_str_t *s = ek_mempool_alloc(&_str_pool);
+    if (s != NULL) return s;
+#    endif /* EK_STR_USE_MEMPOOL */
+    return ek_malloc(sizeof(ek_str_t));
+}
+
+static void _ek_str_head_free(ek_str_t *s)
+{
+    if (s->alloc != NULL)
+    {
+        ek_allocator_free(s->alloc, s, sizeof(ek_str_t));
+        return;
+    }
+#    if EK_STR_USE_MEMPOOL == 1
+    if (ek_mempool_contains(&_str_pool, s))
+    {
+        ek_mempool_free(&_str_pool, s);
+        return;
+    }
+#    endif /* EK_STR_USE_MEMPOOL */
+    ek_free(s);
+}
+
+ek_str_t *ek_str_create_with(const ek_allocator_t *alloc, const char *str)
 {
-    ek_str_t *s = ek_malloc(sizeof(ek_str_t));
+    ek_str_t *s = _ek_str_head_alloc(alloc);
     if (s == NULL) return NULL;
 
     s->buf = NULL;
     s->cap = 0;
     s->len = 0;
+    s->alloc = alloc;
 
     // 传入 NULL 则创建一个空的字符串
     if (str == NULL) return s;
 
     if (ek_str_append(s, str) == false)
     {
-        ek_free(s);
+        _ek_str_head_free(s);
         return NULL;
     }
 
     return s;
 }
 
+ek_str_t *ek_str_create(const char *str)
+{
+    return ek_str_create_with(NULL, str);
+}
+
 void ek_str_free(ek_str_t *s)
 {
     ek_assert_param(s != NULL);
 
+    // 内容先于字符串头释放，arena 中后分配的块先归还才能真正回收
+    ek_allocator_free(s->alloc, s->buf, s->cap);
+    s->buf = NULL;
     s->cap = 0;
     s->len = 0;
-    ek_free(s->buf);
-    ek_free(s);
+    _ek_str_head_free(s);
 }
 
 void ek_str_clear(ek_str_t *s)
@@ -92,7 +133,7 @@ bool ek_str_append_fmt(ek_str_t *s, const char *fmt, ...)
 
     if (len < 0) return false;
 
-    if (_ek_str_ensure_cap(s, s->len + len) == false) return false;
+    if (_ek_str_ensure_cap(s, s->len + len + 1) == false) return false;
 
     va_start(args, fmt);
     // +1 给 \0
@@ -124,23 +165,23 @@ ek_str_t *ek_str_slice(const ek_str_t *s, int32_t start, int32_t end)
     INDEX_CLAMP(start, len);
     INDEX_CLAMP(end, len);
 
-    if (start == end) return ek_str_create("");
+    if (start == end) return ek_str_create_with(s->alloc, "");
 
     uint32_t new_len = (uint32_t)(end - start);
 
-    ek_str_t *new_s = ek_str_create(NULL);
+    ek_str_t *new_s = ek_str_create_with(s->alloc, NULL);
     if (new_s == NULL) return NULL;
 
-    new_s->buf = ek_malloc(new_len + 1);
+    new_s->buf = ek_allocator_realloc(s->alloc, NULL, 0, new_len + 1);
     if (new_s->buf == NULL)
     {
-        ek_free(new_s);
+        _ek_str_head_free(new_s);
         return NULL;
     }
 
     memcpy(new_s->buf, s->buf + start, new_len);
     new_s->len = new_len;
-    new_s->cap = new_len;
+    new_s->cap = new_len + 1;
     new_s->buf[new_s->len] = '\0';
 
     return new_s;
@@ -224,10 +265,7 @@ static bool _ek_str_ensure_cap(ek_str_t *s, uint32_t len)
         new_cap += new_cap / 2;
     } while (new_cap < len);
 
-    char *buf = NULL;
-
-    if (s->buf == NULL) buf = ek_malloc(len);
-    else buf = ek_realloc(s->buf, new_cap);
+    char *buf = ek_allocator_realloc(s->alloc, s->buf, s->cap, new_cap);
 
     if (buf == NULL) return false;
 
@@ -37,7 +37,8 @@ extern uint32_t SystemCoreClock;
 
 /* ========================================================================
  * 内存配置
- * - configTOTAL_HEAP_SIZE: FreeRTOS堆总大小(字节)，heap_4.c管理的内存池
+ * - configTOTAL_HEAP_SIZE: FreeRTOS堆总大小(字节)，仅heap_1~heap_5使用(默认heap_4.c)；
+ *                          EK_USE_RTOS为1时改用heap_ek.c，从ek_mem的TLSF堆分配，大小由EK_HEAP_SIZE决定
  * - configSUPPORT_STATIC_ALLOCATION: 支持静态内存分配
  * - configSUPPORT_DYNAMIC_ALLOCATION: 支持动态内存分配
  * - configAPPLICATION_ALLOCATED_HEAP: 用户自定义堆内存定义(如需放置在CCM RAM)
@@ -82,7 +83,7 @@ extern uint32_t SystemCoreClock;
  * - configTASK_NOTIFICATION_ARRAY_ENTRIES: 任务通知数组条目数
  * - configUSE_TASK_NOTIFICATIONS: 启用任务通知功能
  * - configUSE_APPLICATION_TASK_TAG: 启用任务标签功能
- * - configNUM_THREAD_LOCAL_STORAGE_POINTERS: 线程本地存储指针数量
+ * - configNUM_THREAD_LOCAL_STORAGE_POINTERS: 线程本地存储指针数量(下标0用于ek_mem每任务小块缓存)
  * - configUSE_NEWLIB_REENTRANT: 为每个任务分配newlib重入结构
  * - configUSE_STATS_FORMATTING_FUNCTIONS: 启用 vTaskList/vTaskGetRunTimeStats 格式化输出
  * - configSTATS_BUFFER_MAX_LENGTH: 统计信息缓冲区最大长度
@@ -92,7 +93,7 @@ extern uint32_t SystemCoreClock;
 #define configTASK_NOTIFICATION_ARRAY_ENTRIES   1
 #define configUSE_TASK_NOTIFICATIONS            1
 #define configUSE_APPLICATION_TASK_TAG          0
-#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 0
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 1
 #define configUSE_NEWLIB_REENTRANT              0
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 #define configSTATS_BUFFER_MAX_LENGTH           0xFFFF
@@ -0,0 +1,142 @@
+/**
+ * @file heap_ek.c
+ * @brief FreeRTOS 堆接口到 ek_mem 的适配
+ * @author N1netyNine99
+ *
+ * 代替 heap_1~heap_5，让 FreeRTOS 的任务栈、队列等和 ek_malloc 共用同一个 TLSF 堆：
+ * - configTOTAL_HEAP_SIZE 不再预留内存，EK_HEAP_SIZE 需要包含原来分给 FreeRTOS 的部分
+ * - 提供 ek_mem_enter_critical()/ek_mem_exit_critical() 的强定义，用 BASEPRI 屏蔽
+ *   受 FreeRTOS 管理的中断，任务和中断中都可以调用
+ * - 提供 ek_mem_task_cache() 的强定义，每任务小块缓存保存在线程本地存储指针中
+ *
+ * @note vPortGetHeapStats() 的 xSizeOfSmallestFreeBlockInBytes 取碎片直方图中最低非空分级的下界，
+ *       TLSF 只按分级记录空闲块，因此是最小空闲块大小的下限而不是精确值
+ * @note ek_conf.h 中 EK_USE_RTOS 为 1 时由 CMakeLists.txt 代替 heap_4.c 编译，
+ *       EK_HEAP_THREAD_SAFE 默认随之打开，不能单独关闭
+ * @note 任务使用缓存前需要绑定，任务删除前需要归还：
+ * @code
+ * static ek_heap_cache_t cache;
+ * vTaskSetThreadLocalStoragePointer(NULL, EK_HEAP_CACHE_TLS_INDEX, &cache);
+ * ...
+ * ek_heap_cache_flush(&cache);
+ * vTaskDelete(NULL);
+ * @endcode
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "ek_mem.h"
+
+#if EK_HEAP_THREAD_SAFE != 1
+#    error "heap_ek.c requires EK_HEAP_THREAD_SAFE, do not disable it while EK_USE_RTOS is 1"
+#endif
+
+/* 进入临界区前的 BASEPRI，只在最外层保存和恢复 */
+static UBaseType_t _ek_mem_saved_mask;
+static uint32_t _ek_mem_nesting;
+
+void ek_mem_enter_critical(void)
+{
+    UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    if (_ek_mem_nesting++ == 0) _ek_mem_saved_mask = mask;
+}
+
+void ek_mem_exit_critical(void)
+{
+    if (--_ek_mem_nesting == 0) portCLEAR_INTERRUPT_MASK_FROM_ISR(_ek_mem_saved_mask);
+}
+
+#if EK_HEAP_CACHE_ENABLE == 1
+
+#    ifndef EK_HEAP_CACHE_TLS_INDEX
+#        define EK_HEAP_CACHE_TLS_INDEX 0 /* 存放缓存指针的线程本地存储下标 */
+#    endif
+
+#    if configNUM_THREAD_LOCAL_STORAGE_POINTERS <= EK_HEAP_CACHE_TLS_INDEX
+#        error "EK_HEAP_CACHE_ENABLE needs configNUM_THREAD_LOCAL_STORAGE_POINTERS > EK_HEAP_CACHE_TLS_INDEX"
+#    endif
+
+ek_heap_cache_t *ek_mem_task_cache(void)
+{
+    // 调度器启动前没有当前任务，中断中不能使用任务的缓存
+    if (xPortIsInsideInterrupt() || xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) return NULL;
+    return (ek_heap_cache_t *)pvTaskGetThreadLocalStoragePointer(NULL, EK_HEAP_CACHE_TLS_INDEX);
+}
+
+#endif /* EK_HEAP_CACHE_ENABLE */
+
+void *pvPortMalloc(size_t xWantedSize)
+{
+    void *pvReturn = ek_malloc(xWantedSize);
+    traceMALLOC(pvReturn, xWantedSize);
+
+#if (configUSE_MALLOC_FAILED_HOOK == 1)
+    if (pvReturn == NULL)
+    {
+        vApplicationMallocFailedHook();
+    }
+#endif
+
+    return pvReturn;
+}
+
+void vPortFree(void *pv)
+{
+    traceFREE(pv, 0);
+    _ek_free(pv);
+}
+
+void *pvPortCalloc(size_t xNum, size_t xSize)
+{
+    if (xSize != 0 && xNum > SIZE_MAX / xSize) return NULL;
+
+    void *pv = pvPortMalloc(xNum * xSize);
+    if (pv != NULL) memset(pv, 0, xNum * xSize);
+    return pv;
+}
+
+size_t xPortGetFreeHeapSize(void)
+{
+    return ek_heap_unused();
+}
+
+size_t xPortGetMinimumEverFreeHeapSize(void)
+{
+    ek_heap_stats_t stats;
+    ek_heap_stats(&stats);
+    return stats.total - stats.peak;
+}
+
+void vPortGetHeapStats(HeapStats_t *pxHeapStats)
+{
+    ek_heap_stats_t stats;
+    ek_heap_stats(&stats);
+
+    uint32_t counts[32];
+    uint32_t classes = ek_heap_frag_histogram(counts, 32);
+    size_t blocks = 0;
+    size_t smallest = 0;
+    for (uint32_t i = 0; i < classes; i++)
+    {
+        if (blocks == 0 && counts[i] != 0) smallest = ek_heap_frag_class_size(i);
+        blocks += counts[i];
+    }
+
+    pxHeapStats->xAvailableHeapSpaceInBytes = ek_heap_unused();
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = stats.largest_free;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = smallest;
+    pxHeapStats->xNumberOfFreeBlocks = blocks;
+    pxHeapStats->xMinimumEverFreeBytesRemaining = stats.total - stats.peak;
+    pxHeapStats->xNumberOfSuccessfulAllocations = stats.alloc_count;
+    pxHeapStats->xNumberOfSuccessfulFrees = stats.free_count;
+}
+
+void vPortInitialiseBlocks(void)
+{
+    /* 堆由 ek_heap_init() 初始化 */
+}
+
+void vPortHeapResetState(void)
+{
+    /* 状态属于 ek_mem，由 ek_heap_init() 重新初始化 */
+}
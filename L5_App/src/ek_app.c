@@ -12,6 +12,14 @@ EK_IO_FPUTC()
     }
 }
 
+EK_IO_WRITE()
+{
+    // EK_IO_BUFFER_SIZE > 0 时 ek_printf 的输出按行整块到达这里，一行只调用一次驱动
+    static ek_hal_uart_t *uart1 = NULL;
+    if (uart1 == NULL) uart1 = ek_hal_uart_find("UART1");
+    if (uart1 != NULL) ek_hal_uart_write(uart1, (uint8_t *)buf, len);
+}
+
 EK_LOG_GET_TICK()
 {
 // 这里返回你系统的tick
@@ -30,6 +38,9 @@ void ek_main(void)
 {
     ek_heap_init();
     ek_io_init();
+#if EK_LOG_ENABLE == 1 && EK_LOG_PERSIST_ENABLE == 1
+    ek_log_persist_init(); // 热复位后保留复位前的日志，用 shell 命令 crashlog 查看
+#endif
     ek_export_init();
 
     while (1)
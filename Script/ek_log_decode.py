@@ -0,0 +1,218 @@
+#!/usr/bin/env python3
+"""
+ek_log 延迟二进制日志解码器
+
+设备在 EK_LOG_DEFER_ENABLE == 1 时只输出格式串 ID、时间戳和原始参数，
+格式描述串保存在 ELF 的 ek_log_fmt 段中。本脚本读取 ELF 和采集到的帧，
+还原成与 ek_log 文本模式相同的日志行。
+
+用法：
+    python3 ek_log_decode.py firmware.elf capture.bin
+    python3 ek_log_decode.py firmware.elf /dev/ttyUSB0 --serial 115200
+    cat capture.bin | python3 ek_log_decode.py firmware.elf -
+
+帧格式（小端）：
+    0xA5, len, id(4), tick(4), types(2), amount(1), data(len - 11)
+    types 每个参数 2 位：0 = 32 位整数，1 = 64 位整数，2 = double，3 = 字符串（1 字节长度 + 内容）
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+SYNC = 0xA5
+HEADER = 11
+SECTION = "ek_log_fmt"
+
+ARG_U32, ARG_U64, ARG_F64, ARG_STR = range(4)
+
+LEVELS = {
+    "N": ("None", "\033[0;0m"),
+    "D": ("Debug", "\033[92m"),
+    "I": ("Info", "\033[94m"),
+    "W": ("Warn", "\033[33m"),
+    "E": ("Error", "\033[91m"),
+}
+COLOR_NONE = "\033[0;0m"
+
+# %[flags][width][.precision][length]conversion
+SPEC = re.compile(r"%([-+ #0]*)(\d+|\*)?(\.\d+|\.\*)?(hh|h|ll|l|j|z|t|L)?([diouxXcspfFeEgG%])")
+
+
+def load_section(path, name=SECTION):
+    """从 ELF 中取出指定段的内容，只依赖段头表"""
+    with open(path, "rb") as f:
+        elf = f.read()
+    if elf[:4] != b"\x7fELF":
+        raise ValueError("%s is not an ELF file" % path)
+    is64 = elf[4] == 2
+    end = "<" if elf[5] == 1 else ">"
+    if is64:
+        shoff, = struct.unpack_from(end + "Q", elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(end + "HHH", elf, 0x3A)
+        shdr = end + "IIQQQQIIQQ"
+    else:
+        shoff, = struct.unpack_from(end + "I", elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(end + "HHH", elf, 0x2E)
+        shdr = end + "IIIIIIIIII"
+
+    sections = [struct.unpack_from(shdr, elf, shoff + i * shentsize) for i in range(shnum)]
+    strtab = sections[shstrndx]
+    for sh in sections:
+        sh_name, sh_type, offset, size = sh[0], sh[1], sh[4], sh[5]
+        start = strtab[4] + sh_name
+        if elf[start:elf.index(b"\0", start)].decode() == name:
+            if sh_type == 8:  # SHT_NOBITS
+                raise ValueError("section %s has no data in the file" % name)
+            return elf[offset:offset + size]
+    raise ValueError("section %s not found in %s" % (name, path))
+
+
+def parse_desc(section, fid):
+    """格式描述串：级别\\x1f行号\\x1f文件\\x1f格式串"""
+    if fid >= len(section):
+        return None
+    end = section.find(b"\0", fid)
+    parts = section[fid:end].decode("utf-8", "replace").split("\x1f", 3)
+    if len(parts) != 4 or parts[0] not in LEVELS:
+        return None
+    return parts[0], int(parts[1]), os.path.basename(parts[2]), parts[3]
+
+
+def parse_args(types, amount, data):
+    args = []
+    pos = 0
+    for i in range(amount):
+        kind = (types >> (2 * i)) & 3
+        if kind == ARG_U32:
+            args.append((kind, struct.unpack_from("<I", data, pos)[0]))
+            pos += 4
+        elif kind == ARG_U64:
+            args.append((kind, struct.unpack_from("<Q", data, pos)[0]))
+            pos += 8
+        elif kind == ARG_F64:
+            args.append((kind, struct.unpack_from("<d", data, pos)[0]))
+            pos += 8
+        else:
+            length = data[pos]
+            args.append((kind, data[pos + 1:pos + 1 + length].decode("utf-8", "replace")))
+            pos += (length + 1 + 3) & ~3
+    return args
+
+
+def to_signed(kind, value):
+    bits = 32 if kind == ARG_U32 else 64
+    return value - (1 << bits) if value & (1 << (bits - 1)) else value
+
+
+def format_c(fmt, args):
+    """按 C printf 的规则格式化，缺少的参数显示为 <?>"""
+    args = list(args)
+    out = []
+    last = 0
+    for m in SPEC.finditer(fmt):
+        out.append(fmt[last:m.start()])
+        last = m.end()
+        flags, width, prec, _, conv = m.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+        if width == "*" or prec == ".*":
+            out.append("<?>")
+            continue
+        if not args:
+            out.append("<?>")
+            continue
+        kind, value = args.pop(0)
+        spec = "%" + flags + (width or "") + (prec or "")
+        try:
+            if conv in "di":
+                out.append((spec + "d") % to_signed(kind, value))
+            elif conv == "u":
+                out.append((spec + "d") % value)
+            elif conv in "oxX":
+                out.append((spec + conv) % value)
+            elif conv == "c":
+                out.append((spec + "c") % chr(value & 0xFF))
+            elif conv == "s":
+                out.append((spec + "s") % value)
+            elif conv == "p":
+                out.append("0x%x" % value)
+            else:
+                out.append((spec + conv) % float(value))
+        except (TypeError, ValueError):
+            out.append("<?>")
+    out.append(fmt[last:])
+    return "".join(out)
+
+
+def decode_frames(stream, section):
+    """从字节流中解析帧，遇到无法识别的字节时逐字节重新同步"""
+    pos = 0
+    while pos + 2 <= len(stream):
+        if stream[pos] != SYNC:
+            pos += 1
+            continue
+        length = stream[pos + 1]
+        frame = stream[pos + 2:pos + 2 + length]
+        if length < HEADER or len(frame) < length:
+            if len(frame) < length:
+                break  # 帧还没收完
+            pos += 1
+            continue
+        fid, tick, types, amount = struct.unpack_from("<IIHB", frame, 0)
+        desc = parse_desc(section, fid)
+        if desc is None or amount > 8:
+            pos += 1
+            continue
+        try:
+            args = parse_args(types, amount, frame[HEADER:])
+        except (IndexError, struct.error):
+            pos += 1
+            continue
+        pos += 2 + length
+        yield desc, tick, args
+    return pos
+
+
+def render(desc, tick, args, color):
+    level, line, file, fmt = desc
+    name, code = LEVELS[level]
+    text = "[%s/%s L:%d,T:%d]:%s" % (name, file, line, tick, format_c(fmt, args))
+    return code + text + COLOR_NONE if color else text
+
+
+def main():
+    parser = argparse.ArgumentParser(description="decode ek_log deferred binary records")
+    parser.add_argument("elf", help="firmware ELF containing the ek_log_fmt section")
+    parser.add_argument("capture", help="captured frames, a serial port with --serial, or - for stdin")
+    parser.add_argument("--serial", type=int, metavar="BAUD", help="read a serial port continuously (needs pyserial)")
+    parser.add_argument("--color", action="store_true", help="colour the output like EK_LOG_COLOR_ENABLE")
+    opts = parser.parse_args()
+
+    section = load_section(opts.elf)
+
+    if opts.serial:
+        import serial
+
+        port = serial.Serial(opts.capture, opts.serial, timeout=0.1)
+        pending = b""
+        while True:
+            pending += port.read(4096)
+            frames = decode_frames(pending, section)
+            while True:
+                try:
+                    print(render(*next(frames), opts.color), flush=True)
+                except StopIteration as stop:
+                    pending = pending[stop.value or 0:]
+                    break
+
+    data = sys.stdin.buffer.read() if opts.capture == "-" else open(opts.capture, "rb").read()
+    for record in decode_frames(data, section):
+        print(render(*record, opts.color))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,171 @@
+#include <time.h>
+#include "test.h"
+
+EK_LOG_FILE_TAG("arena_test.c")
+
+#define ARENA_SIZE         (4096U)
+#define ARENA_FRAMES       (20000U)
+#define ARENA_FRAME_ALLOCS (32U)
+
+EK_VEC_IMPLEMENT(int);
+
+EK_ARENA_DEFINE(test_arena, ARENA_SIZE);
+
+static void arena_basic_test(void)
+{
+    ek_arena_t *a = &test_arena;
+    ek_arena_reset(a);
+
+    // 分配对齐且连续增长
+    uint8_t *p1 = ek_arena_alloc(a, 3);
+    uint8_t *p2 = ek_arena_alloc(a, 5);
+    TEST_CHECK(p1 != NULL && p2 != NULL, "alloc");
+    TEST_CHECK(((uintptr_t)p2 & (EK_ARENA_ALIGN - 1U)) == 0 && p2 > p1, "alignment");
+    TEST_CHECK(ek_arena_alloc(a, 0) == NULL, "zero-size alloc");
+    TEST_CHECK(ek_arena_alloc(a, ARENA_SIZE) == NULL, "oversized alloc");
+
+    // 保存点和回退
+    ek_arena_mark_t mark = ek_arena_save(a);
+    size_t used = ek_arena_used(a);
+    void *scratch = ek_arena_alloc(a, 1000);
+    TEST_CHECK(scratch != NULL && ek_arena_used(a) > used, "scratch alloc");
+    ek_arena_rewind(a, mark);
+    TEST_CHECK(ek_arena_used(a) == used, "rewind");
+    TEST_CHECK(ek_arena_alloc(a, 8) == scratch, "space reused after rewind");
+
+    // 重置之后从头分配，高水位保留
+    ek_arena_reset(a);
+    TEST_CHECK(ek_arena_used(a) == 0 && ek_arena_unused(a) == ARENA_SIZE, "reset");
+    TEST_CHECK(ek_arena_peak(a) >= 1000, "peak");
+    TEST_CHECK(ek_arena_alloc(a, 1) == p1, "reset restarts at base");
+
+    // 从堆上创建
+    size_t heap_used = ek_heap_used();
+    ek_arena_t *heap_arena = ek_arena_create(256);
+    TEST_CHECK(heap_arena != NULL && ek_arena_unused(heap_arena) == 256, "create");
+    TEST_CHECK(ek_arena_alloc(heap_arena, 256) != NULL && ek_arena_alloc(heap_arena, 1) == NULL, "create capacity");
+    ek_arena_destroy(heap_arena);
+    TEST_CHECK(ek_heap_used() == heap_used, "destroy");
+
+    ek_arena_reset(a);
+}
+
+static void arena_container_test(void)
+{
+    ek_arena_t *a = &test_arena;
+    ek_arena_reset(a);
+    size_t heap_used = ek_heap_used();
+
+    // 字符串头和内容都来自 arena，扩容时最后一块原地增长
+    ek_str_t *s = ek_str_create_with(ek_arena_allocator(a), "hello");
+    TEST_CHECK(s != NULL, "arena str create");
+    const char *buf = ek_str_get_cstring(s);
+    ek_str_append(s, " world");
+    ek_str_append_fmt(s, " %d", 42);
+    TEST_CHECK(strcmp(ek_str_get_cstring(s), "hello world 42") == 0, "arena str content");
+    TEST_CHECK(ek_str_get_cstring(s) == buf, "arena str should grow in place");
+
+    ek_str_t *slice = ek_str_slice(s, 6, 11);
+    TEST_CHECK(slice != NULL && strcmp(ek_str_get_cstring(slice), "world") == 0, "arena str slice");
+    TEST_CHECK((uint8_t *)slice >= a->base && (uint8_t *)slice < a->base + a->size, "slice from arena");
+
+    // 动态数组
+    ek_vec_t(int) v;
+    ek_vec_init_with(v, ek_arena_allocator(a));
+    for (int i = 0; i < 100; i++) ek_vec_append(v, i);
+    TEST_CHECK(v.amount == 100 && v.items[99] == 99, "arena vec content");
+    TEST_CHECK((uint8_t *)v.items >= a->base && (uint8_t *)v.items < a->base + a->size, "vec from arena");
+
+    // 最后分配的块释放后归还到 arena
+    size_t used = ek_arena_used(a);
+    ek_vec_destroy(v);
+    TEST_CHECK(ek_arena_used(a) < used, "top block returned on free");
+
+    TEST_CHECK(ek_heap_used() == heap_used, "arena containers should not touch the heap");
+    ek_arena_reset(a);
+}
+
+/* 模拟一帧内大量短生命周期分配：TLSF 逐个分配释放 vs arena 分配后整体重置 */
+static void arena_bench(void)
+{
+    void *ptrs[ARENA_FRAME_ALLOCS];
+    volatile uint8_t sink = 0;
+
+    clock_t start = clock();
+    for (uint32_t f = 0; f < ARENA_FRAMES; f++)
+    {
+        for (uint32_t i = 0; i < ARENA_FRAME_ALLOCS; i++)
+        {
+            ptrs[i] = ek_malloc(16 + ((f + i) % 8) * 12);
+            TEST_CHECK(ptrs[i] != NULL, "tlsf bench alloc");
+            *(uint8_t *)ptrs[i] = (uint8_t)i;
+        }
+        for (uint32_t i = 0; i < ARENA_FRAME_ALLOCS; i++)
+        {
+            sink += *(uint8_t *)ptrs[i];
+            ek_free(ptrs[i]);
+        }
+    }
+    double tlsf_s = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    ek_arena_t *a = &test_arena;
+    start = clock();
+    for (uint32_t f = 0; f < ARENA_FRAMES; f++)
+    {
+        for (uint32_t i = 0; i < ARENA_FRAME_ALLOCS; i++)
+        {
+            ptrs[i] = ek_arena_alloc(a, 16 + ((f + i) % 8) * 12);
+            TEST_CHECK(ptrs[i] != NULL, "arena bench alloc");
+            *(uint8_t *)ptrs[i] = (uint8_t)i;
+        }
+        for (uint32_t i = 0; i < ARENA_FRAME_ALLOCS; i++) sink += *(uint8_t *)ptrs[i];
+        ek_arena_reset(a);
+    }
+    double arena_s = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    // 字符串拼接：默认堆 vs arena
+    start = clock();
+    for (uint32_t f = 0; f < ARENA_FRAMES / 4; f++)
+    {
+        ek_str_t *s = ek_str_create("frame");
+        for (uint32_t i = 0; i < 8; i++) ek_str_append(s, " field");
+        sink += (uint8_t)ek_str_get_len(s);
+        ek_str_free(s);
+    }
+    double str_heap_s = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (uint32_t f = 0; f < ARENA_FRAMES / 4; f++)
+    {
+        ek_str_t *s = ek_str_create_with(ek_arena_allocator(a), "frame");
+        for (uint32_t i = 0; i < 8; i++) ek_str_append(s, " field");
+        sink += (uint8_t)ek_str_get_len(s);
+        ek_arena_reset(a);
+    }
+    double str_arena_s = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    EK_LOG_INFO("bench: %u frames x %u allocs: tlsf %.4f s, arena %.4f s (%.1fx)",
+                ARENA_FRAMES,
+                ARENA_FRAME_ALLOCS,
+                tlsf_s,
+                arena_s,
+                arena_s > 0 ? tlsf_s / arena_s : 0.0);
+    EK_LOG_INFO("bench: %u str builds: heap %.4f s, arena %.4f s (%.1fx), arena peak %zu",
+                ARENA_FRAMES / 4,
+                str_heap_s,
+                str_arena_s,
+                str_arena_s > 0 ? str_heap_s / str_arena_s : 0.0,
+                ek_arena_peak(a));
+    __EK_UNUSED(sink);
+}
+
+void arena_test(void)
+{
+    EK_LOG_INFO("arena test start");
+
+    arena_basic_test();
+    arena_container_test();
+    arena_bench();
+
+    EK_LOG_INFO("arena test passed");
+}
@@ -8,3 +8,5 @@ cmake -DCMAKE_C_FLAGS="-m32"\
    
 ninja -C build
 ./build/test
+./build/test_features
+./build/test_default_port
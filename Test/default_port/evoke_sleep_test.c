@@ -0,0 +1,133 @@
+#include "test.h"
+
+EK_LOG_FILE_TAG("evoke_sleep_test.c")
+
+/*
+ * 不链接主机移植，使用 ek_evoke.c 中默认的 ek_evoke_sleep() / ek_evoke_get_tick()，
+ * 这里只提供定时器和睡眠钩子，模拟只实现了这几个函数的移植：
+ * - ek_evoke_set_timer() 记录设置的时间，睡眠钩子中定时器到期时调用 ek_evoke_delay_timer_callback()
+ * - sleep_early 不为 0 时，睡眠被其他中断提前唤醒，定时器没有到期
+ */
+static uint32_t sleep_timer_xtick;
+static uint32_t sleep_timer_sets;
+static bool sleep_timer_armed;
+static uint32_t sleep_light;
+static uint32_t sleep_deep;
+static uint32_t sleep_early;
+static ek_evoke_event_t *sleep_isr_evt; /**< 提前唤醒的中断里延迟发布的事件 */
+static uint32_t sleep_isr_delay;
+
+void ek_evoke_set_timer(uint32_t xtick)
+{
+    sleep_timer_xtick = xtick;
+    sleep_timer_sets++;
+    sleep_timer_armed = true;
+}
+
+static void sleep_wait(void)
+{
+    if (sleep_early != 0)
+    {
+        sleep_early--;
+        if (sleep_isr_evt != NULL) ek_evoke_event_defer_from_isr(sleep_isr_evt, NULL, sleep_isr_delay, false);
+        sleep_isr_evt = NULL;
+        return;
+    }
+
+    if (sleep_timer_armed)
+    {
+        sleep_timer_armed = false;
+        ek_evoke_delay_timer_callback();
+    }
+}
+
+void ek_evoke_light_sleep(void)
+{
+    sleep_light++;
+    sleep_wait();
+}
+
+void ek_evoke_deep_sleep(void)
+{
+    sleep_deep++;
+    sleep_wait();
+}
+
+static void sleep_reset(void)
+{
+    sleep_timer_sets = 0;
+    sleep_light = 0;
+    sleep_deep = 0;
+    sleep_early = 0;
+}
+
+/* 定时器到期时调度器时间恰好前进设定的时间 */
+static void sleep_timer_test(ek_evoke_event_t *evt)
+{
+    uint32_t start = ek_evoke_get_tick();
+    sleep_reset();
+
+    ek_evoke_event_defer(evt, NULL, 100, false);
+    ek_evoke_run_until(start + 100U);
+    TEST_CHECK(evt->count == 1, "deferred event did not fire");
+    TEST_CHECK(ek_evoke_get_tick() - start == 100U, "tick did not advance by the timer time");
+    TEST_CHECK(sleep_timer_sets == 1 && sleep_timer_xtick == 100U, "timer set once for the full delay");
+    TEST_CHECK(sleep_deep == 1 && sleep_light == 0, "sleep without lock should be deep");
+
+    // 有睡眠锁时只能浅睡眠
+    sleep_reset();
+    ek_evoke_sleep_lock();
+    ek_evoke_event_defer(evt, NULL, 10, false);
+    ek_evoke_run_until(start + 110U);
+    ek_evoke_sleep_unlock();
+    TEST_CHECK(evt->count == 2, "deferred event under sleep lock");
+    TEST_CHECK(sleep_light == 1 && sleep_deep == 0, "sleep lock should force light sleep");
+}
+
+/* 提前唤醒报告经过 0 个 tick，剩余时间不变时不重新设置定时器 */
+static void sleep_early_test(ek_evoke_event_t *evt)
+{
+    uint32_t start = ek_evoke_get_tick();
+    sleep_reset();
+    sleep_early = 2;
+
+    ek_evoke_event_defer(evt, NULL, 50, false);
+    ek_evoke_run_until(start + 50U);
+    TEST_CHECK(evt->count == 3, "deferred event after early wakeups");
+    TEST_CHECK(sleep_deep == 3, "two early wakeups then the timer");
+    TEST_CHECK(sleep_timer_sets == 1, "timer re-armed although the deadline did not change");
+    TEST_CHECK(ek_evoke_get_tick() - start == 50U, "early wakeups moved the tick");
+}
+
+/* 提前唤醒的中断带来更早的请求时，定时器按新的剩余时间重新设置 */
+static void sleep_rearm_test(ek_evoke_event_t *evt, ek_evoke_event_t *isr_evt)
+{
+    uint32_t start = ek_evoke_get_tick();
+    sleep_reset();
+    sleep_early = 1;
+    sleep_isr_evt = isr_evt;
+    sleep_isr_delay = 20;
+
+    ek_evoke_event_defer(evt, NULL, 50, false);
+    ek_evoke_run_until(start + 50U);
+    TEST_CHECK(isr_evt->count == 1 && evt->count == 4, "both deferred events fired");
+    TEST_CHECK(sleep_timer_sets == 3 && sleep_timer_xtick == 30U, "timer re-armed for 50, 20 then 30 ticks");
+    TEST_CHECK(ek_evoke_get_tick() - start == 50U, "tick after re-armed timers");
+}
+
+void evoke_sleep_test(void)
+{
+    EK_LOG_INFO("evoke default sleep test start");
+
+    ek_evoke_init();
+    ek_evoke_event_t *evt = ek_evoke_event_create("sleep", 0);
+    ek_evoke_event_t *isr_evt = ek_evoke_event_create("isr", 0);
+
+    sleep_timer_test(evt);
+    sleep_early_test(evt);
+    sleep_rearm_test(evt, isr_evt);
+
+    ek_evoke_event_destroy(isr_evt);
+    ek_evoke_event_destroy(evt);
+    EK_LOG_INFO("evoke default sleep test passed");
+}
@@ -0,0 +1,29 @@
+#include <stdio.h>
+#include "test.h"
+
+EK_LOG_FILE_TAG("default_port/main.c");
+
+EK_IO_FPUTC()
+{
+    fputc(ch, stdout);
+}
+
+EK_LOG_GET_TICK()
+{
+    static uint32_t tick = 0;
+
+    tick++;
+
+    return tick;
+}
+
+/* 不链接主机移植，覆盖 evoke 默认的睡眠和时钟弱函数 */
+int main(void)
+{
+    ek_io_init();
+    ek_heap_init();
+
+    evoke_sleep_test();
+
+    return 0;
+}
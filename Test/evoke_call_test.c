@@ -0,0 +1,112 @@
+/* 失败时附带回调的执行顺序 */
+#define TEST_CHECK_CONTEXT() fprintf(stderr, "trace \"%s\"\n", call_trace)
+
+#include "test.h"
+
+EK_LOG_FILE_TAG("evoke_call_test.c")
+
+static char call_trace[16];
+static uint32_t call_len;
+static uint32_t call_count;
+static ek_evoke_event_t *call_done;
+
+static void call_mark(char label)
+{
+    if (call_len < sizeof(call_trace) - 1U) call_trace[call_len++] = label;
+}
+
+/* 中断中提交的工作：记录参数中的标记 */
+static void call_work(void *arg)
+{
+    call_mark((char)(uintptr_t)arg);
+    call_count++;
+}
+
+static void call_task(ek_evoke_event_t *evt, void *arg)
+{
+    __EK_UNUSED(evt);
+
+    char label = (char)(uintptr_t)arg;
+    call_mark(label);
+    // A 的回调中“发生中断”，中断提交的工作排在已就绪的 B 之前执行
+    if (label == 'A') ek_evoke_call_from_isr(call_work, (void *)(uintptr_t)'c');
+}
+
+/* 所有就绪任务和 ISR 请求处理完、主循环准备睡眠时返回 */
+static void call_run(void)
+{
+    ek_evoke_event_publish(call_done, NULL);
+    evoke_sim_run_until(call_done, call_done->count);
+}
+
+static void call_reset(void)
+{
+    memset(call_trace, 0, sizeof(call_trace));
+    call_len = 0;
+    call_count = 0;
+}
+
+static void call_order_test(void)
+{
+    ek_evoke_event_t *evts[3];
+    ek_evoke_task_t *tsks[3];
+    const char labels[] = { 'A', 'B', 'P' };
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        evts[i] = ek_evoke_event_create("call", 0);
+        tsks[i] = ek_evoke_task_create("call", call_task, (void *)(uintptr_t)labels[i]);
+        ek_evoke_event_subscribe(tsks[i], evts[i]);
+    }
+
+    call_reset();
+    ek_evoke_event_publish(evts[0], NULL);
+    ek_evoke_event_publish(evts[1], NULL);
+    call_run();
+    TEST_CHECK(strcmp(call_trace, "AcB") == 0, "work posted from isr runs before the next task");
+
+    // 工作与事件请求共用队列，按提交顺序处理
+    call_reset();
+    ek_evoke_call_from_isr(call_work, (void *)(uintptr_t)'1');
+    ek_evoke_event_publish_from_isr(evts[2], NULL);
+    ek_evoke_call_from_isr(call_work, (void *)(uintptr_t)'2');
+    call_run();
+    TEST_CHECK(strcmp(call_trace, "12P") == 0, "work and events keep the posting order");
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        ek_evoke_task_destroy(tsks[i]);
+        ek_evoke_event_destroy(evts[i]);
+    }
+}
+
+static void call_overflow_test(void)
+{
+    ek_evoke_queue_stats_t stats;
+    ek_evoke_isr_stats(&stats);
+    uint32_t lost = stats.dropped + stats.coalesced + stats.overwritten;
+
+    // 队列满后的请求按溢出策略处理，参数各不相同，不会被合并
+    call_reset();
+    for (uint32_t i = 0; i < stats.capacity + 2U; i++) ek_evoke_call_from_isr(call_work, (void *)(uintptr_t)('a' + i));
+    call_run();
+
+    ek_evoke_isr_stats(&stats);
+    TEST_CHECK(call_count == stats.capacity, "full queue executes capacity calls");
+    TEST_CHECK(stats.dropped + stats.coalesced + stats.overwritten - lost == 2U, "overflowed calls counted");
+    TEST_CHECK(stats.used == 0, "queue drained");
+}
+
+void evoke_call_test(void)
+{
+    EK_LOG_INFO("evoke call test start");
+
+    evoke_sim_reset();
+    call_done = ek_evoke_event_create("done", 0);
+
+    call_order_test();
+    call_overflow_test();
+
+    ek_evoke_event_destroy(call_done);
+
+    EK_LOG_INFO("evoke call test passed");
+}
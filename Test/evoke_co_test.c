@@ -0,0 +1,182 @@
+#include "test.h"
+
+EK_LOG_FILE_TAG("evoke_co_test.c")
+
+#define CO_ACK_TIMEOUT (10U)
+#define CO_ACK_DELAY   (3U)
+#define CO_SETTLE      (5U)
+
+/* 跨挂起点的状态放在静态变量中 */
+static struct
+{
+    uint32_t start;
+    uint32_t attempt;
+    uint32_t tx_count;
+    bool acked;
+    uint32_t ack_tick;
+    uint32_t settle_tick;
+    bool got_go;
+} co_state;
+
+static ek_evoke_event_t *co_tx;
+static ek_evoke_event_t *co_ack;
+static ek_evoke_event_t *co_go;
+static ek_evoke_event_t *co_done;
+
+/* 对端：忽略第一帧，第二帧在 CO_ACK_DELAY 之后应答 */
+static void co_peer_task(ek_evoke_event_t *evt, void *arg)
+{
+    __EK_UNUSED(evt);
+    __EK_UNUSED(arg);
+
+    if (++co_state.tx_count == 2) ek_evoke_event_defer(co_ack, NULL, CO_ACK_DELAY, false);
+}
+
+/* 发送、等待应答（带超时重试）、延时、再等待另一个事件 */
+static void co_sender_task(ek_evoke_event_t *evt, void *arg)
+{
+    __EK_UNUSED(evt);
+    __EK_UNUSED(arg);
+
+    EK_CO_BEGIN();
+
+    for (co_state.attempt = 1; co_state.attempt <= 3; co_state.attempt++)
+    {
+        ek_evoke_event_publish(co_tx, NULL);
+        EK_CO_AWAIT_ANY(co_ack, CO_ACK_TIMEOUT);
+        if (!EK_CO_TIMED_OUT()) break;
+    }
+    co_state.acked = !EK_CO_TIMED_OUT();
+    co_state.ack_tick = ek_evoke_get_tick();
+
+    EK_CO_AWAIT_DELAY(CO_SETTLE);
+    co_state.settle_tick = ek_evoke_get_tick();
+
+    // 事件已有计数时立即恢复
+    EK_CO_AWAIT_EVENT(co_go);
+    co_state.got_go = true;
+
+    ek_evoke_event_publish(co_done, NULL);
+    EK_CO_END();
+}
+
+static uint32_t co_oneshot_runs;
+static bool co_oneshot_freed;
+
+/* 收到一帧后销毁自己 */
+static void co_oneshot_task(ek_evoke_event_t *evt, void *arg)
+{
+    __EK_UNUSED(evt);
+    __EK_UNUSED(arg);
+
+    EK_CO_BEGIN();
+    EK_CO_AWAIT_EVENT(co_tx);
+    co_oneshot_runs++;
+    size_t used = ek_heap_used();
+    ek_evoke_task_destroy(_ek_co_self);
+    co_oneshot_freed = (ek_heap_used() != used);
+    return;
+    EK_CO_END();
+}
+
+static void co_protocol_test(void)
+{
+    evoke_sim_reset();
+    memset(&co_state, 0, sizeof(co_state));
+    co_state.start = ek_evoke_get_tick();
+
+    co_tx = ek_evoke_event_create("tx", 0);
+    co_ack = ek_evoke_event_create("ack", 0);
+    co_go = ek_evoke_event_create("go", 1);
+    co_done = ek_evoke_event_create("done", 0);
+
+    ek_evoke_task_t *peer = ek_evoke_task_create("peer", co_peer_task, NULL);
+    ek_evoke_event_subscribe(peer, co_tx);
+    ek_evoke_task_t *sender = ek_evoke_task_create("sender", co_sender_task, NULL);
+    ek_evoke_task_set_priority(sender, 1);
+    ek_evoke_task_await(sender, NULL, 0);
+
+    evoke_sim_run_until(co_done, 1);
+
+    TEST_CHECK(co_state.tx_count == 2 && co_state.attempt == 2, "first frame should time out and be retried");
+    TEST_CHECK(co_state.acked && co_state.ack_tick - co_state.start == CO_ACK_TIMEOUT + CO_ACK_DELAY, "ack received after retry");
+    TEST_CHECK(co_state.settle_tick == co_state.ack_tick + CO_SETTLE, "await delay");
+    TEST_CHECK(co_state.got_go && co_go->count == 0, "await event with pending count");
+    TEST_CHECK(sender->state == EK_EVOKE_STATE_IDLE && sender->co_line == 0, "coroutine finished");
+
+    // 应答先到达时，第二次等待的超时请求已经取消
+    ek_evoke_queue_stats_t stats;
+    ek_evoke_defer_stats(&stats);
+    TEST_CHECK(stats.used == 0, "timeout cancelled when the event arrives first");
+
+    ek_evoke_task_destroy(sender);
+    ek_evoke_task_destroy(peer);
+    ek_evoke_event_destroy(co_tx);
+    ek_evoke_event_destroy(co_ack);
+    ek_evoke_event_destroy(co_go);
+    ek_evoke_event_destroy(co_done);
+}
+
+static void co_cleanup_test(void)
+{
+    evoke_sim_reset();
+    ek_evoke_queue_stats_t stats;
+
+    // 销毁正在带超时等待的任务，或者销毁它等待的事件，超时请求都要归还
+    ek_evoke_event_t *evt = ek_evoke_event_create("wait", 0);
+    ek_evoke_task_t *a = ek_evoke_task_create("a", co_peer_task, NULL);
+    ek_evoke_task_t *b = ek_evoke_task_create("b", co_peer_task, NULL);
+    ek_evoke_task_await(a, evt, 100);
+    ek_evoke_task_await(b, evt, 200);
+    ek_evoke_defer_stats(&stats);
+    TEST_CHECK(stats.used == 2, "two timeouts pending");
+
+    ek_evoke_task_destroy(a);
+    ek_evoke_defer_stats(&stats);
+    TEST_CHECK(stats.used == 1 && ek_list_is_empty(&evt->wait_list) == false, "destroy task releases its timeout");
+
+    ek_evoke_event_destroy(evt);
+    ek_evoke_defer_stats(&stats);
+    TEST_CHECK(stats.used == 0 && b->state == EK_EVOKE_STATE_IDLE && b->timer == NULL,
+               "destroy event releases waiters' timeouts");
+
+    ek_evoke_task_destroy(b);
+}
+
+static void co_self_destroy_test(void)
+{
+    evoke_sim_reset();
+    co_oneshot_runs = 0;
+    co_oneshot_freed = false;
+    co_tx = ek_evoke_event_create("tx", 0);
+    size_t heap_used = ek_heap_used();
+
+    ek_evoke_task_t *tsk = ek_evoke_task_create("oneshot", co_oneshot_task, NULL);
+    ek_evoke_task_await(tsk, NULL, 0);
+    ek_evoke_run_until(ek_evoke_get_tick());
+    TEST_CHECK(tsk->state == EK_EVOKE_STATE_WAITTING, "coroutine waits for the frame");
+
+    // 回调返回后才释放任务，也不会按原来的等待对象重新挂到事件上
+    ek_evoke_event_publish(co_tx, NULL);
+    ek_evoke_run_until(ek_evoke_get_tick());
+    TEST_CHECK(!co_oneshot_freed, "task freed while its callback was running");
+    TEST_CHECK(co_oneshot_runs == 1 && ek_list_is_empty(&co_tx->wait_list), "destroyed task re-armed");
+    TEST_CHECK(ek_heap_used() == heap_used, "self-destroyed task leaked");
+
+    ek_evoke_event_publish(co_tx, NULL);
+    ek_evoke_run_until(ek_evoke_get_tick());
+    TEST_CHECK(co_oneshot_runs == 1, "destroyed task ran again");
+
+    ek_evoke_event_destroy(co_tx);
+}
+
+void evoke_co_test(void)
+{
+    EK_LOG_INFO("evoke coroutine test start");
+
+    co_protocol_test();
+    co_cleanup_test();
+    co_self_destroy_test();
+
+    EK_LOG_INFO("evoke coroutine test passed");
+}
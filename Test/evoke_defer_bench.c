@@ -0,0 +1,125 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <time.h>
+#include "test.h"
+
+EK_LOG_FILE_TAG("evoke_defer_bench.c")
+
+#define DEFER_TIMERS    (10000U)
+#define DEFER_MAX_DELAY (100000U)
+
+static uint32_t defer_last_deadline;
+static bool defer_order_ok;
+static uint64_t defer_fire_ns;
+static uint64_t defer_fire_max_ns;
+static struct timespec defer_wake_ts;
+static bool defer_timing;
+
+static uint64_t defer_ns(const struct timespec *t0, const struct timespec *t1)
+{
+    return (uint64_t)(t1->tv_sec - t0->tv_sec) * 1000000000ULL + (uint64_t)(t1->tv_nsec - t0->tv_nsec);
+}
+
+/* 从上一次唤醒到下一次进入睡眠：取出到期请求、发布事件、计算下一次定时 */
+static void defer_sleep_hook(uint32_t xtick)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    if (defer_timing)
+    {
+        uint64_t ns = defer_ns(&defer_wake_ts, &ts);
+        defer_fire_ns += ns;
+        if (ns > defer_fire_max_ns) defer_fire_max_ns = ns;
+    }
+
+    if (xtick != EK_EVOKE_TICK_FOREVER)
+    {
+        uint32_t deadline = ek_evoke_get_tick() + xtick;
+        if ((int32_t)(deadline - defer_last_deadline) < 0) defer_order_ok = false;
+        defer_last_deadline = deadline;
+    }
+
+    defer_wake_ts = ts;
+    defer_timing = true;
+}
+
+static void defer_cancel_test(void)
+{
+    // 事件销毁时未到期的请求要一起取消，否则复用同一块内存的新事件会收到旧请求
+    ek_evoke_event_t *old_evt = ek_evoke_event_create("old", 0);
+    for (uint32_t i = 1; i <= 3; i++) ek_evoke_event_defer(old_evt, NULL, i * 10U, false);
+    ek_evoke_event_destroy(old_evt);
+
+    ek_evoke_event_t *evt = ek_evoke_event_create("new", 0);
+    ek_evoke_event_defer(evt, NULL, 50, true);
+    evoke_sim_run_until(evt, 1);
+    TEST_CHECK(evt->count == 1, "cancelled requests fired after event destroy");
+
+    // 再跑一轮确认没有残留的请求
+    ek_evoke_event_defer(evt, NULL, 100, false);
+    evoke_sim_run_until(evt, 2);
+    TEST_CHECK(evt->count == 2, "defer after cancel");
+    ek_evoke_event_destroy(evt);
+}
+
+void evoke_defer_bench(void)
+{
+    EK_LOG_INFO("evoke defer bench start");
+
+    evoke_sim_reset();
+    defer_cancel_test();
+
+    // 默认配置的请求池装不下基准测试的定时器数量，只跑取消测试
+    if (EK_EVOKE_MAX_DEFER_REQ < DEFER_TIMERS)
+    {
+        EK_LOG_INFO("evoke defer bench skipped, EK_EVOKE_MAX_DEFER_REQ = %u", (unsigned)EK_EVOKE_MAX_DEFER_REQ);
+        return;
+    }
+
+    evoke_sim_reset();
+    uint32_t start = ek_evoke_get_tick();
+
+    ek_evoke_event_t *evt = ek_evoke_event_create("bench", 0);
+    uint32_t seed = 12345U;
+    uint64_t insert_ns = 0, insert_max_ns = 0;
+    uint32_t max_delay = 0;
+
+    for (uint32_t i = 0; i < DEFER_TIMERS; i++)
+    {
+        seed = seed * 1103515245U + 12345U;
+        uint32_t delay = 1U + (seed >> 8) % DEFER_MAX_DELAY;
+        if (delay > max_delay) max_delay = delay;
+
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        ek_evoke_event_defer(evt, NULL, delay, false);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+
+        uint64_t ns = defer_ns(&t0, &t1);
+        insert_ns += ns;
+        if (ns > insert_max_ns) insert_max_ns = ns;
+    }
+
+    defer_fire_ns = 0;
+    defer_fire_max_ns = 0;
+    defer_last_deadline = start;
+    defer_order_ok = true;
+    defer_timing = false;
+    evoke_sim_sleep_hook = defer_sleep_hook;
+    evoke_sim_run_until(evt, DEFER_TIMERS);
+    evoke_sim_sleep_hook = NULL;
+
+    TEST_CHECK(evt->count == DEFER_TIMERS, "all deferred requests fired");
+    TEST_CHECK(defer_order_ok, "timer deadlines went backwards");
+    TEST_CHECK(ek_evoke_get_tick() - start == max_delay, "last timer fired at the largest delay");
+    ek_evoke_event_destroy(evt);
+
+    EK_LOG_INFO("%s store, %u timers: insert avg %.1f ns max %.1f us, fire avg %.1f ns max %.1f us",
+                EK_EVOKE_DEFER_USE_HEAP ? "heap" : "list",
+                DEFER_TIMERS,
+                (double)insert_ns / DEFER_TIMERS,
+                (double)insert_max_ns / 1000.0,
+                (double)defer_fire_ns / DEFER_TIMERS,
+                (double)defer_fire_max_ns / 1000.0);
+    EK_LOG_INFO("evoke defer bench passed");
+}
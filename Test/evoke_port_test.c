@@ -0,0 +1,224 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <time.h>
+#include "test.h"
+#include "linux_evoke_port.h"
+
+EK_LOG_FILE_TAG("evoke_port_test.c")
+
+#define PORT_PINGPONG  (200000U)
+#define PORT_PERIOD    (7U)
+#define PORT_PERIODS   (1000U)
+#define PORT_STORM_MAX (5U)
+#define PORT_BUSY      (10U)
+#define PORT_IRQ_AT    (4U)
+
+static ek_evoke_event_t *port_evt;
+static uint32_t port_fired;
+static uint32_t port_ticks[4];
+static uint32_t port_late;
+static uint32_t port_expect;
+static uint32_t port_busy;
+static uint32_t port_irq_tick;
+static uint32_t port_work_tick;
+static uint32_t port_seed;
+static uint32_t port_storm;
+
+static void port_record_cb(ek_evoke_event_t *evt, void *arg)
+{
+    __EK_UNUSED(evt);
+    __EK_UNUSED(arg);
+
+    if (port_fired < sizeof(port_ticks) / sizeof(port_ticks[0])) port_ticks[port_fired] = ek_evoke_get_tick();
+    port_fired++;
+    linux_evoke_advance(port_busy);
+}
+
+static void port_publish_isr(void *arg)
+{
+    ek_evoke_event_publish_from_isr((ek_evoke_event_t *)arg, NULL);
+}
+
+static void port_work(void *arg)
+{
+    __EK_UNUSED(arg);
+    port_work_tick = ek_evoke_get_tick();
+}
+
+static void port_call_isr(void *arg)
+{
+    __EK_UNUSED(arg);
+    port_irq_tick = ek_evoke_get_tick();
+    ek_evoke_call_from_isr(port_work, NULL);
+}
+
+static void port_run_test(void)
+{
+    uint32_t start = ek_evoke_get_tick();
+    port_fired = 0;
+
+    // 睡眠被截断在目标时间，不会越过 run_until 的参数
+    ek_evoke_event_defer(port_evt, NULL, 100, false);
+    ek_evoke_event_defer(port_evt, NULL, 250, false);
+    ek_evoke_run_until(start + 200U);
+    TEST_CHECK(port_fired == 1 && port_ticks[0] - start == 100U, "request before the target fired");
+    TEST_CHECK(ek_evoke_get_tick() - start == 200U, "run_until stops at the target");
+
+    // 单步：先睡到下一个请求并发布，再执行被唤醒的任务
+    TEST_CHECK(!ek_evoke_run_once(), "idle step sleeps");
+    TEST_CHECK(ek_evoke_get_tick() - start == 250U && port_fired == 1, "step woke at the next request");
+    TEST_CHECK(ek_evoke_run_once() && port_fired == 2, "step runs the ready task");
+}
+
+static void port_irq_test(void)
+{
+    uint32_t start = ek_evoke_get_tick();
+    port_fired = 0;
+
+    // 睡眠中的中断提前唤醒主循环，任务在中断发生的同一个 tick 执行
+    TEST_CHECK(linux_evoke_irq_inject(30, port_publish_isr, port_evt), "inject irq");
+    ek_evoke_run_until(start + 50U);
+    TEST_CHECK(port_fired == 1 && port_ticks[0] - start == 30U, "irq wakes the loop");
+    TEST_CHECK(linux_evoke_irq_pending() == 0, "irq consumed");
+
+    // 任务回调执行期间到来的中断提交的工作，在回调结束后立即执行
+    start = ek_evoke_get_tick();
+    port_busy = PORT_BUSY;
+    ek_evoke_event_publish(port_evt, NULL);
+    linux_evoke_irq_inject(PORT_IRQ_AT, port_call_isr, NULL);
+    ek_evoke_run_until(start);
+    port_busy = 0;
+    TEST_CHECK(port_irq_tick - start == PORT_IRQ_AT, "irq preempts the callback");
+    TEST_CHECK(port_work_tick - start == PORT_BUSY, "work runs right after the callback");
+
+    // 回调占用的时间在下一次睡眠时才计入调度器时间，跑到当前时间让两者重新对齐
+    ek_evoke_run_until(ek_evoke_get_tick());
+}
+
+/* 不断自我重新注入的中断，模拟频繁的外设中断 */
+static void port_storm_isr(void *arg)
+{
+    __EK_UNUSED(arg);
+    port_storm++;
+    port_seed = port_seed * 1103515245U + 12345U;
+    linux_evoke_irq_inject(1U + (port_seed >> 8) % PORT_STORM_MAX, port_storm_isr, NULL);
+}
+
+static void port_period_cb(ek_evoke_event_t *evt, void *arg)
+{
+    __EK_UNUSED(evt);
+    __EK_UNUSED(arg);
+
+    if (ek_evoke_get_tick() != port_expect) port_late++;
+    port_expect += PORT_PERIOD;
+    port_fired++;
+}
+
+static void port_accuracy_test(void)
+{
+    ek_evoke_event_t *evt = ek_evoke_event_create("period", 0);
+    ek_evoke_task_t *tsk = ek_evoke_task_create("period", port_period_cb, NULL);
+    ek_evoke_event_subscribe(tsk, evt);
+
+    uint32_t start = ek_evoke_get_tick();
+    port_fired = 0;
+    port_late = 0;
+    port_storm = 0;
+    port_seed = 99U;
+    port_expect = start + PORT_PERIOD;
+    ek_evoke_defer_t h = ek_evoke_event_defer_periodic(evt, NULL, PORT_PERIOD, false);
+    linux_evoke_irq_inject(1, port_storm_isr, NULL);
+    ek_evoke_run_until(start + PORT_PERIOD * PORT_PERIODS);
+    linux_evoke_irq_clear();
+
+    TEST_CHECK(port_fired == PORT_PERIODS && port_late == 0, "periodic timer on time under an irq storm");
+    TEST_CHECK(port_storm > PORT_PERIODS, "irq storm injected");
+
+    ek_evoke_defer_cancel(h);
+    ek_evoke_task_destroy(tsk);
+    ek_evoke_event_destroy(evt);
+    EK_LOG_INFO("%u periods on time, %u injected irqs", PORT_PERIODS, port_storm);
+}
+
+/* 一个中断里连续提交超过队列容量的请求 */
+static void port_burst_isr(void *arg)
+{
+    ek_evoke_queue_stats_t stats;
+    ek_evoke_isr_stats(&stats);
+    for (uint32_t i = 0; i < 2U * stats.capacity; i++) ek_evoke_event_publish_from_isr((ek_evoke_event_t *)arg, NULL);
+}
+
+static void port_fifo_test(void)
+{
+    ek_evoke_event_t *evt = ek_evoke_event_create("burst", 0);
+    ek_evoke_queue_stats_t stats;
+    ek_evoke_isr_stats(&stats);
+    uint32_t lost = stats.dropped + stats.coalesced + stats.overwritten;
+
+    linux_evoke_irq_inject(5, port_burst_isr, evt);
+    ek_evoke_run_until(ek_evoke_get_tick() + 10U);
+
+    ek_evoke_isr_stats(&stats);
+    TEST_CHECK(evt->count == stats.capacity, "a full fifo delivers its capacity");
+    TEST_CHECK(stats.dropped + stats.coalesced + stats.overwritten - lost == stats.capacity, "overflow counted");
+    TEST_CHECK(stats.peak == stats.capacity && stats.used == 0, "fifo peak and drain");
+    ek_evoke_event_destroy(evt);
+}
+
+static ek_evoke_event_t *port_ping;
+static ek_evoke_event_t *port_pong;
+static uint32_t port_rounds;
+
+static void port_ping_cb(ek_evoke_event_t *evt, void *arg)
+{
+    __EK_UNUSED(arg);
+    if (evt == port_ping) ek_evoke_event_publish(port_pong, NULL);
+    else if (++port_rounds < PORT_PINGPONG / 2U) ek_evoke_event_publish(port_ping, NULL);
+}
+
+static void port_throughput_bench(void)
+{
+    port_ping = ek_evoke_event_create("ping", 0);
+    port_pong = ek_evoke_event_create("pong", 0);
+    ek_evoke_task_t *a = ek_evoke_task_create("ping", port_ping_cb, NULL);
+    ek_evoke_task_t *b = ek_evoke_task_create("pong", port_ping_cb, NULL);
+    ek_evoke_event_subscribe(a, port_ping);
+    ek_evoke_event_subscribe(b, port_pong);
+
+    struct timespec t0, t1;
+    port_rounds = 0;
+    ek_evoke_event_publish(port_ping, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    ek_evoke_run_until(ek_evoke_get_tick());
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    TEST_CHECK(port_rounds == PORT_PINGPONG / 2U, "all dispatches done");
+
+    uint64_t ns = (uint64_t)(t1.tv_sec - t0.tv_sec) * 1000000000ULL + (uint64_t)(t1.tv_nsec - t0.tv_nsec);
+    EK_LOG_INFO("%u dispatches: %.1f ns per dispatch", PORT_PINGPONG, (double)ns / PORT_PINGPONG);
+
+    ek_evoke_task_destroy(a);
+    ek_evoke_task_destroy(b);
+    ek_evoke_event_destroy(port_ping);
+    ek_evoke_event_destroy(port_pong);
+}
+
+void evoke_port_test(void)
+{
+    EK_LOG_INFO("evoke port test start");
+
+    linux_evoke_reset();
+    port_evt = ek_evoke_event_create("port", 0);
+    ek_evoke_task_t *tsk = ek_evoke_task_create("port", port_record_cb, NULL);
+    ek_evoke_event_subscribe(tsk, port_evt);
+
+    port_run_test();
+    port_irq_test();
+    port_accuracy_test();
+    port_fifo_test();
+    port_throughput_bench();
+
+    ek_evoke_task_destroy(tsk);
+    ek_evoke_event_destroy(port_evt);
+
+    EK_LOG_INFO("evoke port test passed");
+}
@@ -0,0 +1,159 @@
+/* 失败时附带回调的执行顺序 */
+#define TEST_CHECK_CONTEXT() fprintf(stderr, "trace \"%s\"\n", prio_trace)
+
+#include "test.h"
+
+EK_LOG_FILE_TAG("evoke_prio_test.c")
+
+typedef struct
+{
+    char label;
+    ek_evoke_event_t *publish; /**< 回调中发布的事件 */
+    bool from_isr; /**< 用 ISR 接口发布 */
+    uint32_t busy; /**< 回调中消耗的模拟时间 */
+} prio_job_t;
+
+static char prio_trace[16];
+static uint32_t prio_len;
+static uint32_t prio_miss_calls;
+static uint32_t prio_miss_late;
+
+void ek_evoke_deadline_miss(ek_evoke_task_handle_t tsk, uint32_t late)
+{
+    __EK_UNUSED(tsk);
+    prio_miss_calls++;
+    prio_miss_late = late;
+}
+
+static void prio_cb(ek_evoke_event_t *evt, void *arg)
+{
+    __EK_UNUSED(evt);
+    prio_job_t *job = (prio_job_t *)arg;
+
+    if (prio_len < sizeof(prio_trace) - 1U) prio_trace[prio_len++] = job->label;
+    evoke_sim_advance(job->busy);
+    if (job->publish == NULL) return;
+    if (job->from_isr) ek_evoke_event_publish_from_isr(job->publish, NULL);
+    else ek_evoke_event_publish(job->publish, NULL);
+}
+
+/* 为每个任务建一个私有事件，任务订阅后进入等待 */
+static ek_evoke_task_t *prio_task(prio_job_t *job, uint8_t prio, ek_evoke_event_t **evt)
+{
+    *evt = ek_evoke_event_create("prio", 0);
+    ek_evoke_task_t *tsk = ek_evoke_task_create("prio", prio_cb, job);
+    ek_evoke_task_set_priority(tsk, prio);
+    ek_evoke_event_subscribe(tsk, *evt);
+    return tsk;
+}
+
+/* 所有就绪任务执行完、主循环准备睡眠时返回 */
+static void prio_run(ek_evoke_event_t *done)
+{
+    memset(prio_trace, 0, sizeof(prio_trace));
+    prio_len = 0;
+    ek_evoke_event_publish(done, NULL);
+    evoke_sim_run_until(done, done->count);
+}
+
+static void prio_cleanup(ek_evoke_task_t **tsks, ek_evoke_event_t **evts, uint32_t amount)
+{
+    for (uint32_t i = 0; i < amount; i++)
+    {
+        ek_evoke_task_destroy(tsks[i]);
+        ek_evoke_event_destroy(evts[i]);
+    }
+}
+
+static void prio_order_test(ek_evoke_event_t *done)
+{
+    prio_job_t jobs[] = { { 'L', NULL, false, 0 }, { 'M', NULL, false, 0 }, { 'H', NULL, false, 0 } };
+    const uint8_t prios[] = { 0, 3, EK_EVOKE_PRIO_LEVELS - 1U };
+    ek_evoke_task_t *tsks[3];
+    ek_evoke_event_t *evts[3];
+    for (uint32_t i = 0; i < 3; i++) tsks[i] = prio_task(&jobs[i], prios[i], &evts[i]);
+
+    // 按低到高的顺序就绪，执行顺序只取决于优先级
+    for (uint32_t i = 0; i < 3; i++) ek_evoke_event_publish(evts[i], NULL);
+    prio_run(done);
+    TEST_CHECK(strcmp(prio_trace, "HML") == 0, "ready tasks should run by priority");
+
+    // 就绪后再调高优先级也立即生效
+    ek_evoke_event_publish(evts[0], NULL);
+    ek_evoke_event_publish(evts[1], NULL);
+    ek_evoke_task_set_priority(tsks[0], 5);
+    prio_run(done);
+    TEST_CHECK(strcmp(prio_trace, "LM") == 0, "priority change of a ready task");
+    ek_evoke_task_set_priority(tsks[0], 0);
+
+    prio_cleanup(tsks, evts, 3);
+}
+
+static void prio_preempt_test(ek_evoke_event_t *done, bool from_isr)
+{
+    // A 的回调让 H 就绪，H 必须排在更早就绪的 B 之前
+    prio_job_t jobs[] = { { 'A', NULL, from_isr, 0 }, { 'B', NULL, false, 0 }, { 'H', NULL, false, 0 } };
+    const uint8_t prios[] = { 0, 0, 6 };
+    ek_evoke_task_t *tsks[3];
+    ek_evoke_event_t *evts[3];
+    for (uint32_t i = 0; i < 3; i++) tsks[i] = prio_task(&jobs[i], prios[i], &evts[i]);
+    jobs[0].publish = evts[2];
+
+    ek_evoke_event_publish(evts[0], NULL);
+    ek_evoke_event_publish(evts[1], NULL);
+    prio_run(done);
+    TEST_CHECK(strcmp(prio_trace, "AHB") == 0,
+               from_isr ? "task readied from isr should run next" : "task readied by callback should run next");
+
+    prio_cleanup(tsks, evts, 3);
+}
+
+static void prio_deadline_test(ek_evoke_event_t *done)
+{
+#if EK_EVOKE_DEADLINE_ENABLE == 1
+    // 同一优先级：有截止时间的按截止时间排在前面，没有的保持就绪顺序；更高优先级的 X 仍然最先执行
+    prio_job_t jobs[] = {
+        { 'N', NULL, false, 0 }, { 'n', NULL, false, 0 }, { '5', NULL, false, 0 },
+        { '2', NULL, false, 0 }, { 'X', NULL, false, 3 },
+    };
+    const uint8_t prios[] = { 2, 2, 2, 2, 3 };
+    const uint32_t deadlines[] = { 0, 0, 5, 2, 0 };
+    ek_evoke_task_t *tsks[5];
+    ek_evoke_event_t *evts[5];
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        tsks[i] = prio_task(&jobs[i], prios[i], &evts[i]);
+        ek_evoke_task_set_deadline(tsks[i], deadlines[i]);
+    }
+
+    prio_miss_calls = 0;
+    for (uint32_t i = 0; i < 5; i++) ek_evoke_event_publish(evts[i], NULL);
+    prio_run(done);
+    TEST_CHECK(strcmp(prio_trace, "X25Nn") == 0, "deadline order within a priority");
+
+    // X 占用了 3 个 tick：截止时间为 2 的任务晚了 1 个 tick，截止时间为 5 的任务没有超时
+    TEST_CHECK(tsks[3]->deadline_miss == 1 && tsks[2]->deadline_miss == 0, "deadline miss count");
+    TEST_CHECK(prio_miss_calls == 1 && prio_miss_late == 1, "deadline miss hook");
+
+    prio_cleanup(tsks, evts, 5);
+#else
+    __EK_UNUSED(done);
+#endif /* EK_EVOKE_DEADLINE_ENABLE */
+}
+
+void evoke_prio_test(void)
+{
+    EK_LOG_INFO("evoke priority test start");
+
+    evoke_sim_reset();
+    ek_evoke_event_t *done = ek_evoke_event_create("done", 0);
+
+    prio_order_test(done);
+    prio_preempt_test(done, false);
+    prio_preempt_test(done, true);
+    prio_deadline_test(done);
+
+    ek_evoke_event_destroy(done);
+
+    EK_LOG_INFO("evoke priority test passed");
+}
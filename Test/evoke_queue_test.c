@@ -0,0 +1,111 @@
+#include "test.h"
+
+EK_LOG_FILE_TAG("evoke_queue_test.c")
+
+#define QUEUE_EXTRA (3U)
+
+static void *queue_payload(uint32_t i)
+{
+    return (void *)(uintptr_t)(i + 1U);
+}
+
+static void queue_isr_test(void)
+{
+    evoke_sim_reset();
+    ek_evoke_event_t *evt = ek_evoke_event_create("isr", 0);
+
+    ek_evoke_queue_stats_t stats;
+    ek_evoke_isr_stats(&stats);
+    uint32_t cap = stats.capacity;
+    TEST_CHECK(cap >= EK_EVOKE_MAX_ISR_REQ && stats.used == 0, "isr queue capacity");
+
+    // 主循环来不及处理时，中断连续提交超过容量的请求
+    for (uint32_t i = 0; i < cap + QUEUE_EXTRA; i++) ek_evoke_event_publish_from_isr(evt, queue_payload(i));
+    ek_evoke_isr_stats(&stats);
+    TEST_CHECK(stats.used == cap && stats.peak == cap, "isr queue high-water");
+
+#if EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_OVERWRITE
+    TEST_CHECK(stats.overwritten == QUEUE_EXTRA && stats.dropped == 0, "isr overwrite count");
+    void *last = queue_payload(cap + QUEUE_EXTRA - 1U);
+#else
+    TEST_CHECK(stats.dropped == QUEUE_EXTRA && stats.overwritten == 0, "isr drop count");
+    void *last = queue_payload(cap - 1U);
+#endif /* EK_EVOKE_OVERFLOW_POLICY */
+
+#if EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_COALESCE
+    // 与队列中已有的请求完全相同，合并而不是丢弃
+    ek_evoke_event_publish_from_isr(evt, queue_payload(0));
+    ek_evoke_isr_stats(&stats);
+    TEST_CHECK(stats.coalesced == 1 && stats.dropped == QUEUE_EXTRA, "isr coalesce count");
+#endif /* EK_EVOKE_OVERFLOW_POLICY */
+
+    evoke_sim_run_until(evt, cap);
+    TEST_CHECK(evt->count == cap && evt->data == last, "isr requests delivered in order");
+    ek_evoke_isr_stats(&stats);
+    TEST_CHECK(stats.used == 0, "isr queue drained");
+
+    ek_evoke_event_destroy(evt);
+}
+
+static void queue_defer_test(void)
+{
+    evoke_sim_reset();
+    ek_evoke_event_t *evt = ek_evoke_event_create("defer", 0);
+
+    ek_evoke_queue_stats_t stats;
+    ek_evoke_defer_stats(&stats);
+    uint32_t cap = stats.capacity;
+    TEST_CHECK(cap == EK_EVOKE_MAX_DEFER_REQ && stats.used == 0, "defer pool capacity");
+
+    for (uint32_t i = 0; i < cap + QUEUE_EXTRA; i++) ek_evoke_event_defer(evt, queue_payload(i), i + 1U, false);
+    ek_evoke_defer_stats(&stats);
+
+#if EK_EVOKE_DEFER_GROW == 1
+    // 池耗尽后从堆中分配，只有堆也耗尽时才丢弃
+    TEST_CHECK(stats.used + stats.dropped == cap + QUEUE_EXTRA && stats.used >= cap, "defer pool grows");
+    uint32_t expect = stats.used;
+#elif EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_OVERWRITE
+    TEST_CHECK(stats.used == cap && stats.overwritten == QUEUE_EXTRA, "defer overwrite count");
+    uint32_t expect = cap;
+#else
+    TEST_CHECK(stats.used == cap && stats.dropped == QUEUE_EXTRA, "defer drop count");
+    uint32_t expect = cap;
+#endif /* EK_EVOKE_DEFER_GROW */
+    TEST_CHECK(stats.peak == stats.used, "defer pool high-water");
+
+#if EK_EVOKE_DEFER_GROW == 0 && EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_COALESCE
+    ek_evoke_event_defer(evt, queue_payload(0), 1000, false);
+    ek_evoke_defer_stats(&stats);
+    TEST_CHECK(stats.coalesced == 1, "defer coalesce count");
+#endif
+
+    evoke_sim_run_until(evt, expect);
+    TEST_CHECK(evt->count == expect, "deferred requests fired");
+    ek_evoke_defer_stats(&stats);
+    TEST_CHECK(stats.used == 0 && stats.peak == expect, "defer pool drained");
+
+#if EK_EVOKE_DEFER_GROW == 0 && EK_EVOKE_OVERFLOW_POLICY == EK_EVOKE_OVERFLOW_OVERWRITE
+    // 最早提交的请求被覆盖，最后到期的是最新的请求
+    TEST_CHECK(evt->data == queue_payload(cap + QUEUE_EXTRA - 1U), "newest request kept");
+#endif
+
+    ek_evoke_event_destroy(evt);
+}
+
+void evoke_queue_test(void)
+{
+    EK_LOG_INFO("evoke queue test start");
+
+    queue_isr_test();
+    queue_defer_test();
+
+    ek_evoke_queue_stats_t stats;
+    ek_evoke_defer_stats(&stats);
+    EK_LOG_INFO("defer pool: capacity %u peak %u dropped %u coalesced %u overwritten %u",
+                stats.capacity,
+                stats.peak,
+                stats.dropped,
+                stats.coalesced,
+                stats.overwritten);
+    EK_LOG_INFO("evoke queue test passed");
+}
@@ -0,0 +1,80 @@
+#include <setjmp.h>
+#include "test.h"
+#include "linux_evoke_port.h"
+
+EK_LOG_FILE_TAG("evoke_sim.c")
+
+/*
+ * evoke 测试共用的模拟时钟，建立在主机移植 linux_evoke_port 之上：
+ * - 睡眠即把虚拟时钟拨到定时器的比较值，任务回调中用 evoke_sim_advance() 模拟占用 CPU 的时间
+ * - 可以模拟其他中断的提前唤醒，验证时间基准不会漂移
+ * - 目标事件计数达到要求后，在下一次睡眠时跳出事件主循环
+ */
+static jmp_buf sim_exit;
+static ek_evoke_event_t *sim_evt;
+static uint32_t sim_target;
+static uint32_t sim_early_max;
+static uint32_t sim_seed;
+static uint32_t sim_early_count;
+
+void (*evoke_sim_sleep_hook)(uint32_t xtick);
+
+/* 提前唤醒用的空中断 */
+static void sim_early_isr(void *arg)
+{
+    __EK_UNUSED(arg);
+    sim_early_count++;
+}
+
+static void sim_sleep(uint32_t xtick)
+{
+    if (evoke_sim_sleep_hook != NULL) evoke_sim_sleep_hook(xtick);
+    if (sim_evt->count >= sim_target) longjmp(sim_exit, 1);
+    if (xtick == EK_EVOKE_TICK_FOREVER && sim_early_max == 0)
+    {
+        EK_LOG_ERROR("sleep forever with nothing pending");
+        exit(1);
+    }
+
+    // 每次睡眠重新随机一个唤醒时间，上一次没有赶在定时器之前触发的作废
+    if (sim_early_max != 0)
+    {
+        sim_seed = sim_seed * 1103515245U + 12345U;
+        linux_evoke_irq_clear();
+        linux_evoke_irq_inject(1U + (sim_seed >> 8) % sim_early_max, sim_early_isr, NULL);
+    }
+}
+
+void evoke_sim_advance(uint32_t ticks)
+{
+    linux_evoke_advance(ticks);
+}
+
+void evoke_sim_early_wakeup(uint32_t max_ticks)
+{
+    sim_early_max = max_ticks;
+    sim_seed = 2024U;
+    sim_early_count = 0;
+    linux_evoke_irq_clear();
+}
+
+uint32_t evoke_sim_early_count(void)
+{
+    return sim_early_count;
+}
+
+void evoke_sim_reset(void)
+{
+    linux_evoke_reset();
+    linux_evoke_sleep_hook = sim_sleep;
+    sim_early_max = 0;
+    sim_early_count = 0;
+    evoke_sim_sleep_hook = NULL;
+}
+
+void evoke_sim_run_until(ek_evoke_event_t *evt, uint32_t target)
+{
+    sim_evt = evt;
+    sim_target = target;
+    if (setjmp(sim_exit) == 0) ek_evoke_event_loop();
+}
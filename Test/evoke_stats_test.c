@@ -0,0 +1,106 @@
+#include "test.h"
+
+#if EK_EVOKE_STATS_ENABLE == 1
+
+EK_LOG_FILE_TAG("evoke_stats_test.c")
+
+static uint32_t stats_hi_busy;
+static uint32_t stats_lo_busy = 1;
+
+/* 回调中推进模拟时钟，模拟占用 CPU 的时间 */
+static void stats_cb(ek_evoke_event_t *evt, void *arg)
+{
+    __EK_UNUSED(evt);
+    evoke_sim_advance(*(uint32_t *)arg);
+}
+
+void evoke_stats_test(void)
+{
+    EK_LOG_INFO("evoke stats test start");
+
+    evoke_sim_reset();
+    ek_evoke_event_t *ea = ek_evoke_event_create("a", 0);
+    ek_evoke_event_t *eb = ek_evoke_event_create("b", 0);
+    ek_evoke_event_t *done = ek_evoke_event_create("done", 0);
+    ek_evoke_task_t *hi = ek_evoke_task_create("hi", stats_cb, &stats_hi_busy);
+    ek_evoke_task_t *lo = ek_evoke_task_create("lo", stats_cb, &stats_lo_busy);
+    ek_evoke_task_set_priority(hi, 1);
+    ek_evoke_event_subscribe(hi, ea);
+    ek_evoke_event_subscribe(lo, eb);
+
+    ek_evoke_task_stats_t st;
+    ek_evoke_loop_stats_t loop;
+
+    // 同时就绪：hi 忙 3 个 tick，lo 因此晚 3 个 tick 才执行，之后深度睡眠到第 10 个 tick
+    stats_hi_busy = 3;
+    ek_evoke_event_publish(ea, NULL);
+    ek_evoke_event_publish(eb, NULL);
+    ek_evoke_event_defer(done, NULL, 10, false);
+    evoke_sim_run_until(done, 1);
+
+    ek_evoke_task_stats(hi, &st);
+    TEST_CHECK(st.run_count == 1 && st.run_total == 3 && st.run_max == 3, "hi run time");
+    TEST_CHECK(st.latency_max == 0 && st.latency_hist[0] == 1, "hi wakeup latency");
+    ek_evoke_task_stats(lo, &st);
+    TEST_CHECK(st.run_count == 1 && st.run_total == 1, "lo run time");
+    TEST_CHECK(st.latency_total == 3 && st.latency_max == 3 && st.latency_hist[2] == 1, "lo wakeup latency");
+
+    ek_evoke_loop_stats(&loop);
+    TEST_CHECK(loop.elapsed == 10 && loop.busy == 4, "loop busy time");
+    TEST_CHECK(loop.deep_sleep == 6 && loop.deep_count == 1 && loop.light_count == 0, "loop deep sleep time");
+
+    // 持有睡眠锁时计入浅睡眠
+    ek_evoke_sleep_lock();
+    ek_evoke_event_defer(done, NULL, 5, false);
+    evoke_sim_run_until(done, 2);
+    ek_evoke_sleep_unlock();
+    ek_evoke_loop_stats(&loop);
+    TEST_CHECK(loop.light_sleep == 5 && loop.light_count == 1 && loop.deep_count == 1, "loop light sleep time");
+    TEST_CHECK(loop.busy == 4, "busy time excludes sleep");
+
+    // 超出直方图范围的延迟计入最后一档
+    stats_hi_busy = 1000;
+    ek_evoke_event_publish(ea, NULL);
+    ek_evoke_event_publish(eb, NULL);
+    ek_evoke_event_publish(done, NULL);
+    evoke_sim_run_until(done, 3);
+    ek_evoke_task_stats(lo, &st);
+    TEST_CHECK(st.latency_max == 1000 && st.latency_hist[EK_EVOKE_STATS_HIST_BINS - 1] == 1, "latency histogram clamp");
+    ek_evoke_loop_stats(&loop);
+    TEST_CHECK(loop.busy == 1005, "busy time of long callbacks");
+
+    // 队列深度
+    stats_hi_busy = 0;
+    ek_evoke_event_publish_from_isr(ea, NULL);
+    ek_evoke_event_publish_from_isr(ea, NULL);
+    ek_evoke_event_defer(done, NULL, 100, false);
+    ek_evoke_loop_stats(&loop);
+    TEST_CHECK(loop.isr_depth == 2 && loop.isr_peak >= 2 && loop.defer_len == 1, "queue depth");
+    evoke_sim_run_until(done, 4);
+    ek_evoke_task_stats(hi, &st);
+    TEST_CHECK(st.run_count == 4, "isr requests drained");
+
+    ek_evoke_top();
+
+    ek_evoke_stats_reset();
+    ek_evoke_task_stats(hi, &st);
+    ek_evoke_loop_stats(&loop);
+    TEST_CHECK(st.run_count == 0 && st.latency_hist[0] == 0 && loop.elapsed == 0 && loop.deep_count == 0,
+               "stats reset");
+
+    ek_evoke_task_destroy(hi);
+    ek_evoke_task_destroy(lo);
+    ek_evoke_event_destroy(ea);
+    ek_evoke_event_destroy(eb);
+    ek_evoke_event_destroy(done);
+
+    EK_LOG_INFO("evoke stats test passed");
+}
+
+#else
+
+void evoke_stats_test(void)
+{
+}
+
+#endif /* EK_EVOKE_STATS_ENABLE */
@@ -0,0 +1,124 @@
+#include "test.h"
+
+EK_LOG_FILE_TAG("evoke_tick_test.c")
+
+#define TICK_HZ        (1000U)
+#define TICK_DAY       (86400U * TICK_HZ)
+#define TICK_PERIOD    (TICK_HZ)
+#define TICK_DAYS      (3U)
+#define TICK_BUSY      (3U)
+#define TICK_EARLY_MAX (700U)
+
+static uint32_t tick_expect;
+static uint32_t tick_fired;
+static uint32_t tick_target;
+static uint32_t tick_late;
+static ek_evoke_event_t *tick_evt;
+static ek_evoke_event_t *tick_done;
+
+/* 长时间空闲：分段延迟，每段不超过 EK_EVOKE_MAX_DELAY */
+static void tick_skip(uint32_t ticks)
+{
+    while (ticks != 0)
+    {
+        uint32_t step = (ticks > EK_EVOKE_MAX_DELAY) ? EK_EVOKE_MAX_DELAY : ticks;
+        ek_evoke_event_defer(tick_done, NULL, step, false);
+        evoke_sim_run_until(tick_done, tick_done->count + 1U);
+        ticks -= step;
+    }
+}
+
+/* 记录到期顺序：payload 为期望的到期时间 */
+static void tick_order_cb(ek_evoke_event_t *evt, void *arg)
+{
+    __EK_UNUSED(arg);
+
+    if (ek_evoke_get_tick() != (uint32_t)(uintptr_t)evt->data) tick_late++;
+    tick_fired++;
+    if (tick_fired == tick_target) ek_evoke_event_publish(tick_done, NULL);
+}
+
+static void tick_wrap_test(void)
+{
+    static const uint32_t offsets[] = { 0x20000U, 5U, 0x7FFFFFF0U, 1U, 0x10000U, 4U };
+    const uint32_t amount = sizeof(offsets) / sizeof(offsets[0]);
+
+    // 停在回绕点前 8 个 tick，一部分请求在回绕前到期，一部分在回绕后到期
+    tick_skip((0U - ek_evoke_get_tick()) - 8U);
+    uint32_t now = ek_evoke_get_tick();
+    TEST_CHECK(now == 0xFFFFFFF8U, "clock parked before the wrap");
+
+    ek_evoke_task_t *tsk = ek_evoke_task_create("order", tick_order_cb, NULL);
+    ek_evoke_event_subscribe(tsk, tick_evt);
+    for (uint32_t i = 0; i < amount; i++)
+    {
+        ek_evoke_event_defer(tick_evt, (void *)(uintptr_t)(now + offsets[i]), offsets[i], false);
+    }
+
+    tick_fired = 0;
+    tick_late = 0;
+    tick_target = amount;
+    evoke_sim_run_until(tick_done, tick_done->count + 1U);
+    TEST_CHECK(tick_fired == amount && tick_late == 0, "requests across the wrap fire in order and on time");
+    TEST_CHECK(ek_evoke_get_tick() == now + 0x7FFFFFF0U, "last request fired at the largest delay");
+
+    ek_evoke_task_destroy(tsk);
+}
+
+/* 周期任务：每次到期后忙 TICK_BUSY 个 tick 再重新延迟一个周期 */
+static void tick_period_cb(ek_evoke_event_t *evt, void *arg)
+{
+    __EK_UNUSED(evt);
+    __EK_UNUSED(arg);
+
+    if (ek_evoke_get_tick() != tick_expect) tick_late++;
+    evoke_sim_advance(TICK_BUSY);
+    tick_expect += TICK_PERIOD;
+
+    if (++tick_fired == tick_target) ek_evoke_event_publish(tick_done, NULL);
+    else ek_evoke_event_defer(tick_evt, NULL, TICK_PERIOD, false);
+}
+
+static void tick_drift_test(void)
+{
+    // 从回绕前一天开始跑三天，期间不断被其他中断提前唤醒
+    tick_skip((0U - ek_evoke_get_tick()) - TICK_DAY);
+    uint32_t start = ek_evoke_get_tick();
+
+    ek_evoke_task_t *tsk = ek_evoke_task_create("period", tick_period_cb, NULL);
+    ek_evoke_event_subscribe(tsk, tick_evt);
+
+    tick_fired = 0;
+    tick_late = 0;
+    tick_target = TICK_DAYS * TICK_DAY / TICK_PERIOD;
+    tick_expect = start + TICK_PERIOD;
+    evoke_sim_early_wakeup(TICK_EARLY_MAX);
+    ek_evoke_event_defer(tick_evt, NULL, TICK_PERIOD, false);
+    evoke_sim_run_until(tick_done, tick_done->count + 1U);
+    uint32_t early = evoke_sim_early_count();
+    evoke_sim_early_wakeup(0);
+
+    TEST_CHECK(tick_fired == tick_target && tick_late == 0, "periodic requests fire on time");
+    TEST_CHECK(early >= tick_target / 2U, "early wakeups were injected");
+    TEST_CHECK(ek_evoke_get_tick() - start == TICK_DAYS * TICK_DAY + TICK_BUSY, "no drift after days");
+
+    ek_evoke_task_destroy(tsk);
+    EK_LOG_INFO("%u periods over %u days, %u early wakeups, no drift", tick_target, TICK_DAYS, early);
+}
+
+void evoke_tick_test(void)
+{
+    EK_LOG_INFO("evoke tick test start");
+
+    evoke_sim_reset();
+    tick_evt = ek_evoke_event_create("tick", 0);
+    tick_done = ek_evoke_event_create("done", 0);
+
+    tick_wrap_test();
+    tick_drift_test();
+
+    ek_evoke_event_destroy(tick_evt);
+    ek_evoke_event_destroy(tick_done);
+
+    EK_LOG_INFO("evoke tick test passed");
+}
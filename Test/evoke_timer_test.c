@@ -0,0 +1,160 @@
+#include "test.h"
+
+EK_LOG_FILE_TAG("evoke_timer_test.c")
+
+#define TIMER_WDT     (50U)
+#define TIMER_FEED    (30U)
+#define TIMER_PERIOD  (10U)
+#define TIMER_BUSY    (25U)
+#define TIMER_RESTART (3U)
+
+static ek_evoke_event_t *timer_evt;
+static ek_evoke_event_t *timer_step;
+static uint32_t timer_fired;
+static uint32_t timer_ticks[8];
+static uint32_t timer_busy;
+
+static uint32_t timer_used(void)
+{
+    ek_evoke_queue_stats_t stats;
+    ek_evoke_defer_stats(&stats);
+    return stats.used;
+}
+
+/* 让主循环跑 ticks 个 tick */
+static void timer_wait(uint32_t ticks)
+{
+    ek_evoke_event_defer(timer_step, NULL, ticks, false);
+    evoke_sim_run_until(timer_step, timer_step->count + 1U);
+    timer_step->count = 0;
+}
+
+static void timer_cb(ek_evoke_event_t *evt, void *arg)
+{
+    __EK_UNUSED(evt);
+    __EK_UNUSED(arg);
+
+    if (timer_fired < sizeof(timer_ticks) / sizeof(timer_ticks[0])) timer_ticks[timer_fired] = ek_evoke_get_tick();
+    timer_fired++;
+    evoke_sim_advance(timer_busy);
+    timer_busy = 0;
+}
+
+static void timer_watchdog_test(void)
+{
+    uint32_t start = ek_evoke_get_tick();
+    timer_fired = 0;
+
+    // 每 TIMER_FEED 个 tick 喂一次狗，看门狗不会到期
+    ek_evoke_defer_t wdt = ek_evoke_event_defer(timer_evt, NULL, TIMER_WDT, false);
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        timer_wait(TIMER_FEED);
+        TEST_CHECK(ek_evoke_defer_restart(wdt, TIMER_WDT), "restart a pending request");
+    }
+    TEST_CHECK(timer_fired == 0 && timer_used() == 1, "restarted request neither fired nor reallocated");
+
+    // 停止喂狗，最后一次喂狗后 TIMER_WDT 个 tick 到期
+    timer_wait(TIMER_WDT - 1U);
+    TEST_CHECK(timer_fired == 0 && ek_evoke_defer_pending(wdt), "watchdog still pending");
+    timer_wait(1);
+    TEST_CHECK(timer_fired == 1 && timer_ticks[0] - start == 3U * TIMER_FEED + TIMER_WDT, "watchdog expires");
+
+    // 到期后句柄失效
+    TEST_CHECK(!ek_evoke_defer_pending(wdt), "handle invalid after firing");
+    TEST_CHECK(!ek_evoke_defer_restart(wdt, TIMER_WDT) && !ek_evoke_defer_cancel(wdt), "stale handle rejected");
+    TEST_CHECK(timer_used() == 0, "one-shot request returned to the pool");
+}
+
+static void timer_cancel_test(void)
+{
+    timer_fired = 0;
+
+    TEST_CHECK(!ek_evoke_defer_cancel(EK_EVOKE_DEFER_NONE), "cancel an empty handle");
+    TEST_CHECK(!ek_evoke_defer_pending(ek_evoke_event_defer(timer_step, NULL, 0, false)) && timer_step->count == 1,
+               "zero delay publishes now");
+    timer_step->count = 0;
+
+    ek_evoke_defer_t a = ek_evoke_event_defer(timer_evt, NULL, 10, false);
+    ek_evoke_defer_t b = ek_evoke_event_defer(timer_evt, NULL, 20, false);
+    TEST_CHECK(ek_evoke_defer_cancel(a), "cancel a pending request");
+    TEST_CHECK(!ek_evoke_defer_cancel(a), "cancel twice");
+
+    // 被取消的请求已归还，旧句柄不能影响之后分配的请求
+    ek_evoke_defer_t c = ek_evoke_event_defer(timer_evt, NULL, 5, false);
+    TEST_CHECK(!ek_evoke_defer_cancel(a) && ek_evoke_defer_pending(c), "stale handle does not hit a reused request");
+
+    timer_wait(30);
+    TEST_CHECK(timer_fired == 2 && timer_ticks[1] - timer_ticks[0] == 15U, "only uncancelled requests fire");
+    TEST_CHECK(!ek_evoke_defer_pending(b) && !ek_evoke_defer_pending(c), "fired handles invalid");
+}
+
+static void timer_periodic_test(void)
+{
+    ek_evoke_queue_stats_t stats;
+    uint32_t start = ek_evoke_get_tick();
+    timer_fired = 0;
+
+    ek_evoke_defer_t p = ek_evoke_event_defer_periodic(timer_evt, NULL, TIMER_PERIOD, false);
+    ek_evoke_defer_stats(&stats);
+    uint32_t peak = stats.peak;
+
+    timer_wait(5U * TIMER_PERIOD);
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        TEST_CHECK(timer_ticks[i] - start == (i + 1U) * TIMER_PERIOD, "periodic request fires every period");
+    }
+    ek_evoke_defer_stats(&stats);
+    TEST_CHECK(timer_fired == 5 && stats.used == 1 && stats.peak == peak, "periodic request is not reallocated");
+    TEST_CHECK(ek_evoke_defer_pending(p), "periodic handle stays valid");
+
+    // 回调占用超过两个周期，错过的两个周期合并为一次迟到的发布，之后仍按原来的周期对齐
+    timer_fired = 0;
+    timer_busy = TIMER_BUSY;
+    timer_wait(5U * TIMER_PERIOD);
+    TEST_CHECK(timer_fired == 4 && timer_ticks[0] - start == 6U * TIMER_PERIOD &&
+                   timer_ticks[1] - start == 6U * TIMER_PERIOD + TIMER_BUSY &&
+                   timer_ticks[2] - start == 9U * TIMER_PERIOD && timer_ticks[3] - start == 10U * TIMER_PERIOD,
+               "missed periods merged without drift");
+
+    // 重新计时后按新的起点继续周期发布
+    timer_fired = 0;
+    uint32_t now = ek_evoke_get_tick();
+    TEST_CHECK(ek_evoke_defer_restart(p, TIMER_RESTART), "restart a periodic request");
+    timer_wait(TIMER_RESTART + TIMER_PERIOD);
+    TEST_CHECK(timer_fired == 2 && timer_ticks[0] - now == TIMER_RESTART &&
+                   timer_ticks[1] - now == TIMER_RESTART + TIMER_PERIOD,
+               "periodic request restarted");
+
+    TEST_CHECK(ek_evoke_defer_cancel(p) && timer_used() == 0, "cancel a periodic request");
+    timer_fired = 0;
+    timer_wait(3U * TIMER_PERIOD);
+    TEST_CHECK(timer_fired == 0, "cancelled periodic request stops");
+
+    // 销毁事件时周期请求一并释放
+    ek_evoke_event_t *evt = ek_evoke_event_create("periodic", 0);
+    p = ek_evoke_event_defer_periodic(evt, NULL, TIMER_PERIOD, true);
+    ek_evoke_event_destroy(evt);
+    TEST_CHECK(!ek_evoke_defer_pending(p) && timer_used() == 0, "destroying the event releases periodic requests");
+}
+
+void evoke_timer_test(void)
+{
+    EK_LOG_INFO("evoke timer test start");
+
+    evoke_sim_reset();
+    timer_evt = ek_evoke_event_create("timer", 0);
+    timer_step = ek_evoke_event_create("step", 0);
+    ek_evoke_task_t *tsk = ek_evoke_task_create("timer", timer_cb, NULL);
+    ek_evoke_event_subscribe(tsk, timer_evt);
+
+    timer_watchdog_test();
+    timer_cancel_test();
+    timer_periodic_test();
+
+    ek_evoke_task_destroy(tsk);
+    ek_evoke_event_destroy(timer_evt);
+    ek_evoke_event_destroy(timer_step);
+
+    EK_LOG_INFO("evoke timer test passed");
+}
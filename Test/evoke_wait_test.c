@@ -0,0 +1,152 @@
+/* 失败时附带回调的执行顺序 */
+#define TEST_CHECK_CONTEXT() fprintf(stderr, "trace \"%s\"\n", wait_trace)
+
+#include "test.h"
+
+EK_LOG_FILE_TAG("evoke_wait_test.c")
+
+#define WAIT_TIMEOUT (20U)
+
+static char wait_trace[16];
+static uint32_t wait_len;
+static bool wait_timed_out;
+
+/* 记录唤醒任务的事件名称的首字母，超时记为 '-' */
+static void wait_any_cb(ek_evoke_event_t *evt, void *arg)
+{
+    __EK_UNUSED(arg);
+
+    wait_timed_out = ek_evoke_task_self()->timed_out;
+    if (wait_len < sizeof(wait_trace) - 1U) wait_trace[wait_len++] = (evt != NULL) ? evt->name[0] : '-';
+}
+
+static void wait_run(ek_evoke_event_t *done)
+{
+    memset(wait_trace, 0, sizeof(wait_trace));
+    wait_len = 0;
+    ek_evoke_event_publish(done, NULL);
+    evoke_sim_run_until(done, done->count);
+}
+
+static void wait_any_test(ek_evoke_event_t *done)
+{
+    ek_evoke_event_t *rx = ek_evoke_event_create("rx", 1);
+    ek_evoke_event_t *tmo = ek_evoke_event_create("timeout", 0);
+    ek_evoke_event_t *stop = ek_evoke_event_create("stop", 0);
+    ek_evoke_event_t *evts[] = { rx, tmo, stop };
+    ek_evoke_task_t *tsk = ek_evoke_task_create("any", wait_any_cb, NULL);
+
+    // rx 已有计数，立即就绪，不挂到任何等待链表上
+    TEST_CHECK(ek_evoke_event_subscribe_any(tsk, evts, 3), "pending count makes the task ready");
+    TEST_CHECK(rx->count == 0 && ek_list_is_empty(&stop->wait_list), "only the pending event is consumed");
+    wait_run(done);
+    TEST_CHECK(strcmp(wait_trace, "r") == 0, "woken by pending rx");
+
+    // 回调返回后重新等待全部三个事件，每次只由发布的事件唤醒
+    TEST_CHECK(tsk->state == EK_EVOKE_STATE_WAITTING && !ek_list_is_empty(&stop->wait_list), "re-armed on all events");
+    ek_evoke_event_publish(stop, NULL);
+    wait_run(done);
+    TEST_CHECK(strcmp(wait_trace, "s") == 0, "woken by stop");
+
+    // 任务被 timeout 唤醒后 rx 没有等待者，计数保留，重新等待时立即消耗
+    ek_evoke_event_publish(tmo, NULL);
+    ek_evoke_event_broadcast(rx, NULL);
+    wait_run(done);
+    TEST_CHECK(strcmp(wait_trace, "tr") == 0, "event published while the task is ready");
+    TEST_CHECK(tmo->count == 0 && rx->count == 0, "each publish wakes once");
+
+    ek_evoke_task_destroy(tsk);
+    TEST_CHECK(ek_list_is_empty(&rx->wait_list) && ek_list_is_empty(&tmo->wait_list), "destroy releases all waiters");
+
+    // 带超时等待多个事件
+    tsk = ek_evoke_task_create("any", wait_any_cb, NULL);
+    rx->count = 0;
+    TEST_CHECK(!ek_evoke_task_await_any(tsk, evts, 2, WAIT_TIMEOUT), "await any with timeout");
+    ek_evoke_event_defer(done, NULL, WAIT_TIMEOUT * 2U, false);
+    memset(wait_trace, 0, sizeof(wait_trace));
+    wait_len = 0;
+    evoke_sim_run_until(done, done->count + 1U);
+    TEST_CHECK(strcmp(wait_trace, "-") == 0 && wait_timed_out, "await any timed out");
+    TEST_CHECK(tsk->state == EK_EVOKE_STATE_WAITTING && ek_list_is_empty(&stop->wait_list), "re-armed after timeout");
+
+    // 销毁其中一个事件，任务从其他事件上一并摘下
+    ek_evoke_event_destroy(tmo);
+    TEST_CHECK(tsk->state == EK_EVOKE_STATE_IDLE && ek_list_is_empty(&rx->wait_list), "destroy one of the events");
+
+    ek_evoke_task_destroy(tsk);
+    ek_evoke_event_destroy(rx);
+    ek_evoke_event_destroy(stop);
+}
+
+#if EK_EVOKE_GROUP_ENABLE == 1
+static void wait_group_cb(ek_evoke_event_t *evt, void *arg)
+{
+    __EK_UNUSED(evt);
+
+    wait_timed_out = ek_evoke_task_self()->timed_out;
+    if (wait_len < sizeof(wait_trace) - 1U) wait_trace[wait_len++] = *(const char *)arg;
+}
+
+static void wait_group_test(ek_evoke_event_t *done)
+{
+    ek_evoke_group_t *grp = ek_evoke_group_create("grp");
+    ek_evoke_task_t *all = ek_evoke_task_create("all", wait_group_cb, "A");
+    ek_evoke_task_t *any = ek_evoke_task_create("any", wait_group_cb, "B");
+    ek_evoke_task_set_priority(all, 1);
+
+    TEST_CHECK(!ek_evoke_group_wait(all, grp, 0x3, EK_EVOKE_GROUP_WAIT_ALL | EK_EVOKE_GROUP_CLEAR, 0), "wait all");
+    TEST_CHECK(!ek_evoke_group_wait(any, grp, 0x6, EK_EVOKE_GROUP_CLEAR, 0), "wait any");
+
+    // 只有一位，全部条件不满足
+    ek_evoke_group_set(grp, 0x1);
+    wait_run(done);
+    TEST_CHECK(wait_len == 0, "wait all needs every bit");
+
+    // 两个任务都满足：都看到清除之前的值，之后两个 mask 中的位一起清除
+    TEST_CHECK(ek_evoke_group_set(grp, 0x2) == 0, "bits cleared on exit");
+    wait_run(done);
+    TEST_CHECK(strcmp(wait_trace, "AB") == 0, "both waiters woken");
+    TEST_CHECK(all->group_bits == 0x3 && any->group_bits == 0x3, "group bits reported");
+
+    // 中断中置位
+    ek_evoke_group_set_from_isr(grp, 0x4);
+    wait_run(done);
+    TEST_CHECK(strcmp(wait_trace, "B") == 0 && any->group_bits == 0x4 && ek_evoke_group_get(grp) == 0, "set from isr");
+
+    // 没有任务等待的位保留在事件组中
+    TEST_CHECK(ek_evoke_group_set(grp, 0x10) == 0x10, "bits kept without waiters");
+    TEST_CHECK(ek_evoke_group_clear(grp, 0x10) == 0x10 && ek_evoke_group_get(grp) == 0, "clear bits");
+
+    // 带超时等待
+    TEST_CHECK(!ek_evoke_group_wait(any, grp, 0x8, 0, WAIT_TIMEOUT), "wait with timeout");
+    ek_evoke_group_set(grp, 0x1);
+    ek_evoke_event_defer(done, NULL, WAIT_TIMEOUT * 2U, false);
+    memset(wait_trace, 0, sizeof(wait_trace));
+    wait_len = 0;
+    evoke_sim_run_until(done, done->count + 1U);
+    TEST_CHECK(strcmp(wait_trace, "B") == 0 && wait_timed_out && any->group_bits == 0x1, "group wait timed out");
+
+    ek_evoke_group_destroy(grp);
+    TEST_CHECK(all->state == EK_EVOKE_STATE_IDLE && any->state == EK_EVOKE_STATE_IDLE, "destroy group");
+
+    ek_evoke_task_destroy(all);
+    ek_evoke_task_destroy(any);
+}
+#endif /* EK_EVOKE_GROUP_ENABLE */
+
+void evoke_wait_test(void)
+{
+    EK_LOG_INFO("evoke wait test start");
+
+    evoke_sim_reset();
+    ek_evoke_event_t *done = ek_evoke_event_create("done", 0);
+
+    wait_any_test(done);
+#if EK_EVOKE_GROUP_ENABLE == 1
+    wait_group_test(done);
+#endif /* EK_EVOKE_GROUP_ENABLE */
+
+    ek_evoke_event_destroy(done);
+
+    EK_LOG_INFO("evoke wait test passed");
+}
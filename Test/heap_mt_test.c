@@ -0,0 +1,160 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <time.h>
+#include "test.h"
+
+#if EK_HEAP_THREAD_SAFE == 1 && EK_HEAP_CACHE_ENABLE == 1
+
+EK_LOG_FILE_TAG("heap_mt_test.c")
+
+#define MT_THREADS  (4U)
+#define MT_ROUNDS   (50000U)
+#define MT_SLOTS    (16U)
+#define MT_MAX_SIZE (160U)
+
+typedef struct
+{
+    uint32_t id;
+    bool use_cache;
+    uint32_t corrupted;
+    uint32_t failed;
+    uint32_t hits;
+    uint32_t misses;
+} mt_worker_t;
+
+/* 每个线程模拟一个任务，缓存指针放在线程本地变量里 */
+static __thread ek_heap_cache_t *mt_cache;
+
+ek_heap_cache_t *ek_mem_task_cache(void)
+{
+    return mt_cache;
+}
+
+static void *heap_mt_worker(void *arg)
+{
+    mt_worker_t *w = (mt_worker_t *)arg;
+    ek_heap_cache_t cache;
+    memset(&cache, 0, sizeof(cache));
+    if (w->use_cache) mt_cache = &cache;
+
+    uint8_t *slots[MT_SLOTS] = { 0 };
+    uint32_t sizes[MT_SLOTS] = { 0 };
+    uint32_t seed = w->id * 2654435761U + 1U;
+
+    for (uint32_t r = 0; r < MT_ROUNDS; r++)
+    {
+        seed = seed * 1103515245U + 12345U;
+        uint32_t i = (seed >> 16) % MT_SLOTS;
+        uint8_t tag = (uint8_t)(w->id * MT_SLOTS + i);
+
+        if (slots[i] != NULL)
+        {
+            // 其他线程改写了这块内存说明堆被并发破坏
+            for (uint32_t k = 0; k < sizes[i]; k++)
+            {
+                if (slots[i][k] != tag)
+                {
+                    w->corrupted++;
+                    break;
+                }
+            }
+            ek_free(slots[i]);
+        }
+        else
+        {
+            sizes[i] = 1U + (seed >> 8) % MT_MAX_SIZE;
+            slots[i] = ek_malloc(sizes[i]);
+            if (slots[i] == NULL)
+            {
+                w->failed++;
+                continue;
+            }
+            memset(slots[i], tag, sizes[i]);
+        }
+    }
+
+    for (uint32_t i = 0; i < MT_SLOTS; i++) ek_free(slots[i]);
+
+    w->hits = cache.hits;
+    w->misses = cache.misses;
+    ek_heap_cache_flush(&cache);
+    mt_cache = NULL;
+    return NULL;
+}
+
+static double heap_mt_run(bool use_cache, mt_worker_t *workers)
+{
+    pthread_t threads[MT_THREADS];
+    struct timespec t0, t1;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t i = 0; i < MT_THREADS; i++)
+    {
+        memset(&workers[i], 0, sizeof(workers[i]));
+        workers[i].id = i;
+        // 第 0 个线程不带缓存，和带缓存的线程混合走两条路径
+        workers[i].use_cache = use_cache && i != 0;
+        pthread_create(&threads[i], NULL, heap_mt_worker, &workers[i]);
+    }
+    for (uint32_t i = 0; i < MT_THREADS; i++) pthread_join(threads[i], NULL);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    return (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) / 1e9;
+}
+
+void heap_mt_test(void)
+{
+    EK_LOG_INFO("heap multi-thread test start");
+
+    mt_worker_t workers[MT_THREADS];
+    ek_heap_stats_t before, after;
+    ek_heap_stats(&before);
+#if EK_HEAP_TRACE == 1
+    uint32_t live = ek_heap_trace_live();
+#endif /* EK_HEAP_TRACE */
+
+    double locked_s = heap_mt_run(false, workers);
+    for (uint32_t i = 0; i < MT_THREADS; i++)
+    {
+        TEST_CHECK(workers[i].corrupted == 0, "heap corrupted without cache");
+        TEST_CHECK(workers[i].failed == 0, "allocation failed without cache");
+    }
+
+    double cached_s = heap_mt_run(true, workers);
+    uint32_t hits = 0, misses = 0;
+    for (uint32_t i = 0; i < MT_THREADS; i++)
+    {
+        TEST_CHECK(workers[i].corrupted == 0, "heap corrupted with cache");
+        TEST_CHECK(workers[i].failed == 0, "allocation failed with cache");
+        hits += workers[i].hits;
+        misses += workers[i].misses;
+    }
+    TEST_CHECK(hits > misses, "cache should serve most small allocations");
+
+    // 全部释放、缓存归还之后，堆结构完整且计数回到初始值
+    ek_heap_stats(&after);
+    TEST_CHECK(tlsf_check(ek_default_tlsf) == 0, "tlsf integrity");
+    TEST_CHECK(after.used == before.used, "used bytes after threads");
+    TEST_CHECK(after.alloc_count - before.alloc_count == after.free_count - before.free_count, "alloc/free balance");
+#if EK_HEAP_TRACE == 1
+    TEST_CHECK(ek_heap_trace_live() == live, "trace records after threads");
+#endif /* EK_HEAP_TRACE */
+
+    EK_LOG_INFO("%u threads x %u ops: locked %.4f s, cached %.4f s, cache hits %u misses %u",
+                MT_THREADS,
+                MT_ROUNDS,
+                locked_s,
+                cached_s,
+                hits,
+                misses);
+    EK_LOG_INFO("heap multi-thread test passed");
+}
+
+#else
+
+void heap_mt_test(void)
+{
+}
+
+#endif /* EK_HEAP_THREAD_SAFE && EK_HEAP_CACHE_ENABLE */
@@ -0,0 +1,69 @@
+#include "test.h"
+
+#if EK_HEAP_REGION_ENABLE == 1
+
+EK_LOG_FILE_TAG("heap_region_test.c")
+
+void heap_region_test(void)
+{
+    EK_LOG_INFO("heap region test start");
+
+    ek_heap_regions_init();
+
+    ek_heap_t *heaps[] = { &ek_heap_fast, &ek_heap_dma, &ek_heap_bulk };
+    size_t base_used[EK_ARRAY_LEN(heaps)];
+    for (size_t i = 0; i < EK_ARRAY_LEN(heaps); i++)
+    {
+        base_used[i] = ek_heap_used_in(heaps[i]);
+        EK_LOG_INFO("heap %-4s pools:%u used:%zu unused:%zu",
+                    heaps[i]->name,
+                    heaps[i]->pool_amount,
+                    base_used[i],
+                    ek_heap_unused_in(heaps[i]));
+        TEST_CHECK(ek_heap_unused_in(heaps[i]) > 0, "heap region not available");
+    }
+    TEST_CHECK(ek_heap_bulk.pool_amount == 2, "bulk heap should span both SDRAM regions");
+
+    // 各区域的分配落在对应的地址范围内
+    uint8_t *fast = ek_malloc_in(&ek_heap_fast, 256);
+    uint8_t *dma = ek_malloc_in(&ek_heap_dma, 256);
+    uint8_t *plain = ek_malloc(256);
+    TEST_CHECK(fast && ek_heap_of(fast) == &ek_heap_fast, "fast alloc");
+    TEST_CHECK(dma && ek_heap_of(dma) == &ek_heap_dma, "dma alloc");
+    TEST_CHECK(plain && ek_heap_of(plain) == &ek_heap_dma, "default alloc goes to dma heap");
+
+    // 大块分配：第一个池放不下时使用第二个池，两个都放不下时失败
+    size_t big = ek_heap_unused_in(&ek_heap_bulk) / 3;
+    uint8_t *bulk1 = ek_malloc_in(&ek_heap_bulk, big);
+    uint8_t *bulk2 = ek_malloc_in(&ek_heap_bulk, big);
+    TEST_CHECK(bulk1 && bulk2, "bulk alloc");
+    TEST_CHECK(ek_heap_of(bulk1) == &ek_heap_bulk && ek_heap_of(bulk2) == &ek_heap_bulk, "bulk alloc region");
+    TEST_CHECK(ek_malloc_in(&ek_heap_bulk, big * 2) == NULL, "oversized bulk alloc should fail");
+    memset(bulk1, 0xA5, big);
+    memset(bulk2, 0x5A, big);
+
+    // realloc 留在原来的区域内
+    fast = ek_realloc(fast, 1024);
+    TEST_CHECK(fast && ek_heap_of(fast) == &ek_heap_fast, "fast realloc");
+
+    // ek_free 按地址归还到所属的堆
+    ek_free(fast);
+    ek_free(dma);
+    ek_free(plain);
+    ek_free(bulk1);
+    ek_free(bulk2);
+    for (size_t i = 0; i < EK_ARRAY_LEN(heaps); i++)
+    {
+        TEST_CHECK(ek_heap_used_in(heaps[i]) == base_used[i], "heap region leaked");
+    }
+
+    EK_LOG_INFO("heap region test passed");
+}
+
+#else
+
+void heap_region_test(void)
+{
+}
+
+#endif /* EK_HEAP_REGION_ENABLE */
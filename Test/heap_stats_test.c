@@ -0,0 +1,76 @@
+#include <time.h>
+#include "test.h"
+
+EK_LOG_FILE_TAG("heap_stats_test.c")
+
+#define STATS_FRAGMENTS (200U)
+#define STATS_QUERIES   (20000U)
+
+static void heap_stats_walker(void *ptr, size_t size, int used, void *user)
+{
+    __EK_UNUSED(ptr);
+    if (used) *(size_t *)user += size;
+}
+
+void heap_stats_test(void)
+{
+    EK_LOG_INFO("heap stats test start");
+
+    ek_heap_stats_t before, st;
+    ek_heap_stats(&before);
+
+    // 计数和逐块遍历的结果一致
+    void *frags[STATS_FRAGMENTS];
+    for (uint32_t i = 0; i < STATS_FRAGMENTS; i++) frags[i] = ek_malloc(16 + (i % 7) * 8);
+    for (uint32_t i = 0; i < STATS_FRAGMENTS; i += 2) ek_free(frags[i]);
+
+    size_t walked = 0;
+    tlsf_walk_pool(tlsf_get_pool(ek_default_tlsf), heap_stats_walker, &walked);
+    ek_heap_stats(&st);
+    TEST_CHECK(st.used == walked, "used bytes differ from pool walk");
+    TEST_CHECK(st.alloc_count - before.alloc_count == STATS_FRAGMENTS, "alloc count");
+    TEST_CHECK(st.free_count - before.free_count == STATS_FRAGMENTS / 2, "free count");
+    TEST_CHECK(st.peak >= st.used && st.largest_free <= st.total - st.used, "peak / largest free");
+
+    // 最大空闲块决定了大块分配能否成功
+    void *big = ek_malloc(st.largest_free);
+    TEST_CHECK(big != NULL, "largest free block should be allocatable");
+    TEST_CHECK(ek_malloc(st.total) == NULL, "oversized alloc should fail");
+    ek_heap_stats(&st);
+    TEST_CHECK(st.failed_count == before.failed_count + 1, "failed count");
+    ek_free(big);
+
+    // realloc 只调整已用字节数
+    void *grow = ek_malloc(32);
+    size_t used = ek_heap_used();
+    grow = ek_realloc(grow, 512);
+    TEST_CHECK(grow != NULL && ek_heap_used() == used - 32 + tlsf_block_size(grow), "realloc accounting");
+    ek_free(grow);
+
+    // 碎片化之后对比查询开销
+    clock_t start = clock();
+    for (uint32_t i = 0; i < STATS_QUERIES; i++) ek_heap_stats(&st);
+    double stats_sec = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (uint32_t i = 0; i < STATS_QUERIES; i++)
+    {
+        walked = 0;
+        tlsf_walk_pool(tlsf_get_pool(ek_default_tlsf), heap_stats_walker, &walked);
+    }
+    double walk_sec = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    EK_LOG_INFO("%u queries: ek_heap_stats %.4f s, pool walk %.4f s", STATS_QUERIES, stats_sec, walk_sec);
+
+    for (uint32_t i = 1; i < STATS_FRAGMENTS; i += 2) ek_free(frags[i]);
+    ek_heap_stats(&st);
+    TEST_CHECK(st.used == before.used, "heap stats leaked");
+
+    EK_LOG_INFO("used:%zu peak:%zu largest free:%zu allocs:%u frees:%u failed:%u",
+                st.used,
+                st.peak,
+                st.largest_free,
+                st.alloc_count,
+                st.free_count,
+                st.failed_count);
+}
@@ -0,0 +1,145 @@
+#include "test.h"
+
+EK_LOG_FILE_TAG("heap_trace_test.c")
+
+#define TRACE_LEAK_A_AMOUNT (3U)
+#define TRACE_LEAK_A_SIZE   (24U)
+#define TRACE_LEAK_B_SIZE   (100U)
+#define TRACE_FRAGMENTS     (40U)
+#define TRACE_CALLER_RANGE  (256U)
+
+#if EK_HEAP_TRACE == 1
+
+/* 两个独立的调用点，各自“泄漏”一些内存；调用都在尾部位置，-O2/-O3 下也要记录到这里 */
+__EK_NOINLINE static void *heap_trace_leak_a(void)
+{
+    return ek_malloc(TRACE_LEAK_A_SIZE);
+}
+
+__EK_NOINLINE static void *heap_trace_leak_b(void)
+{
+    return ek_malloc(TRACE_LEAK_B_SIZE);
+}
+
+__EK_NOINLINE static void *heap_trace_grow(void *ptr, size_t size)
+{
+    return ek_realloc(ptr, size);
+}
+
+__EK_NOINLINE static void *heap_trace_via_allocator(size_t size)
+{
+    return ek_allocator_realloc(NULL, NULL, 0, size);
+}
+
+/* 调用点地址落在对应函数体内：函数起始地址在所有辅助函数中离它最近 */
+static const ek_heap_trace_site_t *heap_trace_find(const ek_heap_trace_site_t *sites, uint32_t amount, void *func)
+{
+    const uintptr_t funcs[] = {
+        (uintptr_t)heap_trace_leak_a,
+        (uintptr_t)heap_trace_leak_b,
+        (uintptr_t)heap_trace_grow,
+        (uintptr_t)heap_trace_via_allocator,
+    };
+
+    for (uint32_t i = 0; i < amount; i++)
+    {
+        uintptr_t caller = (uintptr_t)sites[i].caller;
+        uintptr_t owner = 0;
+        for (uint32_t k = 0; k < EK_ARRAY_LEN(funcs); k++)
+        {
+            if (funcs[k] < caller && funcs[k] > owner) owner = funcs[k];
+        }
+        if (owner == (uintptr_t)func && caller < owner + TRACE_CALLER_RANGE) return &sites[i];
+    }
+    return NULL;
+}
+
+static void heap_trace_site_test(void)
+{
+    ek_heap_trace_site_t sites[32];
+    uint32_t live = ek_heap_trace_live();
+
+    void *leaks[TRACE_LEAK_A_AMOUNT + 1];
+    for (uint32_t i = 0; i < TRACE_LEAK_A_AMOUNT; i++) leaks[i] = heap_trace_leak_a();
+    leaks[TRACE_LEAK_A_AMOUNT] = heap_trace_leak_b();
+    TEST_CHECK(ek_heap_trace_live() == live + TRACE_LEAK_A_AMOUNT + 1, "live count after leaks");
+
+    // 按调用点分组：A 有 3 个 24 字节，B 有 1 个 100 字节，B 排在前面
+    uint32_t amount = ek_heap_trace_report(sites, EK_ARRAY_LEN(sites));
+    const ek_heap_trace_site_t *a = heap_trace_find(sites, amount, (void *)heap_trace_leak_a);
+    const ek_heap_trace_site_t *b = heap_trace_find(sites, amount, (void *)heap_trace_leak_b);
+    TEST_CHECK(a != NULL && b != NULL, "leak sites not reported");
+    TEST_CHECK(a->count == TRACE_LEAK_A_AMOUNT && a->bytes == TRACE_LEAK_A_AMOUNT * TRACE_LEAK_A_SIZE,
+               "site A totals");
+    TEST_CHECK(b->count == 1 && b->bytes == TRACE_LEAK_B_SIZE, "site B totals");
+    TEST_CHECK(b < a, "sites should be sorted by bytes");
+    for (uint32_t i = 1; i < amount; i++) TEST_CHECK(sites[i - 1].bytes >= sites[i].bytes, "sort order");
+
+    // realloc 之后记录归属到调整大小的调用点
+    leaks[0] = heap_trace_grow(leaks[0], 200);
+    amount = ek_heap_trace_report(sites, EK_ARRAY_LEN(sites));
+    a = heap_trace_find(sites, amount, (void *)heap_trace_leak_a);
+    const ek_heap_trace_site_t *g = heap_trace_find(sites, amount, (void *)heap_trace_grow);
+    TEST_CHECK(a != NULL && a->count == TRACE_LEAK_A_AMOUNT - 1, "realloc should move the record");
+    TEST_CHECK(g != NULL && g->count == 1 && g->bytes == 200, "realloc site totals");
+
+    // 经过分配器接口的分配同样记录到使用它的函数，而不是内联辅助函数
+    void *via = heap_trace_via_allocator(TRACE_LEAK_B_SIZE);
+    amount = ek_heap_trace_report(sites, EK_ARRAY_LEN(sites));
+    const ek_heap_trace_site_t *v = heap_trace_find(sites, amount, (void *)heap_trace_via_allocator);
+    TEST_CHECK(v != NULL && v->count == 1, "allocator site attributed to its user");
+    ek_allocator_free(NULL, via, TRACE_LEAK_B_SIZE);
+
+    ek_heap_dump();
+
+    // 全部释放后泄漏报告为空
+    for (uint32_t i = 0; i < EK_ARRAY_LEN(leaks); i++) ek_free(leaks[i]);
+    TEST_CHECK(ek_heap_trace_live() == live, "live count after free");
+    amount = ek_heap_trace_report(sites, EK_ARRAY_LEN(sites));
+    TEST_CHECK(heap_trace_find(sites, amount, (void *)heap_trace_leak_a) == NULL, "site A should be gone");
+    TEST_CHECK(heap_trace_find(sites, amount, (void *)heap_trace_leak_b) == NULL, "site B should be gone");
+
+    // 追踪表满时丢弃记录并计数，释放后恢复
+    uint32_t lost = ek_heap_trace_lost();
+    uint32_t extra = EK_HEAP_TRACE_DEPTH - live + 4U;
+    void **many = ek_malloc(extra * sizeof(void *));
+    for (uint32_t i = 0; i < extra; i++) many[i] = ek_malloc(8);
+    TEST_CHECK(ek_heap_trace_live() == EK_HEAP_TRACE_DEPTH, "table should be full");
+    TEST_CHECK(ek_heap_trace_lost() > lost, "lost count");
+    for (uint32_t i = 0; i < extra; i++) ek_free(many[i]);
+    ek_free(many);
+    TEST_CHECK(ek_heap_trace_live() == live, "live count after overflow");
+}
+
+#endif /* EK_HEAP_TRACE */
+
+/* 碎片直方图：隔一个释放一个，空闲块落在对应的一级分级里 */
+static void heap_frag_test(void)
+{
+    uint32_t before[32], after[32];
+    uint32_t classes = ek_heap_frag_histogram(before, EK_ARRAY_LEN(before));
+    TEST_CHECK(classes > 1 && ek_heap_frag_class_size(0) == 0, "histogram classes");
+
+    void *frags[TRACE_FRAGMENTS];
+    for (uint32_t i = 0; i < TRACE_FRAGMENTS; i++) frags[i] = ek_malloc(48);
+    size_t block = tlsf_block_size(frags[0]);
+    uint32_t cls = 0;
+    while (cls + 1 < classes && ek_heap_frag_class_size(cls + 1) <= block) cls++;
+    for (uint32_t i = 0; i < TRACE_FRAGMENTS; i += 2) ek_free(frags[i]);
+
+    ek_heap_frag_histogram(after, EK_ARRAY_LEN(after));
+    TEST_CHECK(after[cls] >= before[cls] + TRACE_FRAGMENTS / 2 - 1, "fragment class count");
+    for (uint32_t i = 1; i < TRACE_FRAGMENTS; i += 2) ek_free(frags[i]);
+}
+
+void heap_trace_test(void)
+{
+    EK_LOG_INFO("heap trace test start");
+
+#if EK_HEAP_TRACE == 1
+    heap_trace_site_test();
+#endif /* EK_HEAP_TRACE */
+    heap_frag_test();
+
+    EK_LOG_INFO("heap trace test passed");
+}
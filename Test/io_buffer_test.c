@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include "test.h"
+
+#if EK_IO_BUFFER_SIZE > 0
+
+EK_LOG_FILE_TAG("io_buffer_test.c")
+
+static bool io_capture;
+static char io_buf[4 * EK_IO_BUFFER_SIZE];
+static uint32_t io_len;
+static uint32_t io_calls;
+static const uint8_t *io_last;
+static int io_depth;
+static uint32_t io_enter_count;
+
+/* 缓冲区的写入和切换都在临界区内完成，驱动在临界区外调用 */
+void ek_io_enter_critical(void)
+{
+    io_depth++;
+    io_enter_count++;
+}
+
+void ek_io_exit_critical(void)
+{
+    io_depth--;
+}
+
+/* 假的驱动：统计调用次数，截获输出 */
+EK_IO_WRITE()
+{
+    TEST_CHECK(io_depth == 0, "driver called inside the critical section");
+    if (!io_capture)
+    {
+        fwrite(buf, 1, len, stdout);
+        return;
+    }
+    if (io_len + len < sizeof(io_buf))
+    {
+        memcpy(&io_buf[io_len], buf, len);
+        io_len += len;
+        io_buf[io_len] = '\0';
+    }
+    io_last = buf;
+    io_calls++;
+}
+
+static void io_reset(void)
+{
+    ek_io_flush();
+    io_capture = true;
+    io_len = 0;
+    io_calls = 0;
+    io_buf[0] = '\0';
+}
+
+static void io_line_test(void)
+{
+    io_reset();
+
+    // 换行之前只写缓冲区，换行时整行输出一次
+    ek_printf("hello %d", 5);
+    TEST_CHECK(io_calls == 0, "no output before the newline");
+    ek_printf(" world" CRLF);
+    TEST_CHECK(io_calls == 1 && strcmp(io_buf, "hello 5 world" CRLF) == 0, "one driver call per line");
+
+    // 显式刷新输出不完整的行，空缓冲区不调用驱动
+    ek_printf("prompt> ");
+    ek_io_flush();
+    TEST_CHECK(io_calls == 2 && strcmp(io_buf, "hello 5 world" CRLF "prompt> ") == 0, "flush a partial line");
+    ek_io_flush();
+    TEST_CHECK(io_calls == 2, "flushing an empty buffer does nothing");
+    TEST_CHECK(io_depth == 0 && io_enter_count > 0, "critical section balanced");
+}
+
+static void io_full_test(void)
+{
+    char line[3 * EK_IO_BUFFER_SIZE + 1];
+    memset(line, 'x', sizeof(line) - 1U);
+    line[sizeof(line) - 1U] = '\0';
+
+    // 没有换行的长输出在缓冲区满时分块输出，两块缓冲区轮流使用
+    io_reset();
+    ek_printf("%s", line);
+    TEST_CHECK(io_calls == 3 && io_len == 3U * EK_IO_BUFFER_SIZE, "full buffer flushed in blocks");
+    const uint8_t *prev = io_last;
+    ek_printf("y" CRLF);
+    TEST_CHECK(io_calls == 4 && io_last != prev, "buffers alternate");
+    TEST_CHECK(memcmp(prev, line, EK_IO_BUFFER_SIZE) == 0, "previous block intact until the next write");
+}
+
+static void io_ratio_test(void)
+{
+    // 一行典型的日志只调用一次驱动，逐字符输出时每个字符调用一次
+    io_reset();
+    for (int i = 0; i < 10; i++) ek_printf("[Info/io_buffer_test.c L:%d]:sensor %d value %d" CRLF, __LINE__, i, i * 37);
+    TEST_CHECK(io_calls == 10U && io_len >= 10U * io_calls, "at least 10x fewer driver calls per line");
+
+    uint32_t calls = io_calls;
+    uint32_t chars = io_len;
+    io_capture = false;
+    EK_LOG_INFO("10 lines: %u driver calls for %u chars", calls, chars);
+}
+
+void io_buffer_test(void)
+{
+    EK_LOG_INFO("io buffer test start");
+
+    io_line_test();
+    io_full_test();
+    io_ratio_test();
+
+    io_capture = false;
+    EK_LOG_INFO("io buffer test passed");
+}
+
+#else
+
+void io_buffer_test(void)
+{
+}
+
+#endif /* EK_IO_BUFFER_SIZE */
@@ -0,0 +1,170 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <time.h>
+#include "test.h"
+
+#if EK_LOG_ASYNC_ENABLE == 1
+
+EK_LOG_FILE_TAG("log_async_test.c")
+
+#define ASYNC_BENCH (100000U)
+
+typedef enum
+{
+    SINK_STDOUT = 0, /* 同步写到标准输出，其它测试使用 */
+    SINK_HOLD, /* 模拟 DMA：记录数据，测试调用 ek_log_async_done() 表示发送完成 */
+    SINK_BUSY, /* 模拟外设忙 */
+    SINK_DISCARD, /* 立即完成，不输出 */
+} sink_mode_t;
+
+static sink_mode_t sink_mode;
+static char sink_buf[8192];
+static uint32_t sink_len;
+static uint32_t sink_calls;
+
+/* 假的发送端 */
+EK_LOG_ASYNC_WRITE()
+{
+    switch (sink_mode)
+    {
+    case SINK_BUSY:
+        return false;
+    case SINK_HOLD:
+        if (sink_len + len < sizeof(sink_buf))
+        {
+            memcpy(&sink_buf[sink_len], data, len);
+            sink_len += len;
+        }
+        break;
+    case SINK_DISCARD:
+        ek_log_async_done();
+        break;
+    default:
+        fwrite(data, 1, len, stdout);
+        ek_log_async_done();
+        break;
+    }
+    sink_calls++;
+    return true;
+}
+
+static void async_reset(sink_mode_t mode)
+{
+    sink_mode = mode;
+    sink_len = 0;
+    sink_calls = 0;
+    sink_buf[0] = '\0';
+}
+
+/* 完成所有挂起的发送 */
+static void async_drain(void)
+{
+    for (uint32_t i = 0; i < 64U && ek_log_async_pending() != 0; i++) ek_log_async_done();
+    sink_buf[sink_len] = '\0';
+}
+
+static uint32_t async_lines(const char *text, const char *needle)
+{
+    uint32_t count = 0;
+    for (const char *p = strstr(text, needle); p != NULL; p = strstr(p + 1, needle)) count++;
+    return count;
+}
+
+static void async_chunk_test(void)
+{
+    async_reset(SINK_HOLD);
+
+    // 第一条立即开始发送，发送期间的日志只进入缓冲区，调用者不等待
+    EK_LOG_INFO("chunk first");
+    TEST_CHECK(sink_calls == 1 && ek_log_async_pending() == sink_len, "first record starts a transfer");
+    EK_LOG_INFO("chunk second");
+    EK_LOG_WARN("chunk third %d", 3);
+    TEST_CHECK(sink_calls == 1 && ek_log_async_pending() > sink_len, "records queue while the sink is busy");
+
+    // 发送完成后排队的日志合并成一段发送，数据跨过缓冲区末尾时多拆出一段
+    ek_log_async_done();
+    TEST_CHECK(sink_calls == 2, "queued records sent right after completion");
+    async_drain();
+    TEST_CHECK(ek_log_async_pending() == 0 && sink_calls <= 3, "queued records drained in one transfer");
+
+    const char *a = strstr(sink_buf, "chunk first");
+    const char *b = strstr(sink_buf, "chunk second");
+    const char *c = strstr(sink_buf, "chunk third 3");
+    TEST_CHECK(a != NULL && b > a && c > b && strstr(sink_buf, "[Warn/log_async_test.c") != NULL,
+               "records intact and in order");
+}
+
+static void async_overflow_test(void)
+{
+    uint32_t warn = ek_log_dropped(EK_LOG_TYPE_WARN);
+    uint32_t error = ek_log_dropped(EK_LOG_TYPE_ERROR);
+    uint32_t n = EK_LOG_ASYNC_SIZE / 32U;
+
+    // 发送端一直不完成，缓冲区写满后 WARN 日志被丢弃，只计入 WARN
+    async_reset(SINK_HOLD);
+    for (uint32_t i = 0; i < n; i++) EK_LOG_WARN("overflow %04u", i);
+    uint32_t dropped = ek_log_dropped(EK_LOG_TYPE_WARN) - warn;
+    TEST_CHECK(dropped > 0 && dropped < n, "full ring drops records");
+    TEST_CHECK(ek_log_dropped(EK_LOG_TYPE_ERROR) == error, "drops counted per level");
+    TEST_CHECK(ek_log_async_pending() <= EK_RINGBUF_SPSC_SLOTS(EK_LOG_ASYNC_SIZE), "ring bounded");
+
+    // 已写入的日志都是完整的行，截断策略下最多多出一条被截断但仍以换行结尾的日志
+    async_drain();
+    uint32_t kept = async_lines(sink_buf, "overflow ");
+    uint32_t lines = async_lines(sink_buf, CRLF);
+#if EK_LOG_OVERFLOW_POLICY == EK_LOG_OVERFLOW_TRUNCATE
+    TEST_CHECK(lines >= n - dropped && lines <= n - dropped + 1U && kept >= n - dropped, "truncated record ends a line");
+#else
+    TEST_CHECK(kept == n - dropped && lines == kept, "only whole records kept");
+#endif
+}
+
+static void async_busy_test(void)
+{
+    // 外设忙时数据留在缓冲区，之后由 poll 重新发送
+    async_reset(SINK_BUSY);
+    EK_LOG_INFO("busy sink");
+    TEST_CHECK(sink_calls == 0 && ek_log_async_pending() != 0, "record kept while the sink is busy");
+
+    sink_mode = SINK_HOLD;
+    ek_log_async_poll();
+    TEST_CHECK(sink_calls == 1 && strstr(sink_buf, "busy sink") != NULL, "poll restarts the transfer");
+    async_drain();
+}
+
+static void async_bench(void)
+{
+    struct timespec t0, t1;
+
+    async_reset(SINK_DISCARD);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t i = 0; i < ASYNC_BENCH; i++) EK_LOG_INFO("bench %u value %d", i, -(int)i);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    TEST_CHECK(sink_calls <= ASYNC_BENCH * 2U && ek_log_async_pending() == 0, "bench drained");
+
+    uint64_t ns = (uint64_t)(t1.tv_sec - t0.tv_sec) * 1000000000ULL + (uint64_t)(t1.tv_nsec - t0.tv_nsec);
+    async_reset(SINK_STDOUT);
+    EK_LOG_INFO("%u async records: %.1f ns per call", ASYNC_BENCH, (double)ns / ASYNC_BENCH);
+}
+
+void log_async_test(void)
+{
+    EK_LOG_INFO("log async test start");
+
+    async_chunk_test();
+    async_overflow_test();
+    async_busy_test();
+    async_bench();
+
+    async_reset(SINK_STDOUT);
+    EK_LOG_INFO("log async test passed");
+}
+
+#else
+
+void log_async_test(void)
+{
+}
+
+#endif /* EK_LOG_ASYNC_ENABLE */
@@ -0,0 +1,159 @@
+#define EK_LOG_DEFER_ENABLE 1
+
+#include "test.h"
+
+EK_LOG_FILE_TAG("log_defer_test.c")
+
+static uint8_t defer_buf[4096];
+static uint32_t defer_len;
+
+extern const char __start_ek_log_fmt[];
+
+/* 截获编码好的帧 */
+EK_LOG_DEFER_WRITE()
+{
+    if (defer_len + len > sizeof(defer_buf)) return;
+    memcpy(&defer_buf[defer_len], data, len);
+    defer_len += len;
+}
+
+static uint32_t defer_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* 第 index 帧的起始位置 */
+static const uint8_t *defer_frame(uint32_t index)
+{
+    uint32_t pos = 0;
+    for (uint32_t i = 0; i < index; i++) pos += 2U + defer_buf[pos + 1U];
+    TEST_CHECK(pos < defer_len && defer_buf[pos] == 0xA5, "frame sync");
+    return &defer_buf[pos];
+}
+
+/* 帧对应的格式描述串 "级别\x1f行号\x1f文件\x1f格式串" 中的格式串 */
+static const char *defer_fmt(const uint8_t *frame, char *level)
+{
+    const char *desc = __start_ek_log_fmt + defer_u32(&frame[2]);
+    *level = desc[0];
+    for (uint32_t i = 0; i < 3; i++) desc = strchr(desc, '\x1f') + 1;
+    return desc;
+}
+
+static void defer_encode_test(void)
+{
+    char level;
+    uint64_t u64;
+    double f64;
+
+    defer_len = 0;
+    EK_LOG_INFO("plain");
+    EK_LOG_WARN("int %d unsigned %u hex 0x%08x", -5, 42U, 0xBEEFU);
+    EK_LOG_ERROR("str %s char %c", "hello", 'x');
+    EK_LOG_DEBUG("f=%.3f ll=%lld", 3.14159, -123456789012LL);
+    EK_LOG("long %s tail %d", "0123456789abcdefghijklmnopqrstuvwxyz", 7);
+    TEST_CHECK(ek_log_defer_flush() == 5 && ek_log_defer_dropped() == 0, "all records flushed");
+
+    const uint8_t *f = defer_frame(0);
+    TEST_CHECK(strcmp(defer_fmt(f, &level), "plain") == 0 && level == 'I', "format id resolves");
+    TEST_CHECK(f[1] == 11 && f[12] == 0, "no arguments");
+
+    f = defer_frame(1);
+    TEST_CHECK(strcmp(defer_fmt(f, &level), "int %d unsigned %u hex 0x%08x") == 0 && level == 'W', "warn record");
+    TEST_CHECK(f[12] == 3 && f[10] == 0 && f[11] == 0, "three 32-bit arguments");
+    TEST_CHECK((int32_t)defer_u32(&f[13]) == -5 && defer_u32(&f[17]) == 42U && defer_u32(&f[21]) == 0xBEEFU,
+               "integer values");
+
+    f = defer_frame(2);
+    defer_fmt(f, &level);
+    TEST_CHECK(level == 'E' && f[12] == 2 && (f[10] & 0x0F) == EK_LOG_ARG_STR, "string then char");
+    TEST_CHECK(f[13] == 5 && memcmp(&f[14], "hello", 5) == 0 && defer_u32(&f[21]) == 'x', "string copied inline");
+
+    f = defer_frame(3);
+    defer_fmt(f, &level);
+    TEST_CHECK(level == 'D' && f[10] == (EK_LOG_ARG_F64 | (EK_LOG_ARG_U64 << 2)), "double and long long types");
+    memcpy(&f64, &f[13], sizeof(f64));
+    memcpy(&u64, &f[21], sizeof(u64));
+    TEST_CHECK(f64 == 3.14159 && (int64_t)u64 == -123456789012LL, "64-bit values");
+
+    // 参数区只有 EK_LOG_DEFER_WORDS 个字，字符串被截断到剩余空间，之后的参数不保存
+    f = defer_frame(4);
+    defer_fmt(f, &level);
+    TEST_CHECK(level == 'N' && f[12] == 1 && f[13] == EK_LOG_DEFER_WORDS * 4U - 1U, "long string truncated");
+    TEST_CHECK(f[1] == 11U + EK_LOG_DEFER_WORDS * 4U, "record fills the argument area");
+
+    ek_printf("log defer: 5 records encoded in %u bytes" CRLF, (unsigned)defer_len);
+}
+
+/* 任意类型的指针按平台指针宽度保存，不会落到 32 位整数；枚举和窄整数仍保存为 32 位 */
+static void defer_pointer_test(void)
+{
+    static int value;
+    static uint8_t bytes[4];
+    enum { DEFER_ENUM = 7 } e = DEFER_ENUM;
+    uint8_t small = 200;
+    const uint8_t ptr_type = (sizeof(void *) > sizeof(uint32_t)) ? EK_LOG_ARG_U64 : EK_LOG_ARG_U32;
+    const uint32_t ptr_size = (uint32_t)sizeof(void *);
+    uint64_t a = 0, b = 0;
+
+    defer_len = 0;
+    EK_LOG_INFO("int %p bytes %p", &value, bytes);
+    EK_LOG_INFO("enum %d u8 %u", e, small);
+    TEST_CHECK(ek_log_defer_flush() == 2, "pointer records flushed");
+
+    const uint8_t *f = defer_frame(0);
+    TEST_CHECK(f[12] == 2 && f[10] == (ptr_type | (ptr_type << 2)), "typed pointers stored at pointer width");
+    memcpy(&a, &f[13], ptr_size);
+    memcpy(&b, &f[13 + ptr_size], ptr_size);
+    TEST_CHECK(a == (uint64_t)(uintptr_t)&value && b == (uint64_t)(uintptr_t)bytes, "pointer values");
+
+    f = defer_frame(1);
+    TEST_CHECK(f[12] == 2 && f[10] == 0 && defer_u32(&f[13]) == DEFER_ENUM && defer_u32(&f[17]) == 200U,
+               "enum and uint8_t stay 32-bit");
+}
+
+#if EK_LOG_PERSIST_ENABLE == 1
+static void defer_persist_test(void)
+{
+    uint8_t saved[64];
+
+    // 帧在记录时就写入持久化区域，与之后输出的帧逐字节相同
+    ek_log_persist_init();
+    ek_log_persist_clear();
+    defer_len = 0;
+    EK_LOG_WARN("persist %d %s", 7, "abc");
+    uint32_t used = ek_log_persist_used();
+    TEST_CHECK(ek_log_defer_flush() == 1 && used == defer_len, "frame persisted when logged");
+    TEST_CHECK(ek_log_persist_read(0, saved, sizeof(saved)) == used && memcmp(saved, defer_buf, used) == 0,
+               "persisted frame matches");
+}
+#endif /* EK_LOG_PERSIST_ENABLE == 1 */
+
+static void defer_overflow_test(void)
+{
+    uint32_t dropped = ek_log_defer_dropped();
+
+    // 队列满后新记录被丢弃并计数，已入队的记录不受影响
+    for (uint32_t i = 0; i < EK_LOG_DEFER_DEPTH + 3U; i++) EK_LOG_INFO("seq %u", i);
+    TEST_CHECK(ek_log_defer_dropped() - dropped == 3U, "overflow counted");
+
+    defer_len = 0;
+    TEST_CHECK(ek_log_defer_flush() == EK_LOG_DEFER_DEPTH, "full queue flushed");
+    TEST_CHECK(defer_u32(&defer_frame(EK_LOG_DEFER_DEPTH - 1U)[13]) == EK_LOG_DEFER_DEPTH - 1U, "oldest records kept");
+    TEST_CHECK(ek_log_defer_flush() == 0, "queue empty");
+}
+
+void log_defer_test(void)
+{
+    ek_printf("log defer test start" CRLF);
+
+    ek_log_defer_init();
+    defer_encode_test();
+    defer_pointer_test();
+    defer_overflow_test();
+#if EK_LOG_PERSIST_ENABLE == 1
+    defer_persist_test();
+#endif /* EK_LOG_PERSIST_ENABLE == 1 */
+
+    ek_printf("log defer test passed" CRLF);
+}
@@ -0,0 +1,72 @@
+#define EK_LOG_LEVEL EK_LOG_LEVEL_WARN
+
+#include "test.h"
+
+EK_LOG_FILE_TAG("log_level_test.c")
+
+static uint32_t level_evals;
+
+/* 统计日志参数被求值的次数 */
+static int level_arg(void)
+{
+    level_evals++;
+    return (int)level_evals;
+}
+
+static void level_compile_test(void)
+{
+    // 低于编译期级别的日志整条删除，参数不求值
+    level_evals = 0;
+    EK_LOG_DEBUG("debug %d", level_arg());
+    EK_LOG_INFO("info %d", level_arg());
+    TEST_CHECK(level_evals == 0, "calls below EK_LOG_LEVEL compiled out");
+
+    EK_LOG_WARN("compile level warn %d", level_arg());
+    EK_LOG_ERROR("compile level error %d", level_arg());
+    TEST_CHECK(level_evals == 2, "calls at or above EK_LOG_LEVEL kept");
+}
+
+#if EK_LOG_TAG_LEVEL_ENABLE == 1
+static void level_runtime_test(void)
+{
+    TEST_CHECK(ek_log_get_level("log_level_test.c") == EK_LOG_TYPE_WARN, "tag starts at the file's EK_LOG_LEVEL");
+    TEST_CHECK(ek_log_get_level("main.c") == EK_LOG_TYPE_DEBUG, "other files keep their own level");
+    TEST_CHECK(ek_log_get_level("no_such_tag") == EK_LOG_TYPE_NONE, "unknown tag");
+
+    // 运行时级别在求值参数之前检查
+    level_evals = 0;
+    TEST_CHECK(ek_log_set_level("log_level_test.c", EK_LOG_TYPE_ERROR) == 1, "set one tag");
+    EK_LOG_WARN("runtime warn %d", level_arg());
+    TEST_CHECK(level_evals == 0, "filtered call does not evaluate its arguments");
+    EK_LOG_ERROR("runtime level error %d", level_arg());
+    TEST_CHECK(level_evals == 1, "call at the runtime level passes");
+
+    TEST_CHECK(ek_log_set_level("log_level_test.c", EK_LOG_TYPE_MAX) == 1, "turn a tag off");
+    EK_LOG_ERROR("off %d", level_arg());
+    TEST_CHECK(level_evals == 1, "tag turned off");
+
+    // 运行时只能放宽到编译期级别
+    TEST_CHECK(ek_log_set_level("log_level_test.c", EK_LOG_TYPE_DEBUG) == 1, "lower the runtime level");
+    EK_LOG_INFO("info %d", level_arg());
+    TEST_CHECK(level_evals == 1, "compiled-out calls stay out");
+
+    // "*" 修改所有标签，同名标签一起修改
+    uint32_t tags = ek_log_set_level("*", EK_LOG_TYPE_ERROR);
+    TEST_CHECK(tags > 1 && ek_log_get_level("main.c") == EK_LOG_TYPE_ERROR, "set all tags");
+    TEST_CHECK(ek_log_set_level(NULL, EK_LOG_TYPE_DEBUG) == tags, "NULL matches all tags");
+    TEST_CHECK(ek_log_set_level("no_such_tag", EK_LOG_TYPE_INFO) == 0, "unknown tag not set");
+}
+#endif /* EK_LOG_TAG_LEVEL_ENABLE == 1 */
+
+void log_level_test(void)
+{
+    ek_printf("log level test start" CRLF);
+
+    level_compile_test();
+#if EK_LOG_TAG_LEVEL_ENABLE == 1
+    level_runtime_test();
+    ek_log_level_dump();
+#endif /* EK_LOG_TAG_LEVEL_ENABLE == 1 */
+
+    ek_printf("log level test passed" CRLF);
+}
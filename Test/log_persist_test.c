@@ -0,0 +1,102 @@
+#include "test.h"
+
+#if EK_LOG_PERSIST_ENABLE == 1
+
+EK_LOG_FILE_TAG("log_persist_test.c")
+
+// 持久化区域，测试中直接改写它来模拟上电和损坏
+extern ek_log_persist_t _ek_log_persist;
+
+static char persist_text[EK_LOG_PERSIST_SIZE + 1];
+
+/* 读出整个区域，从旧到新 */
+static const char *persist_read(void)
+{
+    uint32_t len = ek_log_persist_read(0, (uint8_t *)persist_text, EK_LOG_PERSIST_SIZE);
+    persist_text[len] = '\0';
+    return persist_text;
+}
+
+static void persist_reset_test(void)
+{
+    // 上电时 RAM 内容随机，打开后清空
+    memset(&_ek_log_persist, 0x5A, sizeof(_ek_log_persist));
+    TEST_CHECK(!ek_log_persist_init() && ek_log_persist_used() == 0, "random region cleared");
+
+    EK_LOG_ERROR("before reset %d", 1);
+    EK_LOG_WARN("before reset %d", 2);
+    uint32_t used = ek_log_persist_used();
+    TEST_CHECK(used > 0 && strstr(persist_read(), "before reset 2") != NULL, "records copied on write");
+
+    // 模拟热复位：区域原样保留，重新打开
+    TEST_CHECK(ek_log_persist_init(), "region survives a warm reset");
+    TEST_CHECK(ek_log_persist_used() == used && ek_log_persist_resets() == 1, "content and reset count kept");
+
+    EK_LOG_INFO("after reset");
+    const char *a = strstr(persist_read(), "before reset 1");
+    const char *b = strstr(persist_text, "before reset 2");
+    const char *c = strstr(persist_text, "after reset");
+    TEST_CHECK(a != NULL && b > a && c > b, "new records appended after the old ones");
+
+    TEST_CHECK(ek_log_persist_init() && ek_log_persist_resets() == 2, "second reset");
+}
+
+static void persist_corrupt_test(void)
+{
+    // 头部任何一个字段被破坏都视为无效
+    EK_LOG_INFO("corrupt");
+    _ek_log_persist.resets ^= 1U;
+    TEST_CHECK(!ek_log_persist_init() && ek_log_persist_used() == 0, "crc mismatch clears the region");
+
+    EK_LOG_INFO("corrupt");
+    _ek_log_persist.head ^= 4U;
+    TEST_CHECK(!ek_log_persist_init() && ek_log_persist_used() == 0, "torn head update detected");
+
+    EK_LOG_INFO("corrupt");
+    _ek_log_persist.head = EK_LOG_PERSIST_SIZE;
+    _ek_log_persist.head_inv = ~(uint32_t)EK_LOG_PERSIST_SIZE;
+    TEST_CHECK(!ek_log_persist_init(), "head out of range");
+}
+
+static void persist_wrap_test(void)
+{
+    uint32_t n = EK_LOG_PERSIST_SIZE / 16U;
+
+    // 写满后覆盖最旧的日志，区域中始终是最近的内容
+    ek_log_persist_clear();
+    for (uint32_t i = 0; i < n; i++) EK_LOG_INFO("wrap %04u", i);
+    TEST_CHECK(ek_log_persist_used() == EK_LOG_PERSIST_SIZE, "region full");
+
+    char last[16];
+    ek_snprintf(last, sizeof(last), "wrap %04u", n - 1U);
+    TEST_CHECK(strstr(persist_read(), "wrap 0000") == NULL, "oldest record overwritten");
+    TEST_CHECK(strstr(persist_text, last) != NULL, "newest record kept");
+
+    // 分段读取与一次读取的结果相同
+    char part[EK_LOG_PERSIST_SIZE];
+    uint32_t off = 0;
+    for (uint32_t len; (len = ek_log_persist_read(off, (uint8_t *)&part[off], 100)) != 0;) off += len;
+    TEST_CHECK(off == EK_LOG_PERSIST_SIZE && memcmp(part, persist_text, off) == 0, "chunked read");
+    TEST_CHECK(ek_log_persist_read(EK_LOG_PERSIST_SIZE, (uint8_t *)part, 1) == 0, "read past the end");
+}
+
+void log_persist_test(void)
+{
+    ek_printf("log persist test start" CRLF);
+
+    persist_reset_test();
+    persist_corrupt_test();
+    persist_wrap_test();
+
+    ek_printf("log persist: %u bytes kept, %u resets" CRLF, (unsigned)ek_log_persist_used(),
+              (unsigned)ek_log_persist_resets());
+    ek_printf("log persist test passed" CRLF);
+}
+
+#else
+
+void log_persist_test(void)
+{
+}
+
+#endif /* EK_LOG_PERSIST_ENABLE */
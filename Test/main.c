@@ -30,7 +30,32 @@ int main(void)
     EK_LOG_INFO("heap init ok use:%u,unused:%u", ek_heap_used(), ek_heap_unused());
     stack_test();
     ringbuf_test();
+    ringbuf_bench();
+    ringbuf_stress_test();
+    ringbuf_mpmc_bench();
     vec_test();
+    static_test();
+    mempool_test();
+    heap_region_test();
+    heap_stats_test();
+    heap_trace_test();
+    arena_test();
+    heap_mt_test();
+    evoke_defer_bench();
+    evoke_queue_test();
+    evoke_prio_test();
+    evoke_co_test();
+    evoke_stats_test();
+    evoke_wait_test();
+    evoke_tick_test();
+    evoke_timer_test();
+    evoke_call_test();
+    evoke_port_test();
+    log_defer_test();
+    log_async_test();
+    log_level_test();
+    io_buffer_test();
+    log_persist_test();
     str_test();
 
     return 0;
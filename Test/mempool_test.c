@@ -0,0 +1,105 @@
+#define _XOPEN_SOURCE 700
+
+#include <pthread.h>
+#include "test.h"
+
+EK_LOG_FILE_TAG("mempool_test.c")
+
+EK_MEMPOOL_DEFINE(test_pool, student_t, 4);
+
+static int critical_depth;
+static uint32_t critical_count;
+
+/* 主机上用递归互斥锁模拟关中断，EK_HEAP_THREAD_SAFE 下的堆也走这对钩子，钩子要求可以嵌套 */
+static pthread_mutex_t critical_lock;
+static pthread_once_t critical_once = PTHREAD_ONCE_INIT;
+
+static void critical_lock_init(void)
+{
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&critical_lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+void ek_mem_enter_critical(void)
+{
+    pthread_once(&critical_once, critical_lock_init);
+    pthread_mutex_lock(&critical_lock);
+    critical_depth++;
+    critical_count++;
+}
+
+void ek_mem_exit_critical(void)
+{
+    critical_depth--;
+    pthread_mutex_unlock(&critical_lock);
+}
+
+void mempool_test(void)
+{
+    EK_LOG_INFO("mempool test start");
+
+    student_t *blocks[5];
+    size_t heap_used = ek_heap_used();
+
+    // 静态池：耗尽后返回 NULL
+    for (int i = 0; i < 5; i++)
+    {
+        blocks[i] = ek_mempool_alloc(&test_pool);
+        TEST_CHECK((blocks[i] != NULL) == (i < 4), "static pool alloc");
+        if (blocks[i]) blocks[i]->name = (uint8_t)i;
+    }
+    TEST_CHECK(ek_mempool_used(&test_pool) == 4 && ek_mempool_unused(&test_pool) == 0, "static pool usage");
+    TEST_CHECK(ek_heap_used() == heap_used, "static pool touched the heap");
+
+    // 后进先出复用，高水位保持不变
+    ek_mempool_free(&test_pool, blocks[1]);
+    ek_mempool_free(&test_pool, blocks[2]);
+    TEST_CHECK(ek_mempool_alloc(&test_pool) == blocks[2], "free list reuse");
+    TEST_CHECK(ek_mempool_peak(&test_pool) == 4 && ek_mempool_used(&test_pool) == 3, "static pool peak");
+    TEST_CHECK(blocks[0]->name == 0 && blocks[3]->name == 3, "neighbour blocks corrupted");
+
+    // 地址归属判断，用于池耗尽后回退到堆
+    student_t outsider;
+    TEST_CHECK(ek_mempool_contains(&test_pool, blocks[3]), "contains pool block");
+    TEST_CHECK(!ek_mempool_contains(&test_pool, &outsider), "contains foreign block");
+
+    // 从堆中切出的池只占一次分配
+    ek_mempool_t *heap_pool = ek_mempool_create(3, 16);
+    TEST_CHECK(heap_pool != NULL, "creating heap pool");
+    TEST_CHECK(heap_pool->block_size == sizeof(void *), "block size rounding");
+    void *first = ek_mempool_alloc(heap_pool);
+    void *second = ek_mempool_alloc(heap_pool);
+    TEST_CHECK((uint8_t *)second - (uint8_t *)first == (ptrdiff_t)sizeof(void *), "blocks are packed");
+    ek_mempool_free(heap_pool, first);
+    ek_mempool_free(heap_pool, second);
+    TEST_CHECK(ek_mempool_used(heap_pool) == 0 && ek_mempool_peak(heap_pool) == 2, "heap pool usage");
+    ek_mempool_destroy(heap_pool);
+    TEST_CHECK(ek_heap_used() == heap_used, "heap pool leaked");
+
+    // 每次分配/释放都在临界区内完成
+    TEST_CHECK(critical_depth == 0 && critical_count > 0, "critical section unbalanced");
+
+    // 调用者已在临界区内时再分配/释放，钩子需要支持嵌套
+    ek_mem_enter_critical();
+    void *nested = ek_mempool_alloc(&test_pool);
+    TEST_CHECK(nested != NULL && critical_depth == 1, "nested critical section");
+    ek_mempool_free(&test_pool, nested);
+    ek_mem_exit_critical();
+
+#if EK_STR_USE_MEMPOOL == 1
+    // 字符串头来自内存块池，超出池容量后回退到堆
+    ek_str_t *strs[EK_STR_POOL_SIZE + 2];
+    for (uint32_t i = 0; i < EK_ARRAY_LEN(strs); i++)
+    {
+        strs[i] = ek_str_create(NULL);
+        TEST_CHECK(strs[i] != NULL, "creating str");
+    }
+    for (uint32_t i = 0; i < EK_ARRAY_LEN(strs); i++) ek_str_free(strs[i]);
+    TEST_CHECK(ek_heap_used() == heap_used, "str headers leaked");
+#endif /* EK_STR_USE_MEMPOOL */
+
+    EK_LOG_INFO("mempool test passed, critical sections:%u", critical_count);
+}
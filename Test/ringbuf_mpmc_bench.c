@@ -0,0 +1,185 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "test.h"
+
+EK_LOG_FILE_TAG("ringbuf_mpmc_bench.c")
+
+#define MPMC_PRODUCERS (4U)
+#define MPMC_CONSUMERS (4U)
+#define MPMC_ATTEMPTS  (200000U)
+#define MPMC_RB_ITEMS  (1024U)
+#define MPMC_BURST     (64U)
+
+typedef struct
+{
+    bool (*write)(const void *item);
+    bool (*read)(void *item);
+    uint32_t producers_done;
+    uint32_t pushed;
+    uint32_t dropped;
+    uint32_t popped;
+    uint64_t push_sum;
+    uint64_t pop_sum;
+} mpmc_bench_t;
+
+static mpmc_bench_t bench;
+static ek_ringbuf_mpmc_t *mpmc_rb;
+static ek_ringbuf_t *locked_rb;
+static bool locked_flag;
+
+static bool mpmc_write(const void *item)
+{
+    return ek_ringbuf_write_mpmc(mpmc_rb, item);
+}
+
+static bool mpmc_read(void *item)
+{
+    return ek_ringbuf_read_mpmc(mpmc_rb, item);
+}
+
+/*
+ * 模拟 EK_USE_RTOS == 1 时 ek_ringbuf_t 的行为：锁被占用时直接返回 false。
+ * 这里用原子交换实现试锁，已经是该方案的最好情况（原实现的测试-置位本身还有竞争窗口）
+ */
+static bool locked_write(const void *item)
+{
+    if (__atomic_exchange_n(&locked_flag, true, __ATOMIC_ACQUIRE)) return false;
+    bool ret = ek_ringbuf_write(locked_rb, item);
+    __atomic_store_n(&locked_flag, false, __ATOMIC_RELEASE);
+    return ret;
+}
+
+static bool locked_read(void *item)
+{
+    if (__atomic_exchange_n(&locked_flag, true, __ATOMIC_ACQUIRE)) return false;
+    bool ret = ek_ringbuf_read(locked_rb, item);
+    __atomic_store_n(&locked_flag, false, __ATOMIC_RELEASE);
+    return ret;
+}
+
+static void *bench_producer(void *arg)
+{
+    uint32_t id = (uint32_t)(uintptr_t)arg;
+    uint32_t pushed = 0, dropped = 0;
+    uint64_t sum = 0;
+
+    // 每个事件只尝试一次，失败即视为丢失，模拟中断里的投递；按突发批次让出 CPU 给消费者
+    for (uint32_t i = 0; i < MPMC_ATTEMPTS; i++)
+    {
+        if (i % MPMC_BURST == 0) sched_yield();
+
+        uint32_t val = (id << 24) | i;
+        if (bench.write(&val))
+        {
+            pushed++;
+            sum += val;
+        }
+        else
+        {
+            dropped++;
+        }
+    }
+
+    __atomic_fetch_add(&bench.pushed, pushed, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&bench.dropped, dropped, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&bench.push_sum, sum, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&bench.producers_done, 1U, __ATOMIC_RELEASE);
+
+    return NULL;
+}
+
+static void *bench_consumer(void *arg)
+{
+    __EK_UNUSED(arg);
+
+    uint32_t popped = 0;
+    uint64_t sum = 0;
+
+    while (1)
+    {
+        uint32_t val;
+        if (bench.read(&val))
+        {
+            popped++;
+            sum += val;
+            continue;
+        }
+
+        // 生产者全部结束后再确认一次，避免漏掉最后的数据
+        if (__atomic_load_n(&bench.producers_done, __ATOMIC_ACQUIRE) == MPMC_PRODUCERS)
+        {
+            if (!bench.read(&val)) break;
+            popped++;
+            sum += val;
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    __atomic_fetch_add(&bench.popped, popped, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&bench.pop_sum, sum, __ATOMIC_RELAXED);
+
+    return NULL;
+}
+
+static void bench_run(const char *name, bool (*write)(const void *), bool (*read)(void *))
+{
+    pthread_t producers[MPMC_PRODUCERS], consumers[MPMC_CONSUMERS];
+    struct timespec start, end;
+
+    memset(&bench, 0, sizeof(bench));
+    bench.write = write;
+    bench.read = read;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < MPMC_CONSUMERS; i++) pthread_create(&consumers[i], NULL, bench_consumer, NULL);
+    for (uint32_t i = 0; i < MPMC_PRODUCERS; i++)
+        pthread_create(&producers[i], NULL, bench_producer, (void *)(uintptr_t)i);
+    for (uint32_t i = 0; i < MPMC_PRODUCERS; i++) pthread_join(producers[i], NULL);
+    for (uint32_t i = 0; i < MPMC_CONSUMERS; i++) pthread_join(consumers[i], NULL);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (bench.popped != bench.pushed || bench.pop_sum != bench.push_sum)
+    {
+        EK_LOG_ERROR("%s: lost items, pushed:%u popped:%u", name, bench.pushed, bench.popped);
+        exit(1);
+    }
+
+    double sec = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    uint32_t attempts = MPMC_PRODUCERS * MPMC_ATTEMPTS;
+
+    EK_LOG_INFO("%-7s %uP/%uC %.2f Mops/s, drop rate %.2f%% (%u/%u)",
+                name,
+                MPMC_PRODUCERS,
+                MPMC_CONSUMERS,
+                (sec > 0.0) ? ((bench.pushed + bench.popped) / sec / 1e6) : 0.0,
+                100.0 * bench.dropped / attempts,
+                bench.dropped,
+                attempts);
+}
+
+void ringbuf_mpmc_bench(void)
+{
+    EK_LOG_INFO("mpmc benchmark start");
+
+    mpmc_rb = ek_ringbuf_create_mpmc(sizeof(uint32_t), MPMC_RB_ITEMS);
+    locked_rb = ek_ringbuf_create(sizeof(uint32_t), MPMC_RB_ITEMS);
+    if (mpmc_rb == NULL || locked_rb == NULL)
+    {
+        EK_LOG_ERROR("creating rb fail");
+        exit(1);
+    }
+
+    bench_run("mpmc", mpmc_write, mpmc_read);
+    bench_run("locked", locked_write, locked_read);
+
+    ek_ringbuf_destroy_mpmc(mpmc_rb);
+    ek_ringbuf_destroy(locked_rb);
+
+    EK_LOG_INFO("benchmark finished.mem remain:%zu", ek_heap_unused());
+}
@@ -0,0 +1,117 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <sched.h>
+#include "test.h"
+
+EK_LOG_FILE_TAG("ringbuf_stress.c")
+
+#define STRESS_RB_SLOTS (64U)
+#define STRESS_ITEMS    (1U << 21)
+#define STRESS_BATCH    (17U)
+
+static ek_ringbuf_spsc_t *stress_rb;
+
+static void *stress_producer(void *arg)
+{
+    __EK_UNUSED(arg);
+
+    uint32_t seq = 0;
+    uint32_t batch[STRESS_BATCH];
+
+    while (seq < STRESS_ITEMS)
+    {
+        uint32_t n;
+
+        // 交替使用单个写入和批量写入
+        if (seq & 0x100U)
+        {
+            n = (STRESS_ITEMS - seq < STRESS_BATCH) ? (STRESS_ITEMS - seq) : STRESS_BATCH;
+            for (uint32_t i = 0; i < n; i++) batch[i] = seq + i;
+            n = ek_ringbuf_write_bulk_spsc(stress_rb, batch, n);
+        }
+        else
+        {
+            n = ek_ringbuf_write_spsc(stress_rb, &seq) ? 1U : 0U;
+        }
+
+        if (n == 0U) sched_yield();
+        seq += n;
+    }
+
+    return NULL;
+}
+
+static void *stress_consumer(void *arg)
+{
+    uint32_t *errors = arg;
+    uint32_t expect = 0;
+    uint32_t batch[STRESS_BATCH];
+    ek_ringbuf_span_t span[2];
+
+    while (expect < STRESS_ITEMS)
+    {
+        uint32_t n = 0;
+
+        // 轮流使用单个读取、批量读取、零拷贝读取
+        switch (expect % 3U)
+        {
+        case 0:
+            if (ek_ringbuf_read_spsc(stress_rb, &batch[0])) n = 1U;
+            break;
+        case 1:
+            n = ek_ringbuf_read_bulk_spsc(stress_rb, batch, STRESS_BATCH);
+            break;
+        default:
+            n = ek_ringbuf_acquire_read_spsc(stress_rb, span, STRESS_BATCH);
+            memcpy(batch, span[0].buf, span[0].amount * sizeof(uint32_t));
+            if (span[1].amount) memcpy(&batch[span[0].amount], span[1].buf, span[1].amount * sizeof(uint32_t));
+            ek_ringbuf_release_read_spsc(stress_rb, n);
+            break;
+        }
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+            if (batch[i] != expect + i) (*errors)++;
+        }
+
+        if (n == 0U) sched_yield();
+        expect += n;
+    }
+
+    return NULL;
+}
+
+void ringbuf_stress_test(void)
+{
+    EK_LOG_INFO("spsc stress test start");
+
+    stress_rb = ek_ringbuf_create_spsc(sizeof(uint32_t), STRESS_RB_SLOTS);
+    if (stress_rb == NULL)
+    {
+        EK_LOG_ERROR("creating rb fail");
+        exit(1);
+    }
+
+#if EK_RINGBUF_SPSC_POW2 == 1
+    // 让自由增长的索引在测试过程中跨过 32 位回绕点
+    stress_rb->write_idx = 0xFFFFF000U;
+    stress_rb->read_idx = 0xFFFFF000U;
+#endif /* EK_RINGBUF_SPSC_POW2 */
+
+    uint32_t errors = 0;
+    pthread_t producer, consumer;
+    pthread_create(&consumer, NULL, stress_consumer, &errors);
+    pthread_create(&producer, NULL, stress_producer, NULL);
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+
+    if (errors != 0U || !ek_ringbuf_empty_spsc(stress_rb))
+    {
+        EK_LOG_ERROR("stress test fail, errors:%u", errors);
+        exit(1);
+    }
+
+    ek_ringbuf_destroy_spsc(stress_rb);
+    EK_LOG_INFO("%u items passed through %u slots in order", STRESS_ITEMS, STRESS_RB_SLOTS);
+}
@@ -0,0 +1,86 @@
+#include "test.h"
+
+EK_LOG_FILE_TAG("static_test.c")
+
+EK_VEC_IMPLEMENT(int);
+
+EK_RINGBUF_STATIC_DEFINE(static_rb, student_t, 4);
+EK_RINGBUF_SPSC_STATIC_DEFINE(static_spsc, uint16_t, 6);
+EK_STACK_STATIC_DEFINE(static_sk, student_t, 3);
+EK_VEC_STATIC_DEFINE(static_vec, int, 5);
+
+static uint32_t mpmc_storage[8 * EK_RINGBUF_MPMC_SLOT_SIZE(sizeof(uint16_t)) / sizeof(uint32_t)];
+
+void static_test(void)
+{
+    EK_LOG_INFO("static container test start");
+
+    size_t heap_used = ek_heap_used();
+    student_t stu = { 0 };
+
+    // 普通环形缓冲区
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        stu.name = i;
+        TEST_CHECK(ek_ringbuf_write(&static_rb, &stu) == (i < 4), "static rb write");
+    }
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        TEST_CHECK(ek_ringbuf_read(&static_rb, &stu) && stu.name == i, "static rb read");
+    }
+    TEST_CHECK(ek_ringbuf_empty(&static_rb), "static rb empty");
+
+    // SPSC：槽位数与 ek_ringbuf_create_spsc() 的规则一致
+    uint32_t spsc_cap = ek_ringbuf_space_spsc(&static_spsc);
+    TEST_CHECK(spsc_cap == ((EK_RINGBUF_SPSC_POW2 == 1) ? 8U : 5U), "static spsc capacity");
+    for (uint16_t i = 0; i < 100; i++)
+    {
+        uint16_t val;
+        TEST_CHECK(ek_ringbuf_write_spsc(&static_spsc, &i), "static spsc write");
+        TEST_CHECK(ek_ringbuf_read_spsc(&static_spsc, &val) && val == i, "static spsc read");
+    }
+
+    // MPMC：调用者提供存储区
+    ek_ringbuf_mpmc_t mpmc;
+    ek_ringbuf_init_mpmc(&mpmc, mpmc_storage, sizeof(uint16_t), 8);
+    for (uint16_t i = 0; i < 9; i++)
+    {
+        TEST_CHECK(ek_ringbuf_write_mpmc(&mpmc, &i) == (i < 8), "mpmc write");
+    }
+    for (uint16_t i = 0; i < 8; i++)
+    {
+        uint16_t val;
+        TEST_CHECK(ek_ringbuf_read_mpmc(&mpmc, &val) && val == i, "mpmc read");
+    }
+
+    // 栈
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        stu.name = i;
+        TEST_CHECK(ek_stack_push(&static_sk, &stu) == (i < 3), "static stack push");
+    }
+    for (int i = 2; i >= 0; i--)
+    {
+        TEST_CHECK(ek_stack_pop(&static_sk, &stu) && stu.name == i, "static stack pop");
+    }
+
+    // 栈上的存储区
+    student_t local_storage[2];
+    ek_stack_t local_sk;
+    ek_stack_init(&local_sk, local_storage, sizeof(student_t), EK_ARRAY_LEN(local_storage));
+    TEST_CHECK(ek_stack_push(&local_sk, &stu) && ek_stack_push(&local_sk, &stu), "local stack push");
+    TEST_CHECK(ek_stack_full(&local_sk), "local stack full");
+
+    // 固定容量动态数组：写满后不再追加，销毁不释放
+    for (int i = 0; i < 8; i++) ek_vec_append(static_vec, i);
+    TEST_CHECK(static_vec.amount == 5 && static_vec.cap == 5, "static vec capacity");
+    ek_vec_remove(static_vec, 0);
+    TEST_CHECK(static_vec.items[0] == 1 && static_vec.amount == 4, "static vec remove");
+    ek_vec_shrink(static_vec);
+    TEST_CHECK(static_vec.cap == 5, "static vec shrink");
+    ek_vec_destroy(static_vec);
+
+    TEST_CHECK(ek_heap_used() == heap_used, "static containers touched the heap");
+
+    EK_LOG_INFO("static container test passed, heap used:%zu", heap_used);
+}
@@ -1,6 +1,7 @@
 #ifndef TEST_H
 #define TEST_H
 
+#include <stdio.h>
 #include <stdlib.h>
 
 #include "ek_io.h"
@@ -12,9 +13,33 @@
 #include "ek_vec.h"
 #include "ek_assert.h"
 #include "ek_str.h"
+#include "ek_mempool.h"
+#include "ek_arena.h"
+#include "ek_evoke.h"
+#include "ek_co.h"
 
 #define PI (3.141592f)
 
+/**
+ * @brief 测试断言，条件不成立时打印位置、说明和条件后退出
+ * @note 直接写到 stderr，不经过 ek_io / ek_log，输出被测试截获或走异步路径时也能看到
+ * @note 需要附加现场信息的测试在包含本文件前定义 TEST_CHECK_CONTEXT()，失败时在退出前调用它
+ */
+#ifndef TEST_CHECK_CONTEXT
+#    define TEST_CHECK_CONTEXT()
+#endif
+
+#define TEST_CHECK(cond, what)                                                                    \
+    do                                                                                            \
+    {                                                                                             \
+        if (!(cond))                                                                              \
+        {                                                                                         \
+            fprintf(stderr, "%s:%d: check failed: %s (%s)\n", __FILE__, __LINE__, (what), #cond); \
+            TEST_CHECK_CONTEXT();                                                                 \
+            exit(1);                                                                              \
+        }                                                                                         \
+    } while (0)
+
 typedef struct
 {
     uint8_t name;
@@ -23,7 +48,41 @@ typedef struct
 
 void stack_test(void);
 void ringbuf_test(void);
+void ringbuf_bench(void);
+void ringbuf_stress_test(void);
+void ringbuf_mpmc_bench(void);
 void vec_test(void);
+void static_test(void);
+void mempool_test(void);
+void heap_region_test(void);
+void heap_stats_test(void);
+void heap_trace_test(void);
+void arena_test(void);
+void heap_mt_test(void);
+void evoke_defer_bench(void);
+void evoke_queue_test(void);
+void evoke_prio_test(void);
+void evoke_co_test(void);
+void evoke_stats_test(void);
+void evoke_wait_test(void);
+void evoke_tick_test(void);
+void evoke_timer_test(void);
+void evoke_call_test(void);
+void evoke_port_test(void);
+void log_defer_test(void);
+void log_async_test(void);
+void log_level_test(void);
+void io_buffer_test(void);
+void log_persist_test(void);
+void evoke_sleep_test(void);
+
+/* evoke 测试共用的模拟时钟，由 evoke_sim.c 提供 */
+extern void (*evoke_sim_sleep_hook)(uint32_t xtick);
+void evoke_sim_reset(void);
+void evoke_sim_run_until(ek_evoke_event_t *evt, uint32_t target);
+void evoke_sim_advance(uint32_t ticks);
+void evoke_sim_early_wakeup(uint32_t max_ticks);
+uint32_t evoke_sim_early_count(void);
 void str_test(void);
 
 #endif
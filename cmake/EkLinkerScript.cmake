@@ -9,6 +9,8 @@
 #   EK_CCMRAM_ORIGIN / EK_CCMRAM_LENGTH  - CCM-RAM 起始地址和大小
 #   EK_SDRAM1_ORIGIN / EK_SDRAM1_LENGTH  - SDRAM1 起始地址和大小
 #   EK_SDRAM2_ORIGIN / EK_SDRAM2_LENGTH  - SDRAM2 起始地址和大小
+#   （存在的区域会额外导出 _ek_heap_fast/_ek_heap_bulk/_ek_heap_bulk2 的
+#    _start/_end 符号，供 ek_mem 的命名堆使用）
 #
 # 可选变量（有默认值）：
 #   EK_MIN_HEAP_SIZE  - 最小堆大小（默认 0x200）
@@ -61,6 +63,10 @@ function(ek_configure_linker_script)
     . = ALIGN(4);
     _eccmram = .;       /* create a global symbol at ccmram end */
   } >CCMRAM AT> FLASH
+
+  /* CCM-RAM 剩余空间作为 ek_heap_fast */
+  _ek_heap_fast_start = _eccmram;
+  _ek_heap_fast_end   = ORIGIN(CCMRAM) + LENGTH(CCMRAM);
 ")
     else()
         set(EK_LD_CCMRAM_REGION "")
@@ -80,6 +86,10 @@ function(ek_configure_linker_script)
     . = ALIGN(4);
     _sdram1_data_end = .;
   } >SDRAM
+
+  /* SDRAM1 剩余空间作为 ek_heap_bulk */
+  _ek_heap_bulk_start = _sdram1_data_end;
+  _ek_heap_bulk_end   = ORIGIN(SDRAM) + LENGTH(SDRAM);
 ")
     else()
         set(EK_LD_SDRAM1_REGION "")
@@ -101,6 +111,10 @@ function(ek_configure_linker_script)
     . = ALIGN(4);
     _sdram2_data_end = .;
   } >SDRAM2
+
+  /* SDRAM2 剩余空间作为 ek_heap_bulk 的第二个内存池 */
+  _ek_heap_bulk2_start = _sdram2_data_end;
+  _ek_heap_bulk2_end   = ORIGIN(SDRAM2) + LENGTH(SDRAM2);
 ")
     else()
         set(EK_LD_SDRAM2_REGION "")
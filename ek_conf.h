@@ -18,13 +18,29 @@
  * 内存管理配置 (ek_mem)
  * - EK_HEAP_NO_TLSF: 设置为1表示不使用TLSF内存池，需自定义实现具体API查看 ek_mem.h
  * - EK_HEAP_SIZE: heap的默认大小（字节）
+ *   EK_USE_RTOS 为 1 时 FreeRTOS 改用 heap_ek.c，任务栈、队列也从这个堆分配，
+ *   因此加上原 configTOTAL_HEAP_SIZE 的 32KB；为 0 时 FreeRTOS 使用 heap_4.c 的独立堆
+ * - EK_HEAP_REGION_ENABLE: 使能命名堆 ek_heap_fast/dma/bulk（CCM-RAM/SRAM/SDRAM），
+ *                          区域来自链接脚本符号，不存在的区域回退到默认堆，默认关闭
+ * - EK_HEAP_THREAD_SAFE / EK_HEAP_CACHE_ENABLE: 默认随 EK_USE_RTOS 打开，分配在临界区内完成，
+ *   并使能每任务小块缓存（见 ek_mem.h）
+ * - EK_HEAP_TRACE: 使能分配追踪，记录存活分配的调用点/大小/时间戳，heap 命令按调用点打印，
+ *   每次分配/释放都要查表，默认关闭，调试内存泄漏时定义为 1
+ * - EK_HEAP_TRACE_DEPTH: 追踪表容量，必须是 2 的幂，建议为存活分配数的 2 倍
  * ======================================================================== */
-#define EK_HEAP_NO_TLSF (0)
-#define EK_HEAP_SIZE    (30 * 1024)
+#define EK_HEAP_NO_TLSF     (0)
+#if EK_USE_RTOS == 1
+#    define EK_HEAP_SIZE ((30 + 32) * 1024)
+#else
+#    define EK_HEAP_SIZE (30 * 1024)
+#endif /* EK_USE_RTOS */
+#define EK_HEAP_TRACE_DEPTH (128)
 
 /* ========================================================================
  * IO库配置
  * -EK_IO_NO_LWPRTF : IO库不使用lwprintf
+ * -EK_IO_BUFFER_SIZE : 输出缓冲区大小（字节），按行或缓冲区满时通过 EK_IO_WRITE() 整块输出，
+ *   默认 0 = 逐字符输出；多个上下文同时输出时需实现 ek_io_enter_critical()/ek_io_exit_critical()
  * ======================================================================== */
 #define EK_IO_NO_LWPRTF (0)
 
@@ -37,7 +53,10 @@
  * - EK_VEC_ENABLE: 使能向量模块
  * - EK_RINGBUF_ENABLE: 使能通用环形缓冲区模块
  * - EK_RINGBUF_SPSC_ENABLE: 使能单生产者单消费者环形缓冲区模块
+ * - EK_RINGBUF_MPMC_ENABLE: 使能无锁多生产者多消费者环形缓冲区模块
  * - EK_STACK_ENABLE: 使能栈模块
+ * - EK_MEMPOOL_ENABLE: 使能固定大小内存块池模块
+ * - EK_ARENA_ENABLE: 使能线性（bump）分配器模块
  * - EK_EVOKE_ENABLE: 使能事件驱动模块
  * ======================================================================== */
 #define EK_EXPORT_ENABLE       (0)
@@ -47,14 +66,65 @@
 #define EK_VEC_ENABLE          (1)
 #define EK_RINGBUF_ENABLE      (1)
 #define EK_RINGBUF_SPSC_ENABLE (1)
+#define EK_RINGBUF_MPMC_ENABLE (1)
 #define EK_STACK_ENABLE        (1)
+#define EK_MEMPOOL_ENABLE      (1)
+#define EK_ARENA_ENABLE        (1)
 #define EK_EVOKE_ENABLE        (1)
 
+/* ========================================================================
+ * 环形缓冲区配置
+ * - EK_RINGBUF_SPSC_POW2: SPSC 容量取 2 的幂，用掩码代替取模并使用全部槽位，默认关闭；
+ *   打开后 ek_ringbuf_create_spsc() 的槽位数向上取整为 2 的幂且全部可用（关闭时可用 item_amount - 1 个），
+ *   ek_ringbuf_init_spsc() 的槽位数必须是 2 的幂，依赖原有容量的代码需要检查
+ * ======================================================================== */
+
+/* ========================================================================
+ * 内存块池配置（需要 EK_MEMPOOL_ENABLE）
+ * - EK_EVOKE_USE_MEMPOOL: 任务和事件从静态内存块池分配，池耗尽时回退到堆，默认关闭
+ * - EK_EVOKE_TASK_POOL_SIZE: 任务块数量
+ * - EK_EVOKE_EVENT_POOL_SIZE: 事件块数量
+ * - EK_STR_USE_MEMPOOL: 字符串头从静态内存块池分配，池耗尽时回退到堆，默认关闭
+ * - EK_STR_POOL_SIZE: 字符串头块数量
+ * ======================================================================== */
+#define EK_EVOKE_TASK_POOL_SIZE  (8)
+#define EK_EVOKE_EVENT_POOL_SIZE (8)
+#define EK_STR_POOL_SIZE         (8)
+
+/* ========================================================================
+ * 事件驱动模块配置
+ * - EK_EVOKE_DEFER_USE_HEAP: 延迟请求用二叉最小堆保存，插入/取消 O(log n)；
+ *   默认为 0，使用有序链表，插入 O(n)，延迟请求较少时代码更小
+ * - EK_EVOKE_DEFER_GROW: 延迟请求池耗尽时从堆中分配
+ * - EK_EVOKE_OVERFLOW_POLICY: ISR 请求队列和延迟请求池满时的策略，
+ *   EK_EVOKE_OVERFLOW_DROP / EK_EVOKE_OVERFLOW_COALESCE / EK_EVOKE_OVERFLOW_OVERWRITE
+ * - 池和队列的容量用 EK_EVOKE_MAX_DEFER_REQ / EK_EVOKE_MAX_ISR_REQ 调整（默认 10），
+ *   根据 ek_evoke_defer_stats() / ek_evoke_isr_stats() 的高水位和丢弃计数确定
+ * - EK_EVOKE_PRIO_LEVELS: 任务优先级数量（1 ~ 32，默认 8），最高优先级的就绪任务总是先执行
+ * - EK_EVOKE_DEADLINE_ENABLE: 同一优先级内按截止时间排序，并统计错过截止时间的次数，默认关闭
+ * - EK_EVOKE_WAIT_ANY_MAX: 一个任务最多同时等待的事件数量（默认 4），每个任务为每个事件保留一个等待节点
+ * - EK_EVOKE_GROUP_ENABLE: 事件组，任务等待 32 个事件位中的任意一位或全部位，默认关闭
+ * - EK_EVOKE_STATS_ENABLE: 统计任务运行时间、唤醒延迟和主循环的睡眠占比（ek_evoke_top()），默认关闭；
+ *   需要真实的时钟：默认的 ek_evoke_get_tick() 只在睡眠返回时前进，任务运行期间不变，
+ *   打开前应重写 ek_evoke_get_tick() 或 ek_evoke_stats_clock()
+ * ======================================================================== */
+#define EK_EVOKE_DEFER_GROW      (0)
+#define EK_EVOKE_OVERFLOW_POLICY EK_EVOKE_OVERFLOW_DROP
+
 /* ========================================================================
  * 日志模块配置
  * - EK_LOG_DEBUG_ENABLE: 打开调试模式
  * - EK_LOG_COLOR_ENABLE: 启用彩色日志
  * - EK_LOG_BUFFER_SIZE: 日志字符默认缓冲区大小（字节）
+ * - EK_LOG_LEVEL: 编译期日志级别（EK_LOG_LEVEL_DEBUG ~ EK_LOG_LEVEL_OFF），低于它的日志连同参数一起删除，可按文件单独定义
+ * - EK_LOG_TAG_LEVEL_ENABLE: 按 EK_LOG_FILE_TAG 标签在运行时调整级别（ek_log_set_level()、shell 命令 loglevel / logtags），默认关闭；
+ *   需要链接脚本在 .data 内放置 ek_log_tag 段，见 ek_log.h
+ * - EK_LOG_ASYNC_ENABLE: 文本日志写入环形缓冲区后立即返回，由 _ek_log_async_write()（如 DMA）后台发送，默认关闭
+ *   缓冲区大小 EK_LOG_ASYNC_SIZE，写满时按 EK_LOG_OVERFLOW_POLICY 丢弃或截断，按级别计入 ek_log_dropped()
+ * - EK_LOG_DEFER_ENABLE: 延迟二进制日志，设备只记录格式串 ID 和参数，主机用 Script/ek_log_decode.py 还原
+ *   默认关闭，也可以只在某个源文件包含 ek_log.h 之前定义为 1；队列大小见 EK_LOG_DEFER_WORDS / EK_LOG_DEFER_DEPTH
+ * - EK_LOG_PERSIST_ENABLE: 日志同时复制进 .noinit 段中的环形区域（EK_LOG_PERSIST_SIZE 字节），热复位后
+ *   用 ek_log_persist_dump() 或 shell 命令 crashlog 读出，默认关闭；启动时需调用 ek_log_persist_init()
  * ======================================================================== */
 #define EK_LOG_DEBUG_ENABLE (1)
 #define EK_LOG_COLOR_ENABLE (1)